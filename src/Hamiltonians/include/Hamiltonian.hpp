@@ -5,7 +5,16 @@
 #ifndef HAMILTONIANS_HAMILTONIAN_HPP
 #define HAMILTONIANS_HAMILTONIAN_HPP
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "State.hpp"
+#include "span.hpp"
 #include <boost/math/special_functions/ellint_1.hpp>
 #include <boost/math/special_functions/ellint_2.hpp>
 #include <boost/math/constants/constants.hpp>
@@ -16,10 +25,91 @@ namespace Integrators
     namespace Hamiltonian
     {
 
+        /// \brief has_exact_flow<Ham> is true if Ham provides its exact propagator as
+        /// Geometry::State2_Action flow (const Geometry::State2_Action& s, double dt) const,
+        /// returning the position and the action reached from s after time dt.
+        ///
+        /// The integration functions detect it at compile time and use the flow instead of a stepper.
+        template<typename Ham, typename = void>
+        struct has_exact_flow: std::false_type {
+        };
+
+        template<typename Ham>
+        struct has_exact_flow<Ham, std::void_t<decltype(std::declval<const Ham&>().flow(
+            std::declval<const Geometry::State2_Action&>(), 0.0))> >: std::true_type {
+        };
+
+        template<typename Ham>
+        constexpr bool has_exact_flow_v = has_exact_flow<Ham>::value;
+
+        /// \brief has_polynomial_derivative<Ham> is true if Ham provides its derivative as a polynomial of q and p,
+        /// evaluated on any arithmetic type T:
+        /// template<typename T> std::array<T, 2> polynomial_derivative (const T& q, const T& p) const,
+        /// returning {dH/dq, dH/dp}.
+        ///
+        /// It allows the automatic calculation of the Taylor coefficients of the orbits (see Steppers::Taylor).
+        template<typename Ham, typename = void>
+        struct has_polynomial_derivative: std::false_type {
+        };
+
+        template<typename Ham>
+        struct has_polynomial_derivative<Ham, std::void_t<decltype(std::declval<const Ham&>().polynomial_derivative(
+            std::declval<const double&>(), std::declval<const double&>()))> >: std::true_type {
+        };
+
+        template<typename Ham>
+        constexpr bool has_polynomial_derivative_v = has_polynomial_derivative<Ham>::value;
+
+        /// \brief has_hessian<Ham> is true if Ham provides the second derivatives of H as
+        /// std::array<double, 3> hessian (const Geometry::State2& s) const, returning {d2H/dq2, d2H/dqdp, d2H/dp2}.
+        ///
+        /// Otherwise Hamiltonian::hessian differentiates derivative() numerically.
+        template<typename Ham, typename = void>
+        struct has_hessian: std::false_type {
+        };
+
+        template<typename Ham>
+        struct has_hessian<Ham, std::void_t<decltype(std::declval<const Ham&>().hessian(
+            std::declval<const Geometry::State2&>()))> >: std::true_type {
+        };
+
+        /// \brief The number of degrees of freedom of Ham: Ham::degrees_of_freedom if Ham declares it, otherwise 1.
+        ///
+        /// A Hamiltonian of DOF degrees of freedom takes and returns Geometry::PhaseSpaceState<DOF>:
+        /// double value (const Geometry::PhaseSpaceState<DOF>& s) const and
+        /// Geometry::PhaseSpaceState<DOF> derivative (const Geometry::PhaseSpaceState<DOF>& s) const, returning
+        /// {dH/dq_1, ..., dH/dq_DOF, dH/dp_1, ..., dH/dp_DOF}.
+        template<typename Ham, typename = void>
+        struct degrees_of_freedom: std::integral_constant<unsigned, 1> {
+        };
+
+        template<typename Ham>
+        struct degrees_of_freedom<Ham, std::void_t<decltype(Ham::degrees_of_freedom)> >
+            : std::integral_constant<unsigned, Ham::degrees_of_freedom> {
+        };
+
+        template<typename Ham>
+        constexpr unsigned degrees_of_freedom_v = degrees_of_freedom<Ham>::value;
+
         class HarmonicOscillator {
          public:
           double value (const Geometry::State2& s) const noexcept;
           Geometry::State2 derivative (const Geometry::State2& s) const noexcept;
+          std::array<double, 3> hessian (const Geometry::State2& s) const noexcept;
+          void value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept;
+          void derivative_batch (Span<const Geometry::State2> states, Span<Geometry::State2> derivatives) const noexcept;
+          /// \brief the exact flow, a rotation of the phase space by dt
+          Geometry::State2_Action flow (const Geometry::State2_Action& s, double dt) const noexcept;
+          /// \brief the name of the Hamiltonian, stable across compilers and builds
+          static constexpr const char* name = "harmonic_oscillator";
+          /// \brief the numbers that define the Hamiltonian
+          std::vector<double> parameters () const;
+
+          template<typename T>
+          std::array<T, 2> polynomial_derivative (const T& q, const T& p) const
+          {
+            return {q, p};
+          }
         };
 
         class DuffingHamiltonian {
@@ -41,11 +131,37 @@ namespace Integrators
           void set_e_alpha (double e_alpha) noexcept ;
           double get_e_gamma () const noexcept ;
           void set_e_gamma (double e_gamma) noexcept ;
+          /// \brief the name of the Hamiltonian, stable across compilers and builds
+          static constexpr const char* name = "duffing";
+          /// \brief the numbers that define the Hamiltonian
+          std::vector<double> parameters () const;
+
+          static constexpr size_t number_of_parameters = 4;
+          /// \brief sets the parameter at index of parameters()
+          /// \throws std::out_of_range if index >= number_of_parameters
+          void set_parameter (size_t index, double value);
 
           double value(const Geometry::State2& s) const noexcept;
 
           Geometry::State2 derivative(const Geometry::State2& s) const noexcept;
 
+          std::array<double, 3> hessian (const Geometry::State2& s) const noexcept;
+
+          /// \brief the derivatives of derivative(s) with respect to each of the parameters(), in the same order
+          std::array<Geometry::State2, number_of_parameters> parameter_derivatives (const Geometry::State2& s) const noexcept;
+
+          void value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept;
+          void derivative_batch (Span<const Geometry::State2> states, Span<Geometry::State2> derivatives) const noexcept;
+
+          template<typename T>
+          std::array<T, 2> polynomial_derivative (const T& q, const T& p) const
+          {
+            const T hypot_sq = q * q + p * p;
+
+            return {-(e_Omega() * q + 3 * e_alpha_ / 4 * hypot_sq * q - e_gamma_) / (2 * omega_),
+                    -(e_Omega() * p + 3 * e_alpha_ / 4 * hypot_sq * p) / (2 * omega_)};
+          }
+
         };
 
         class PendulumHamiltonian
@@ -79,11 +195,22 @@ namespace Integrators
           PendulumHamiltonian (double F, double G);
           double F () const noexcept ;
           double G () const noexcept ;
+          /// \brief the name of the Hamiltonian, stable across compilers and builds
+          static constexpr const char* name = "pendulum";
+          /// \brief the numbers that define the Hamiltonian
+          std::vector<double> parameters () const;
 
           double value(const Geometry::State2 & s) const noexcept ;
 
           Geometry::State2 derivative(const Geometry::State2& s) const noexcept;
 
+          std::array<double, 3> hessian (const Geometry::State2& s) const noexcept;
+
+          /// \brief uses the vectorized Internals::cos_batch, which may differ from std::cos in the last bits
+          void value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept;
+          /// \brief uses the vectorized Internals::sin_batch, which may differ from std::sin in the last bits
+          void derivative_batch (Span<const Geometry::State2> states, Span<Geometry::State2> derivatives) const noexcept;
+
           double analytical_action(double energy) const
           {
 
@@ -118,8 +245,161 @@ namespace Integrators
           double value(const Geometry::State2& s) const noexcept;
 
           Geometry::State2 derivative(const Geometry::State2& s) const noexcept;
+
+          std::array<double, 3> hessian (const Geometry::State2& s) const noexcept;
+
+          void value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept;
+          void derivative_batch (Span<const Geometry::State2> states, Span<Geometry::State2> derivatives) const noexcept;
+
+          /// \brief the exact flow, a shear of the phase space by dt
+          Geometry::State2_Action flow (const Geometry::State2_Action& s, double dt) const noexcept;
+          /// \brief the name of the Hamiltonian, stable across compilers and builds
+          static constexpr const char* name = "free_particle";
+          /// \brief the numbers that define the Hamiltonian
+          std::vector<double> parameters () const;
+
+          template<typename T>
+          std::array<T, 2> polynomial_derivative (const T& /*q*/, const T& p) const
+          {
+            return {0 * p, p};
+          }
+        };
+
+        /// \brief H = p^2/(2m) + V(q), with V the cubic spline through potential values sampled on a uniform grid.
+        ///
+        /// The spline coefficients of every cell are packed together, so that an evaluation finds its cell in O(1)
+        /// and reads a single contiguous block of four doubles.
+        ///
+        /// With SplineBoundary::natural, the samples are V(q_min), ..., V(q_max), the spline has zero curvature at the
+        /// ends, and it is continued linearly outside [q_min, q_max]. With SplineBoundary::periodic, q_max - q_min
+        /// must be 2pi (the period assumed by the periodic crossings, see Internals::PeriodicQDistance), the samples
+        /// are V(q_min), ..., V(q_max - h), and the spline is periodic.
+        class SplinePotentialHamiltonian {
+         public:
+          enum class SplineBoundary { natural, periodic };
+
+         private:
+          double q_min_;
+          double inverse_h_;
+          double inverse_mass_;
+          SplineBoundary boundary_;
+          // V = ((c3 * t + c2) * t + c1) * t + c0 in every cell, with t = (q - q_cell) / h in [0, 1). Shared, so
+          // that the copies of the Hamiltonian taken by the integration functors do not allocate.
+          std::shared_ptr<const std::vector<std::array<double, 4>>> cells_;
+
+          /// \brief the cell of q, and the position t in it
+          size_t locate (double q, double& t) const noexcept;
+
+         public:
+          SplinePotentialHamiltonian (double q_min,
+                                      double q_max,
+                                      const std::vector<double>& potential,
+                                      double mass = 1,
+                                      SplineBoundary boundary = SplineBoundary::natural);
+
+          double mass () const noexcept;
+          SplineBoundary boundary () const noexcept;
+          /// \brief the name of the Hamiltonian, stable across compilers and builds
+          static constexpr const char* name = "spline_potential";
+          /// \brief the numbers that define the Hamiltonian
+          std::vector<double> parameters () const;
+
+          double potential (double q) const noexcept;
+          double potential_derivative (double q) const noexcept;
+          double potential_second_derivative (double q) const noexcept;
+
+          double value (const Geometry::State2& s) const noexcept;
+          Geometry::State2 derivative (const Geometry::State2& s) const noexcept;
+          std::array<double, 3> hessian (const Geometry::State2& s) const noexcept;
+
+          void value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept;
+          void derivative_batch (Span<const Geometry::State2> states, Span<Geometry::State2> derivatives) const noexcept;
+        };
+
+        /// \brief The Henon-Heiles Hamiltonian, H = (p_x^2 + p_y^2)/2 + (x^2 + y^2)/2 + lambda (x^2 y - y^3/3), on
+        /// the states {x, y, p_x, p_y}.
+        ///
+        /// Its orbits are bounded below the escape energy 1/(6 lambda^2), and mostly chaotic above about 1/(8 lambda^2).
+        class HenonHeilesHamiltonian {
+          double lambda_ = 1;
+         public:
+          static constexpr unsigned degrees_of_freedom = 2;
+
+          HenonHeilesHamiltonian () = default;
+          explicit HenonHeilesHamiltonian (double lambda);
+
+          double lambda () const noexcept;
+          /// \brief the name of the Hamiltonian, stable across compilers and builds
+          static constexpr const char* name = "henon_heiles";
+          /// \brief the numbers that define the Hamiltonian
+          std::vector<double> parameters () const;
+
+          double value (const Geometry::State4& s) const noexcept;
+          Geometry::State4 derivative (const Geometry::State4& s) const noexcept;
+        };
+
+        template<typename Ham, typename = void>
+        struct has_batch_interface: std::false_type {
+        };
+
+        template<typename Ham>
+        struct has_batch_interface<Ham, std::void_t<
+            decltype(std::declval<const Ham&>().value_batch(std::declval<Span<const Geometry::State2>>(),
+                                                            std::declval<Span<double>>())),
+            decltype(std::declval<const Ham&>().derivative_batch(std::declval<Span<const Geometry::State2>>(),
+                                                                 std::declval<Span<Geometry::State2>>()))> >
+            : std::true_type {
         };
 
+        /// \brief values[i] = hamiltonian.value(states[i]). Forwards to Ham::value_batch, if Ham provides one.
+        template<typename Ham>
+        void value_batch (const Ham& hamiltonian, Span<const Geometry::State2> states, Span<double> values)
+        {
+          if constexpr (has_batch_interface<Ham>::value)
+            hamiltonian.value_batch(states, values);
+          else
+            for (size_t i = 0; i < states.size(); ++i)
+              values[i] = hamiltonian.value(states[i]);
+        }
+
+        /// \brief derivatives[i] = hamiltonian.derivative(states[i]). Forwards to Ham::derivative_batch, if Ham
+        /// provides one.
+        template<typename Ham>
+        void derivative_batch (const Ham& hamiltonian,
+                               Span<const Geometry::State2> states,
+                               Span<Geometry::State2> derivatives)
+        {
+          if constexpr (has_batch_interface<Ham>::value)
+            hamiltonian.derivative_batch(states, derivatives);
+          else
+            for (size_t i = 0; i < states.size(); ++i)
+              derivatives[i] = hamiltonian.derivative(states[i]);
+        }
+
+        /// \brief {d2H/dq2, d2H/dqdp, d2H/dp2} at s. Forwards to Ham::hessian, if Ham provides one, otherwise
+        /// differentiates derivative() with central differences.
+        template<typename Ham>
+        std::array<double, 3> hessian (const Ham& hamiltonian, const Geometry::State2& s)
+        {
+          if constexpr (has_hessian<Ham>::value)
+            return hamiltonian.hessian(s);
+          else
+            {
+              // the optimal step for central differences, cbrt(machine epsilon)
+              constexpr double relative_step = 6.055454452393343e-6;
+
+              const auto h_q = relative_step * std::max(1.0, std::abs(s.q()));
+              const auto h_p = relative_step * std::max(1.0, std::abs(s.p()));
+
+              const auto d_dq = (hamiltonian.derivative(Geometry::State2{s.q() + h_q, s.p()})
+                                 - hamiltonian.derivative(Geometry::State2{s.q() - h_q, s.p()})) / (2 * h_q);
+              const auto d_dp = (hamiltonian.derivative(Geometry::State2{s.q(), s.p() + h_p})
+                                 - hamiltonian.derivative(Geometry::State2{s.q(), s.p() - h_p})) / (2 * h_p);
+
+              return {d_dq.q(), 0.5 * (d_dq.p() + d_dp.q()), d_dp.p()};
+            }
+        }
+
     }
 }
 
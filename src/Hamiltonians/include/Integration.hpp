@@ -6,22 +6,26 @@
 #define HAMILTONIANS_INTEGRATION_HPP
 
 #include <optional>
+#include <stdexcept>
 #include <boost/numeric/odeint.hpp>
 #include <boost/numeric/odeint/iterator/times_time_iterator.hpp>
 
 #include "State.hpp"
 #include "line.hpp"
+#include "reversing_symmetry.hpp"
 #include "periodic_q_surface.hpp"
 #include "dynamic_system.hpp"
 #include "observer.hpp"
 #include "IntegrationTimeInterval.hpp"
 #include "Hamiltonian.hpp"
+#include "steppers.hpp"
+#include "energy_projection.hpp"
+#include "exact_flow.hpp"
 
 namespace Integrators
 {
     template<typename StateType>
-    using ErrorStepperType = boost::numeric::odeint::runge_kutta_cash_karp54<StateType, double, StateType,
-        double, boost::numeric::odeint::vector_space_algebra>;
+    using ErrorStepperType = Steppers::Default::error_stepper_type<StateType>;
 
     template<typename StateType>
     using ControlledStepperType = boost::numeric::odeint::controlled_runge_kutta<ErrorStepperType<StateType> >;
@@ -31,6 +35,10 @@ namespace Integrators
         double rel_err = 1.0e-14;
         double initial_time_step = 1e-5;
         double distance_threshold = 1.0e-13;
+        size_t energy_projection_every = 0;
+        double energy_drift_threshold = 0;
+        double exact_flow_sampling_step = 0.1;
+        size_t expected_crossings = 0;
 
         IntegrationOptions () = default;
 
@@ -53,178 +61,363 @@ namespace Integrators
           distance_threshold = ds;
         }
 
+        /// \brief Projects the state back onto the initial energy level every n accepted steps. 0 disables it.
+        void set_energy_projection_every (size_t n)
+        {
+          energy_projection_every = n;
+        }
+
+        /// \brief Projects the state back onto the initial energy level whenever the energy drifts by more than dE.
+        /// 0 disables it.
+        void set_energy_drift_threshold (double dE)
+        {
+          energy_drift_threshold = dE;
+        }
+
+        /// \brief The time between the samples handed to the observers, for Hamiltonians with an exact flow (see
+        /// Hamiltonian::has_exact_flow). The crossings found between the samples are located exactly, but two
+        /// crossings closer in time than dt may be missed, see exact_flow_sampling_step.
+        void set_exact_flow_sampling_step (double dt)
+        {
+          exact_flow_sampling_step = dt;
+        }
+
+        /// \brief The number of crossings the functions returning all the crossings reserve room for before
+        /// integrating. The integration loop itself does not allocate, so with a large enough estimate nothing is
+        /// allocated after the setup. 0 lets the storage grow as the crossings are found.
+        void set_expected_crossings (size_t n)
+        {
+          expected_crossings = n;
+        }
+
     };
 
-    template<typename DS>
-    Geometry::State2_Extended step_back (const DS& system,
-                                         const Geometry::State2 direction,
-                                         const Geometry::State2_Action& s,
-                                         double t,
-                                         double distance)
+    /// \brief Steps from s, at distance from a surface with the given perpendicular direction, onto the surface, by
+    /// integrating the system along direction (see Dynamics::dynamic_system_along_direction_impl).
+    /// \param step_record the record of the stepper that has stepped to s, if the policy keeps one (see
+    /// Steppers::step_record_t); may be null
+    template<typename StepperPolicy = Steppers::Default, typename DS,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
+    typename DS::extended_state_type step_back (const DS& system,
+                                                const typename DS::state_type direction,
+                                                const typename DS::action_state_type& s,
+                                                double t,
+                                                double distance,
+                                                [[maybe_unused]] const Steppers::step_record_t<StepperPolicy>*
+                                                step_record = nullptr)
     {
-      using ErrorStepperType_Extended = ErrorStepperType<Geometry::State2_Extended>;
+      using extended_state_type = typename DS::extended_state_type;
+      using action_state_type = typename DS::action_state_type;
+
+      if constexpr (Hamiltonian::has_exact_flow_v<typename DS::hamiltonian_type>)
+        return exact_step_back(system, direction, s, t, distance);
+      else if constexpr (DS::degrees_of_freedom == 1 && Steppers::has_step_back_v<StepperPolicy, DS>)
+        {
+          if constexpr (Steppers::has_step_record_v<StepperPolicy>)
+            return StepperPolicy::step_back(system, direction, s, t, distance, step_record);
+          else
+            return StepperPolicy::step_back(system, direction, s, t, distance);
+        }
+      else
+        {
+          using ErrorStepperType_Extended = typename StepperPolicy::template error_stepper_type<extended_state_type>;
 
-      auto state_extended = Geometry::State2_Extended{s};
+          auto state_extended = extended_state_type{s};
 
-      state_extended.t() = t;
+          state_extended.t() = t;
 
-      auto df = [&system, &direction] (const Geometry::State2_Extended& s_extended, Geometry::State2_Extended& dsdt_extended, double /*time*/)
-      {
+          auto df = [&system, &direction] (const extended_state_type& s_extended, extended_state_type& dsdt_extended, double /*time*/)
+          {
 
-          dsdt_extended = system.dynamic_system_along_direction(direction,
-                                                                Geometry::State2_Action{s_extended});
-      };
+              dsdt_extended = system.dynamic_system_along_direction(direction,
+                                                                    action_state_type{s_extended});
+          };
 
-      ErrorStepperType_Extended().do_step(
-          df,
-          state_extended,
-          t,
-          -distance);
+          ErrorStepperType_Extended().do_step(
+              df,
+              state_extended,
+              t,
+              -distance);
 
-      return state_extended;
+          return state_extended;
+        }
     }
 
-    template<typename DS>
-    inline auto
-    make_dynamic_system_integration_range (DS system, // not const &, see comment below
-                                           Geometry::State2_Action& s_start,
-                                           const TimeInterval& integrationTime,
-                                           const IntegrationOptions& options)
+    namespace Internals
     {
+        /// \brief the controlled stepper of StepperPolicy for the action states of system, wrapped in the energy
+        /// projection of options, and bounded by the dt_max of integrationTime if it has one
+        /// \param step_record where the stepper keeps its last step, if the policy keeps one and it is not null (see
+        /// Steppers::step_record_t); it must outlive the stepper and its copies
+        template<typename StepperPolicy, typename DS>
+        auto make_controlled_stepper (const DS& system,
+                                      const TimeInterval& integrationTime,
+                                      const IntegrationOptions& options,
+                                      const typename DS::state_type& s_start,
+                                      [[maybe_unused]] Steppers::step_record_t<StepperPolicy>* step_record = nullptr)
+        {
+          using action_state_type = typename DS::action_state_type;
 
+          const auto make_controlled = [&] (auto... dt_max)
+          {
+              if constexpr (Steppers::has_step_record_v<StepperPolicy>)
+                return StepperPolicy::template make_controlled<action_state_type>(system,
+                                                                                  options.abs_err,
+                                                                                  options.rel_err,
+                                                                                  dt_max...,
+                                                                                  step_record);
+              else
+                return StepperPolicy::template make_controlled<action_state_type>(system,
+                                                                                  options.abs_err,
+                                                                                  options.rel_err,
+                                                                                  dt_max...);
+          };
 
-      //system should be passed by value to the closure, because integration_functor is coppied into the output range
-      //and reference may dangle
-      auto integration_functor = [sys = std::move(system)] (const Geometry::State2_Action& s, Geometry::State2_Action& dsdt, double /*t*/)
-      {
-          dsdt = sys.dynamic_system_Action(s);
-      };
+          const auto& dt_max = integrationTime.dt_max();
+
+          if (dt_max)
+            return make_energy_projecting_stepper(
+                make_controlled(dt_max.value()),
+                EnergyProjection<DS>{system, s_start, options.energy_projection_every, options.energy_drift_threshold});
 
-      const auto dt_max_container = integrationTime.dt_max();
-      const auto t_begin = integrationTime.t_begin();
-      const auto t_end = integrationTime.t_end();
+          return make_energy_projecting_stepper(
+              make_controlled(),
+              EnergyProjection<DS>{system, s_start, options.energy_projection_every, options.energy_drift_threshold});
+        }
+
+        /// \brief One step of odeint's adaptive iterator, for the loops that step by hand: the step is shortened to end
+        /// at t_end, and retried with the step size the stepper proposes until it is accepted, at most max_attempts
+        /// times. On return s and t are those at the end of the step, and dt the step size proposed for the next one.
+        /// \throws std::overflow_error if none of the attempts is accepted
+        template<typename ControlledStepper, typename System, typename StateType>
+        void adaptive_step (ControlledStepper& stepper, System&& system, StateType& s, double& t, double& dt,
+                            double t_end)
+        {
+          using boost::numeric::odeint::detail::less_with_sign;
+
+          constexpr size_t max_attempts = 1000;
 
-      const auto abs_err = options.abs_err;
-      const auto rel_err = options.rel_err;
+          if (less_with_sign(t_end, t + dt, dt))
+            dt = t_end - t;
 
-      if (!dt_max_container)
+          size_t attempts = 0;
+          while (stepper.try_step(system, s, t, dt) == boost::numeric::odeint::fail)
+            if (++attempts == max_attempts)
+              throw std::overflow_error("adaptive_step: a step size could not be found");
+        }
+    }
+
+    /// \param step_record where the stepper keeps its last step, for the step_back of the observers of the range (see
+    /// Steppers::step_record_t); it must outlive the range
+    template<typename StepperPolicy = Steppers::Default, typename DS,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
+    inline auto
+    make_dynamic_system_integration_range (DS system, // not const &, see comment below
+                                           typename DS::action_state_type& s_start,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options,
+                                           [[maybe_unused]] Steppers::step_record_t<StepperPolicy>* step_record
+                                           = nullptr)
+    {
+      if constexpr (Hamiltonian::has_exact_flow_v<typename DS::hamiltonian_type>)
         {
-          const auto controlled_stepper = make_controlled(abs_err, rel_err, ErrorStepperType<Geometry::State2_Action>());
+          const auto sampling_step = exact_flow_sampling_step(system,
+                                                              Geometry::State2{s_start},
+                                                              integrationTime,
+                                                              options.exact_flow_sampling_step);
 
-          return boost::make_iterator_range(
-              make_adaptive_time_range(controlled_stepper,
-                                       integration_functor,
-                                       s_start, t_begin,
-                                       t_end,
-                                       options.initial_time_step));
+          return make_exact_flow_range(std::move(system), s_start, integrationTime, sampling_step);
         }
       else
         {
-          const auto controlled_stepper =
-              make_controlled(abs_err, rel_err, dt_max_container.value(), ErrorStepperType<Geometry::State2_Action>());
+          //system should be passed by value to the closure, because integration_functor is coppied into the output range
+          //and reference may dangle
+          using action_state_type = typename DS::action_state_type;
+
+          auto integration_functor = [sys = system] (const action_state_type& s, action_state_type& dsdt, double /*t*/)
+          {
+              dsdt = sys.dynamic_system_Action(s);
+          };
+
+          const auto controlled_stepper = Internals::make_controlled_stepper<StepperPolicy>(
+              system, integrationTime, options, typename DS::state_type{s_start}, step_record);
+
           return boost::make_iterator_range(
-              make_adaptive_time_range(controlled_stepper,
-                                       integration_functor,
-                                       s_start, t_begin,
-                                       t_end,
-                                       options.initial_time_step));
+              boost::numeric::odeint::make_adaptive_time_range(controlled_stepper,
+                                                               integration_functor,
+                                                               s_start,
+                                                               integrationTime.t_begin(),
+                                                               integrationTime.t_end(),
+                                                               options.initial_time_step));
         }
-
     }
 
-    template<typename DS>
+    template<typename StepperPolicy = Steppers::Default, typename DS,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     inline auto
     make_interval_range (DS system,   // not const &, see comment below
-                         Geometry::State2_Action& s_start,
+                         typename DS::action_state_type& s_start,
                          const std::vector<double>& times,
                          const IntegrationOptions& options)
     {
+      using action_state_type = typename DS::action_state_type;
 
-      const auto controlled_stepper = make_controlled(options.abs_err,
-                                                      options.rel_err,
-                                                      ErrorStepperType<Geometry::State2_Action>());
-
+      if constexpr (Hamiltonian::has_exact_flow_v<typename DS::hamiltonian_type>)
+        return make_exact_flow_interval_range(std::move(system), s_start, times);
+      else
+        {
+          const auto controlled_stepper = make_energy_projecting_stepper(
+              StepperPolicy::template make_controlled<action_state_type>(system,
+                                                                         options.abs_err,
+                                                                         options.rel_err),
+              EnergyProjection<DS>{system,
+                                   typename DS::state_type{s_start},
+                                   options.energy_projection_every,
+                                   options.energy_drift_threshold});
 
-      //system should be passed by value to the closure, because integration_functor is coppied into the output range
-      //and reference may dangle
 
-      auto integration_functor = [sys = std::move(system)]
-          (const Geometry::State2_Action& s, Geometry::State2_Action& dsdt, double /*t*/)
-      {
-          dsdt = sys.dynamic_system_Action(s);
-      };
+          //system should be passed by value to the closure, because integration_functor is coppied into the output range
+          //and reference may dangle
 
-      return boost::make_iterator_range(
-          boost::numeric::odeint::make_times_time_range(controlled_stepper,
-                                                        integration_functor,
-                                                        s_start, times.begin(), times.end(), options.initial_time_step));
+          auto integration_functor = [sys = std::move(system)]
+              (const action_state_type& s, action_state_type& dsdt, double /*t*/)
+          {
+              dsdt = sys.dynamic_system_Action(s);
+          };
 
+          return boost::make_iterator_range(
+              boost::numeric::odeint::make_times_time_range(controlled_stepper,
+                                                            integration_functor,
+                                                            s_start, times.begin(), times.end(), options.initial_time_step));
+        }
     }
 
-    template<typename DS>
+    template<typename StepperPolicy = Steppers::Default, typename DS,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     inline auto
     make_interval_range (DS system,   // not const &, see comment below
-                         Geometry::State2& s_start,
+                         typename DS::state_type& s_start,
                          const std::vector<double>& times,
                          const IntegrationOptions& options)
     {
+      using state_type = typename DS::state_type;
 
-      const auto controlled_stepper = make_controlled(options.abs_err,
-                                                      options.rel_err,
-                                                      ErrorStepperType<Geometry::State2>());
-
+      if constexpr (Hamiltonian::has_exact_flow_v<typename DS::hamiltonian_type>)
+        return make_exact_flow_interval_range(std::move(system), s_start, times);
+      else
+        {
+          const auto controlled_stepper = make_energy_projecting_stepper(
+              StepperPolicy::template make_controlled<state_type>(system, options.abs_err, options.rel_err),
+              EnergyProjection<DS>{system, s_start, options.energy_projection_every, options.energy_drift_threshold});
 
-      //system should be passed by value to the closure, because integration_functor is coppied into the output range
-      //and reference may dangle
 
-      auto integration_functor = [sys = std::move(system)]
-          (const Geometry::State2& s, Geometry::State2& dsdt, double /*t*/)
-      {
-          dsdt = sys.dynamic_system(s);
-      };
+          //system should be passed by value to the closure, because integration_functor is coppied into the output range
+          //and reference may dangle
 
-      return boost::make_iterator_range(
-          boost::numeric::odeint::make_times_time_range(controlled_stepper,
-                                                        integration_functor,
-                                                        s_start, times.begin(), times.end(), options.initial_time_step));
+          auto integration_functor = [sys = std::move(system)]
+              (const state_type& s, state_type& dsdt, double /*t*/)
+          {
+              dsdt = sys.dynamic_system(s);
+          };
 
+          return boost::make_iterator_range(
+              boost::numeric::odeint::make_times_time_range(controlled_stepper,
+                                                            integration_functor,
+                                                            s_start, times.begin(), times.end(), options.initial_time_step));
+        }
     }
 
     template<typename DS>
-    Geometry::Line make_init_cross_line (const DS& system, Geometry::State2 s_start)
+    Geometry::Hyperplane<DS::degrees_of_freedom> make_init_cross_line (const DS& system,
+                                                                       typename DS::state_type s_start)
     {
       const auto start_direction = system.dynamic_system(s_start);
 
-      return Integrators::Geometry::Line(s_start, start_direction);
+      return Integrators::Geometry::Hyperplane<DS::degrees_of_freedom>(s_start, start_direction);
     }
 
-    template<typename DS, typename FP>
+    /// \brief An observer of the crossings of line, stepped back onto it and kept if filteringPredicate accepts them
+    /// \param step_record the step record of the observed range (see make_dynamic_system_integration_range), or null;
+    /// it must outlive the observer
+    template<typename StepperPolicy = Steppers::Default, typename DS, typename FP,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     inline auto make_project_on_line_observer (DS system, // not const &. may dangle
-                                               const Geometry::Line& line,
-                                               FP filteringPredicate)
+                                               const Geometry::Hyperplane<DS::degrees_of_freedom>& line,
+                                               FP filteringPredicate,
+                                               const Steppers::step_record_t<StepperPolicy>* step_record = nullptr)
     {
 
       auto action_functor =
-          [sys = std::move(system), direction = line.perpendicular_vector()]
-              (Geometry::State2_Action s, double t, double current_distance)
+          [sys = std::move(system), direction = line.perpendicular_vector(), step_record]
+              (typename DS::action_state_type s, double t, double current_distance)
+          {
+              return step_back<StepperPolicy>(sys, direction, s, t, current_distance, step_record);
+          };
+
+      return Observer::makeProjectOnSurfaceObserver<typename DS::extended_state_type>(
+          action_functor,
+          Geometry::HyperplaneCrossObserver<DS::degrees_of_freedom>(line),
+          filteringPredicate);
+    }
+
+    /// \brief Like make_project_on_line_observer, but the crossings are handed to sink as they are found
+    template<typename StepperPolicy = Steppers::Default, typename DS, typename FP, typename Sink>
+    inline auto make_project_on_line_observer_to_sink (DS system, // not const &. may dangle
+                                                       const Geometry::Hyperplane<DS::degrees_of_freedom>& line,
+                                                       FP filteringPredicate,
+                                                       Sink sink,
+                                                       const Steppers::step_record_t<StepperPolicy>* step_record
+                                                       = nullptr)
+    {
+
+      auto action_functor =
+          [sys = std::move(system), direction = line.perpendicular_vector(), step_record]
+              (typename DS::action_state_type s, double t, double current_distance)
+          {
+              return step_back<StepperPolicy>(sys, direction, s, t, current_distance, step_record);
+          };
+
+      return Observer::makeProjectOnSurfaceObserverToSink(action_functor,
+                                                          Geometry::HyperplaneCrossObserver<DS::degrees_of_freedom>(line),
+                                                          filteringPredicate,
+                                                          std::move(sink));
+    }
+
+    template<typename StepperPolicy = Steppers::Default, typename DS, typename FP>
+    inline auto make_project_on_line_any_direction_observer (DS system, // not const &. may dangle
+                                                             const Geometry::Hyperplane<DS::degrees_of_freedom>& line,
+                                                             FP filteringPredicate,
+                                                             const Steppers::step_record_t<StepperPolicy>* step_record
+                                                             = nullptr)
+    {
+
+      auto action_functor =
+          [sys = std::move(system), direction = line.perpendicular_vector(), step_record]
+              (typename DS::action_state_type s, double t, double current_distance)
           {
-              return step_back(sys, direction, s, t, current_distance);
+              return step_back<StepperPolicy>(sys, direction, s, t, current_distance, step_record);
           };
 
-      return Observer::makeProjectOnSurfaceObserver(action_functor, Geometry::LineCrossObserver(line), filteringPredicate);
+      return Observer::makeProjectOnSurfaceObserver<typename DS::extended_state_type>(
+          action_functor,
+          Geometry::HyperplaneAnyDirectionCrossObserver<DS::degrees_of_freedom>(line),
+          filteringPredicate);
     }
 
-    template<typename DS, typename FP>
+    template<typename StepperPolicy = Steppers::Default, typename DS, typename FP,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     inline auto make_project_on_periodic_Q_observer (DS system, // not const &. may dangle
                                                      Geometry::PeriodicQSurfaceCrossObserver po,
-                                                     FP filteringPredicate)
+                                                     FP filteringPredicate,
+                                                     const Steppers::step_record_t<StepperPolicy>* step_record
+                                                     = nullptr)
     {
 
       auto action_functor =
-          [sys = std::move(system), direction = Geometry::State2{1, 0}]
+          [sys = std::move(system), direction = Geometry::State2{1, 0}, step_record]
               (Geometry::State2_Action s, double t, double current_distance)
           {
-              return step_back(sys, direction, s, t, current_distance);
+              return step_back<StepperPolicy>(sys, direction, s, t, current_distance, step_record);
           };
 
       return Observer::makeProjectOnSurfaceObserver(action_functor, po, filteringPredicate);
@@ -258,31 +451,39 @@ namespace Integrators
 
     };
 
-    template<typename Ham>
-    std::vector<Geometry::State2_Extended>
+    /// \brief The crossings of cross_line, a hyperplane in the phase space of Hamiltonian::degrees_of_freedom_v<Ham>
+    /// degrees of freedom, by the orbit starting at s_start: the Poincare section of the orbit.
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
+    std::vector<Geometry::ExtendedState<Hamiltonian::degrees_of_freedom_v<Ham>>>
     calculate_crossings (const Ham& hamiltonian,
-                         const Geometry::State2& s_start,
-                         const Geometry::Line& cross_line,
+                         const Geometry::PhaseSpaceState<Hamiltonian::degrees_of_freedom_v<Ham>>& s_start,
+                         const Geometry::Hyperplane<Hamiltonian::degrees_of_freedom_v<Ham>>& cross_line,
                          const TimeInterval& integrationTime,
                          const IntegrationOptions& options)
     {
 
-      Geometry::State2_Action s_start_Action{s_start};
+      Geometry::ActionState<Hamiltonian::degrees_of_freedom_v<Ham>> s_start_Action{s_start};
 
       const auto system = Dynamics::DynamicSystem{hamiltonian};
-      const auto integration_range = Integrators::make_dynamic_system_integration_range(system,
-                                                                                        s_start_Action,
-                                                                                        integrationTime,
-                                                                                        options);
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       &step_record);
+
+      auto observer = Integrators::make_project_on_line_observer<StepperPolicy>(system, cross_line, [] (auto&)
+      { return true; }, &step_record);
+      observer.reserve(options.expected_crossings);
 
-      auto observer = Integrators::make_project_on_line_observer(system, cross_line, [] (auto&)
-      { return true; });
       cross(observer, integration_range);
 
       return observer.observations();
     }
 
-    template<typename Ham>
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     std::vector<Geometry::State2_Extended>
     calculate_crossings (const Ham& hamiltonian,
                          const Geometry::State2& s_start,
@@ -294,38 +495,44 @@ namespace Integrators
       Geometry::State2_Action s_start_Action{s_start};
 
       const auto system = Dynamics::DynamicSystem{hamiltonian};
-      const auto integration_range = Integrators::make_dynamic_system_integration_range(system,
-                                                                                        s_start_Action,
-                                                                                        integrationTime,
-                                                                                        options);
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       &step_record);
 
-      auto observer = Integrators::make_project_on_periodic_Q_observer(system, periodicQSurfaceCrossObserver, [] (auto&)
-      { return true; });
+      auto observer = Integrators::make_project_on_periodic_Q_observer<StepperPolicy>(system, periodicQSurfaceCrossObserver, [] (auto&)
+      { return true; }, &step_record);
+      observer.reserve(options.expected_crossings);
 
       cross(observer, integration_range);
 
       return observer.observations();
     }
 
-    template<typename Ham>
-    Geometry::State2_Extended
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
+    Geometry::ExtendedState<Hamiltonian::degrees_of_freedom_v<Ham>>
     calculate_first_crossing (const Ham& hamiltonian,
-                              const Geometry::State2& s_start,
-                              const Geometry::Line& cross_line,
+                              const Geometry::PhaseSpaceState<Hamiltonian::degrees_of_freedom_v<Ham>>& s_start,
+                              const Geometry::Hyperplane<Hamiltonian::degrees_of_freedom_v<Ham>>& cross_line,
                               const TimeInterval& integrationTime,
                               const IntegrationOptions& options)
     {
 
       const auto system = Dynamics::DynamicSystem{hamiltonian};
-      Geometry::State2_Action s_start_Action{s_start};
+      Geometry::ActionState<Hamiltonian::degrees_of_freedom_v<Ham>> s_start_Action{s_start};
 
-      const auto integration_range = Integrators::make_dynamic_system_integration_range(system,
-                                                                                        s_start_Action,
-                                                                                        integrationTime,
-                                                                                        options);
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       &step_record);
 
-      auto observer = Integrators::make_project_on_line_observer(system, cross_line, [] (auto&)
-      { return true; });
+      auto observer = Integrators::make_project_on_line_observer<StepperPolicy>(system, cross_line, [] (auto&)
+      { return true; }, &step_record);
 
       cross_once(observer, integration_range);
 
@@ -337,21 +544,26 @@ namespace Integrators
       return observations.front();
     }
 
-    template<typename System, typename ObserverType>
+    /// \param step_record the step record that observer steps back along, if any (see
+    /// make_dynamic_system_integration_range)
+    template<typename StepperPolicy = Steppers::Default, typename System, typename ObserverType,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     Geometry::State2_Extended calculate_first_coming_back_home (System system,
                                                                 ObserverType observer,
                                                                 const Geometry::State2& s_start,
                                                                 const TimeInterval& integrationTime,
-                                                                const IntegrationOptions& options
-                                                               )
+                                                                const IntegrationOptions& options,
+                                                                Steppers::step_record_t<StepperPolicy>* step_record
+                                                                = nullptr)
     {
 
       Geometry::State2_Action s_start_Action{s_start};
 
-      const auto integration_range = Integrators::make_dynamic_system_integration_range(system,
-                                                                                        s_start_Action,
-                                                                                        integrationTime,
-                                                                                        options);
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       step_record);
 
       cross_once(observer, integration_range);
 
@@ -364,7 +576,8 @@ namespace Integrators
 
     }
 
-    template<typename Ham>
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     Geometry::State2_Extended
     come_back_home_closed_orbit (const Ham& hamiltonian,
                                  const Geometry::State2& s_start,
@@ -382,15 +595,23 @@ namespace Integrators
               return StateNear(distance_threshold)(s_home, s);
           };
 
-      auto back_home_observer = Integrators::make_project_on_line_observer(system,
-                                                                           cross_line,
-                                                                           is_back_predicate);
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      auto back_home_observer = Integrators::make_project_on_line_observer<StepperPolicy>(system,
+                                                                                          cross_line,
+                                                                                          is_back_predicate,
+                                                                                          &step_record);
 
-      return calculate_first_coming_back_home(system, back_home_observer, s_start, integrationTime, options);
+      return calculate_first_coming_back_home<StepperPolicy>(system,
+                                                             back_home_observer,
+                                                             s_start,
+                                                             integrationTime,
+                                                             options,
+                                                             &step_record);
 
     }
 
-    template<typename Ham>
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     Geometry::State2_Extended
     come_back_home_periodic_orbit (const Ham& hamiltonian,
                                    const Geometry::State2& s_start,
@@ -406,130 +627,1091 @@ namespace Integrators
               return std::abs(s.p() - p_start) < distance_threshold;
           };
 
-      auto back_home_observer = Integrators::make_project_on_periodic_Q_observer(system,
-                                                                                 Geometry::PeriodicQSurfaceCrossObserver{
-                                                                                     s_start},
-                                                                                 is_back_predicate);
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      auto back_home_observer = Integrators::make_project_on_periodic_Q_observer<StepperPolicy>(system,
+                                                                                                Geometry::PeriodicQSurfaceCrossObserver{
+                                                                                                    s_start},
+                                                                                                is_back_predicate,
+                                                                                                &step_record);
 
-      return calculate_first_coming_back_home(system, back_home_observer, s_start, integrationTime, options);
+      return calculate_first_coming_back_home<StepperPolicy>(system,
+                                                             back_home_observer,
+                                                             s_start,
+                                                             integrationTime,
+                                                             options,
+                                                             &step_record);
 
     }
 
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
-                                                    const Geometry::State2& s_start,
-                                                    const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
-                                                    const TimeInterval& integrationTime,
-                                                    const IntegrationOptions& options);
+    /// \brief The part of a reversible closed orbit between two successive crossings of the fixed line of the symmetry
+    struct ReversibleHalfOrbit {
+        Geometry::State2_Extended begin{};
+        Geometry::State2_Extended end{};
 
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
+        double period () const noexcept
+        {
+          return 2 * (end.t() - begin.t());
+        }
 
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                                           const Geometry::State2& s_start,
-                                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
-                                                           const TimeInterval& integrationTime,
-                                                           const IntegrationOptions& options);
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
-
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
-                                                    const Geometry::State2& s_start,
-                                                    const Geometry::Line& cross_line,
-                                                    const TimeInterval& integrationTime,
-                                                    const IntegrationOptions& options);
+        double action () const noexcept
+        {
+          return 2 * (end.J() - begin.J());
+        }
+    };
 
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::Line& cross_line,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
+    namespace Internals
+    {
+        /// \brief Where the half orbit of a reversible closed orbit starts
+        struct ReversibleHalfOrbitStart {
+            Geometry::State2 s{};
+            bool on_fixed_line = false;
+        };
+
+        /// \brief the number of crossings of the fixed line that end the half orbit starting at start
+        inline size_t reversible_half_orbit_crossings (const ReversibleHalfOrbitStart& start) noexcept
+        {
+          return start.on_fixed_line ? 1 : 2;
+        }
 
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                                           const Geometry::State2& s_start,
-                                                           const Geometry::Line& cross_line,
-                                                           const TimeInterval& integrationTime,
-                                                           const IntegrationOptions& options);
+        /// \brief s_start, or its projection on fixed_line if it lies within options.distance_threshold of it
+        inline ReversibleHalfOrbitStart reversible_half_orbit_start (const Geometry::Line& fixed_line,
+                                                                     const Geometry::State2& s_start,
+                                                                     const IntegrationOptions& options)
+        {
+          const auto distance = fixed_line(s_start);
+          if (std::abs(distance) > options.distance_threshold)
+            return ReversibleHalfOrbitStart{s_start, false};
 
-    extern template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::Line& cross_line,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
+          const auto normal = fixed_line.perpendicular_vector();
+          return ReversibleHalfOrbitStart{s_start - distance / magnitude_squared(normal) * normal, true};
+        }
 
-    extern template
-    Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
-                                                         const Geometry::State2& s_start,
-                                                         const Geometry::Line& cross_line,
-                                                         const TimeInterval& integrationTime,
-                                                         const IntegrationOptions& options);
-    extern template
-    Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
-                                                               const Geometry::State2& s_start,
-                                                               const Geometry::Line& cross_line,
-                                                               const TimeInterval& integrationTime,
-                                                               const IntegrationOptions& options);
-    extern template
+        /// \brief observer, except that the first state is not shown to it if skip is true. A cross observer that has
+        /// not seen any state takes the previous one to be on its surface, so leaving the surface from the first state
+        /// is not a crossing, even if rounding left that state just on the other side.
+        template<typename Observer>
+        auto skip_first_observation (Observer& observer, bool skip)
+        {
+          return [&observer, skip = skip] (const auto& s_t) mutable
+          {
+              if (skip)
+                {
+                  skip = false;
+                  return false;
+                }
+              return observer(s_t);
+          };
+        }
+
+        /// \brief the half orbit from start, given the crossings of the fixed line of the orbit integrated from start.s
+        /// at t_begin
+        /// \throws std::runtime_error if there are fewer crossings than reversible_half_orbit_crossings(start)
+        inline ReversibleHalfOrbit make_reversible_half_orbit (const ReversibleHalfOrbitStart& start,
+                                                               double t_begin,
+                                                               const std::vector<Geometry::State2_Extended>& crossings)
+        {
+          if (crossings.size() < reversible_half_orbit_crossings(start))
+            throw std::runtime_error("orbit never reached the symmetry line");
+
+          ReversibleHalfOrbit half_orbit{};
+
+          if (start.on_fixed_line)
+            {
+              half_orbit.begin = Geometry::State2_Extended{start.s};
+              half_orbit.begin.t() = t_begin;
+            }
+          else
+            half_orbit.begin = crossings.front();
+
+          half_orbit.end = crossings[reversible_half_orbit_crossings(start) - 1];
+
+          return half_orbit;
+        }
+    }
+
+    /// \brief Integrates a closed orbit that is invariant under a reversing symmetry until it has crossed the fixed line
+    /// of the symmetry twice (or once, if s_start already lies on it).
+    ///
+    /// A start within options.distance_threshold of the fixed line lies on it: it is moved onto the line, and the
+    /// integration leaving the line is not counted as a crossing, whichever side of the line s_start was on.
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    ReversibleHalfOrbit
+    calculate_reversible_half_orbit (const Ham& hamiltonian,
+                                     const Geometry::State2& s_start,
+                                     const Geometry::ReversingSymmetry& symmetry,
+                                     const TimeInterval& integrationTime,
+                                     const IntegrationOptions& options)
+    {
+      const auto system = Dynamics::DynamicSystem{hamiltonian};
+
+      const auto& fixed_line = symmetry.fixed_line();
+
+      const auto half_orbit_start = Internals::reversible_half_orbit_start(fixed_line, s_start, options);
+
+      Geometry::State2_Action s_start_Action{half_orbit_start.s};
+
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       &step_record);
+
+      auto observer = Integrators::make_project_on_line_any_direction_observer<StepperPolicy>(system, fixed_line, [] (auto&)
+      { return true; }, &step_record);
+
+      auto observe_past_start = Internals::skip_first_observation(observer, half_orbit_start.on_fixed_line);
+      Observer::cross_n_times(observe_past_start,
+                              integration_range,
+                              Internals::reversible_half_orbit_crossings(half_orbit_start));
+
+      return Internals::make_reversible_half_orbit(half_orbit_start, integrationTime.t_begin(), observer.observations());
+    }
+
+    /// \brief Calculates the period and the action of a closed orbit that is invariant under a reversing symmetry.
+    ///
+    /// Opt-in alternative to come_back_home_closed_orbit. Only the half orbit between two successive crossings of the
+    /// fixed line of the symmetry is integrated, and the return to s_start is never checked numerically.
+    /// \return s_start, extended with the action and the time of the completed orbit
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
     Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+    come_back_home_reversible_orbit (const Ham& hamiltonian,
+                                     const Geometry::State2& s_start,
+                                     const Geometry::ReversingSymmetry& symmetry,
+                                     const TimeInterval& integrationTime,
+                                     const IntegrationOptions& options)
+    {
+      const auto half_orbit = calculate_reversible_half_orbit<StepperPolicy>(hamiltonian,
+                                                                             s_start,
+                                                                             symmetry,
+                                                                             integrationTime,
+                                                                             options);
+
+      Geometry::State2_Extended s_home{s_start};
+      s_home.J() = half_orbit.action();
+      s_home.t() = integrationTime.t_begin() + half_orbit.period();
+
+      return s_home;
+    }
+
+    // The functions that took the Hamiltonian, or the dynamic system, as their first template parameter before the
+    // stepper policies, with the policy following it, e.g. calculate_crossings<Ham>(...) or
+    // calculate_crossings<Ham, Steppers::Fehlberg78>(...). Their first parameter is never deduced, so that calls naming
+    // no template argument resolve to the policy first functions.
+
+    namespace Internals
+    {
+        template<typename T>
+        struct non_deduced {
+            using type = T;
+        };
+
+        /// \brief T, in a context from which T is not deduced
+        template<typename T>
+        using non_deduced_t = typename non_deduced<T>::type;
+    }
+
+    template<typename DS, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<DS, StepperPolicy>>
+    typename DS::extended_state_type step_back (const Internals::non_deduced_t<DS>& system,
+                                                const typename DS::state_type direction,
+                                                const typename DS::action_state_type& s,
+                                                double t,
+                                                double distance)
+    {
+      return step_back<StepperPolicy>(system, direction, s, t, distance);
+    }
+
+    template<typename DS, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<DS, StepperPolicy>>
+    inline auto
+    make_dynamic_system_integration_range (Internals::non_deduced_t<DS> system,
+                                           typename DS::action_state_type& s_start,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options)
+    {
+      return make_dynamic_system_integration_range<StepperPolicy>(std::move(system), s_start, integrationTime, options);
+    }
+
+    template<typename DS, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<DS, StepperPolicy>>
+    inline auto
+    make_interval_range (Internals::non_deduced_t<DS> system,
+                         typename DS::action_state_type& s_start,
+                         const std::vector<double>& times,
+                         const IntegrationOptions& options)
+    {
+      return make_interval_range<StepperPolicy>(std::move(system), s_start, times, options);
+    }
+
+    template<typename DS, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<DS, StepperPolicy>>
+    inline auto
+    make_interval_range (Internals::non_deduced_t<DS> system,
+                         typename DS::state_type& s_start,
+                         const std::vector<double>& times,
+                         const IntegrationOptions& options)
+    {
+      return make_interval_range<StepperPolicy>(std::move(system), s_start, times, options);
+    }
+
+    template<typename DS, typename FP, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<DS, StepperPolicy>>
+    inline auto make_project_on_line_observer (Internals::non_deduced_t<DS> system,
+                                               const Geometry::Hyperplane<DS::degrees_of_freedom>& line,
+                                               FP filteringPredicate)
+    {
+      return make_project_on_line_observer<StepperPolicy>(std::move(system), line, std::move(filteringPredicate));
+    }
+
+    template<typename DS, typename FP, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<DS, StepperPolicy>>
+    inline auto make_project_on_periodic_Q_observer (Internals::non_deduced_t<DS> system,
+                                                     Geometry::PeriodicQSurfaceCrossObserver po,
+                                                     FP filteringPredicate)
+    {
+      return make_project_on_periodic_Q_observer<StepperPolicy>(std::move(system),
+                                                                std::move(po),
+                                                                std::move(filteringPredicate));
+    }
+
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
+    std::vector<Geometry::ExtendedState<Hamiltonian::degrees_of_freedom_v<Ham>>>
+    calculate_crossings (const Internals::non_deduced_t<Ham>& hamiltonian,
+                         const Geometry::PhaseSpaceState<Hamiltonian::degrees_of_freedom_v<Ham>>& s_start,
+                         const Geometry::Hyperplane<Hamiltonian::degrees_of_freedom_v<Ham>>& cross_line,
+                         const TimeInterval& integrationTime,
+                         const IntegrationOptions& options)
+    {
+      return calculate_crossings<StepperPolicy>(hamiltonian, s_start, cross_line, integrationTime, options);
+    }
+
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings (const Internals::non_deduced_t<Ham>& hamiltonian,
+                         const Geometry::State2& s_start,
+                         const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                         const TimeInterval& integrationTime,
+                         const IntegrationOptions& options)
+    {
+      return calculate_crossings<StepperPolicy>(hamiltonian,
+                                                s_start,
+                                                periodicQSurfaceCrossObserver,
+                                                integrationTime,
+                                                options);
+    }
+
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
+    Geometry::ExtendedState<Hamiltonian::degrees_of_freedom_v<Ham>>
+    calculate_first_crossing (const Internals::non_deduced_t<Ham>& hamiltonian,
+                              const Geometry::PhaseSpaceState<Hamiltonian::degrees_of_freedom_v<Ham>>& s_start,
+                              const Geometry::Hyperplane<Hamiltonian::degrees_of_freedom_v<Ham>>& cross_line,
+                              const TimeInterval& integrationTime,
+                              const IntegrationOptions& options)
+    {
+      return calculate_first_crossing<StepperPolicy>(hamiltonian, s_start, cross_line, integrationTime, options);
+    }
+
+    template<typename System, typename ObserverType, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<System, StepperPolicy>>
+    Geometry::State2_Extended calculate_first_coming_back_home (Internals::non_deduced_t<System> system,
+                                                                ObserverType observer,
                                                                 const Geometry::State2& s_start,
-                                                                const Geometry::Line& cross_line,
                                                                 const TimeInterval& integrationTime,
-                                                                const IntegrationOptions& options);
-    extern template
+                                                                const IntegrationOptions& options)
+    {
+      return calculate_first_coming_back_home<StepperPolicy>(std::move(system),
+                                                             std::move(observer),
+                                                             s_start,
+                                                             integrationTime,
+                                                             options);
+    }
+
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
     Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
-                                                               const Geometry::State2& s_start,
-                                                               const Geometry::Line& cross_line,
-                                                               const TimeInterval& integrationTime,
-                                                               const IntegrationOptions& options);
+    come_back_home_closed_orbit (const Internals::non_deduced_t<Ham>& hamiltonian,
+                                 const Geometry::State2& s_start,
+                                 const TimeInterval& integrationTime,
+                                 const IntegrationOptions& options)
+    {
+      return come_back_home_closed_orbit<StepperPolicy>(hamiltonian, s_start, integrationTime, options);
+    }
 
-    extern template
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
     Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
-                                                            const Geometry::State2& s_start,
-                                                            const TimeInterval& integrationTime,
-                                                            const IntegrationOptions& options);
+    come_back_home_periodic_orbit (const Internals::non_deduced_t<Ham>& hamiltonian,
+                                   const Geometry::State2& s_start,
+                                   const TimeInterval& integrationTime,
+                                   const IntegrationOptions& options)
+    {
+      return come_back_home_periodic_orbit<StepperPolicy>(hamiltonian, s_start, integrationTime, options);
+    }
 
     extern template
-    Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
-                                                                  const Geometry::State2& s_start,
-                                                                  const TimeInterval& integrationTime,
-                                                                  const IntegrationOptions& options);
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
     extern template
-    Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                                                   const Geometry::State2& s_start,
-                                                                   const TimeInterval& integrationTime,
-                                                                   const IntegrationOptions& options);
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
     extern template
     Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
-                                                                  const Geometry::State2& s_start,
-                                                                  const TimeInterval& integrationTime,
-                                                                  const IntegrationOptions& options);
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
 
     extern template
     Geometry::State2_Extended
-    come_back_home_periodic_orbit (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                   const Geometry::State2& s_start,
-                                   const TimeInterval& integrationTime,
-                                   const IntegrationOptions& options);
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                               const Geometry::State2& s_start,
+                                                               const Geometry::ReversingSymmetry& symmetry,
+                                                               const TimeInterval& integrationTime,
+                                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                               const Geometry::State2& s_start,
+                                                               const Geometry::ReversingSymmetry& symmetry,
+                                                               const TimeInterval& integrationTime,
+                                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                               const Geometry::State2& s_start,
+                                                               const Geometry::ReversingSymmetry& symmetry,
+                                                               const TimeInterval& integrationTime,
+                                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                             const Geometry::State2& s_start,
+                                                             const TimeInterval& integrationTime,
+                                                             const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                               const Geometry::State2& s_start,
+                                                               const Geometry::ReversingSymmetry& symmetry,
+                                                               const TimeInterval& integrationTime,
+                                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                             const Geometry::State2& s_start,
+                                                             const TimeInterval& integrationTime,
+                                                             const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options);
+
+
+    extern template
+    std::vector<Geometry::State4_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                               const Geometry::State4& s_start,
+                                               const Geometry::Hyperplane<2>& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State4_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                    const Geometry::State4& s_start,
+                                                    const Geometry::Hyperplane<2>& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State4_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                   const Geometry::State4& s_start,
+                                                   const Geometry::Hyperplane<2>& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    Geometry::State4_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                        const Geometry::State4& s_start,
+                                                        const Geometry::Hyperplane<2>& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State4_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                               const Geometry::State4& s_start,
+                                               const Geometry::Hyperplane<2>& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    extern template
+    Geometry::State4_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                    const Geometry::State4& s_start,
+                                                    const Geometry::Hyperplane<2>& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::Line& cross_line,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::Line& cross_line,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    extern template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::Line& cross_line,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                const Geometry::State2& s_start,
+                                                const Geometry::Line& cross_line,
+                                                const TimeInterval& integrationTime,
+                                                const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                const Geometry::State2& s_start,
+                                                const Geometry::Line& cross_line,
+                                                const TimeInterval& integrationTime,
+                                                const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                const Geometry::State2& s_start,
+                                                const Geometry::Line& cross_line,
+                                                const TimeInterval& integrationTime,
+                                                const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const Geometry::ReversingSymmetry& symmetry,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    extern template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const Geometry::ReversingSymmetry& symmetry,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
 }
 #endif //HAMILTONIANS_INTEGRATION_HPP
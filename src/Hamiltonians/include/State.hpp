@@ -18,11 +18,18 @@ namespace Integrators
     namespace Geometry
     {
 
-        template<unsigned N, typename = typename std::enable_if<(N >= 2)>::type>
-        class State : boost::additive<State<N>, boost::additive<State<N>, double,
-            boost::multiplicative<State<N>, double> > > {
-
-          template<unsigned M, typename>
+        /// \brief A point of the phase space of a system of DOF degrees of freedom, optionally extended by more
+        /// coordinates: {q_1, ..., q_DOF, p_1, ..., p_DOF, J, t, ...}.
+        ///
+        /// The coordinates are stored in a fixed size vector, so that a State never allocates. The states of the same
+        /// number of degrees of freedom convert to each other by truncation or by zero padding.
+        /// \tparam N the number of coordinates
+        /// \tparam DOF the number of degrees of freedom
+        template<unsigned N, unsigned DOF = 1, typename = typename std::enable_if<(DOF >= 1 && N >= 2 * DOF)>::type>
+        class State : boost::additive<State<N, DOF>, boost::additive<State<N, DOF>, double,
+            boost::multiplicative<State<N, DOF>, double> > > {
+
+          template<unsigned M, unsigned D, typename>
           friend
           class State;
 
@@ -34,6 +41,9 @@ namespace Integrators
           vector_type v_{arma::fill::zeros};
 
          public:
+          static constexpr unsigned dimension = N;
+          static constexpr unsigned degrees_of_freedom = DOF;
+
           State () = default;
           State (std::initializer_list<double> l) noexcept
               : v_{l}
@@ -45,7 +55,7 @@ namespace Integrators
           ///
           /// see https://stackoverflow.com/a/17842695/6060982
           template<unsigned M>
-          explicit State (const State<M>& other, typename std::enable_if<(N < M)>::type * = 0) noexcept
+          explicit State (const State<M, DOF>& other, typename std::enable_if<(N < M)>::type * = 0) noexcept
               : v_{other.v_(arma::span(0, N - 1))}
           {
           }
@@ -56,7 +66,7 @@ namespace Integrators
           ///
           /// see https://stackoverflow.com/a/17842695/6060982
           template<unsigned M>
-          explicit State (const State<M>& other, typename std::enable_if<(N > M)>::type * = 0) noexcept
+          explicit State (const State<M, DOF>& other, typename std::enable_if<(N > M)>::type * = 0) noexcept
               : v_{}
           {
             v_(arma::span(0, M - 1)) = other.v_;
@@ -64,7 +74,7 @@ namespace Integrators
           }
 
           template<unsigned M>
-          State& operator= (const State<M>& other)
+          State& operator= (const State<M, DOF>& other)
           {
 
             if constexpr (N < M)
@@ -78,39 +88,71 @@ namespace Integrators
             return *this;
           }
 
-          double q () const noexcept
+          /// \brief unchecked access to the i-th coordinate
+          double operator[] (unsigned i) const noexcept
+          {
+            return v_[i];
+          }
+
+          /// \brief unchecked access to the i-th coordinate
+          double& operator[] (unsigned i) noexcept
+          {
+            return v_[i];
+          }
+
+          template<unsigned D = DOF>
+          Enable_if<(D == 1), double> q () const noexcept
           {
             return v_[0];
           }
 
-          double& q () noexcept
+          template<unsigned D = DOF>
+          Enable_if<(D == 1), double>& q () noexcept
           {
             return v_[0];
           }
 
-          double p () const noexcept
+          template<unsigned D = DOF>
+          Enable_if<(D == 1), double> p () const noexcept
           {
             return v_[1];
           }
 
-          double& p () noexcept
+          template<unsigned D = DOF>
+          Enable_if<(D == 1), double>& p () noexcept
           { return v_[1]; }
 
+          /// \brief the i-th position coordinate, unchecked
+          double q (unsigned i) const noexcept
+          { return v_[i]; }
+
+          /// \brief the i-th position coordinate, unchecked
+          double& q (unsigned i) noexcept
+          { return v_[i]; }
+
+          /// \brief the i-th momentum coordinate, unchecked
+          double p (unsigned i) const noexcept
+          { return v_[DOF + i]; }
+
+          /// \brief the i-th momentum coordinate, unchecked
+          double& p (unsigned i) noexcept
+          { return v_[DOF + i]; }
+
           template<unsigned DIM = N>
-          Enable_if<(DIM >= 3), double> J () const noexcept
-          { return v_[2]; }
+          Enable_if<(DIM >= 2 * DOF + 1), double> J () const noexcept
+          { return v_[2 * DOF]; }
 
           template<unsigned DIM = N>
-          Enable_if<(DIM >= 3), double>& J () noexcept
-          { return v_[2]; }
+          Enable_if<(DIM >= 2 * DOF + 1), double>& J () noexcept
+          { return v_[2 * DOF]; }
 
           template<unsigned DIM = N>
-          Enable_if<(DIM >= 4), double> t () const noexcept
-          { return v_[3]; }
+          Enable_if<(DIM >= 2 * DOF + 2), double> t () const noexcept
+          { return v_[2 * DOF + 1]; }
 
           template<unsigned DIM = N>
-          Enable_if<(DIM >= 4), double>& t ()  noexcept
-          { return v_[3]; }
+          Enable_if<(DIM >= 2 * DOF + 2), double>& t ()  noexcept
+          { return v_[2 * DOF + 1]; }
 
           inline State& operator+= (double d) noexcept
           {
@@ -170,40 +212,56 @@ namespace Integrators
             return ret;
           }
 
-          template<unsigned DIM>
-          friend std::ostream& operator<< (std::ostream& out, const State<DIM>& s);
+          template<unsigned DIM, unsigned D>
+          friend std::ostream& operator<< (std::ostream& out, const State<DIM, D>& s);
 
         };
 
-        template<unsigned N>
-        auto abs (const State<N>& s)
+        template<unsigned N, unsigned DOF>
+        auto abs (const State<N, DOF>& s)
         {
           return s.abs();
         }
 
-        template<unsigned N>
-        double magnitude_squared (const State<N>& s) noexcept
+        template<unsigned N, unsigned DOF>
+        double magnitude_squared (const State<N, DOF>& s) noexcept
         {
           return s * s;
         }
 
-        template<unsigned N>
-        double magnitude(const State<N>& s) noexcept
+        template<unsigned N, unsigned DOF>
+        double magnitude(const State<N, DOF>& s) noexcept
         {
-          return std::sqrt(magnitude_squared<N>(s));
+          return std::sqrt(magnitude_squared(s));
         }
 
-        template<unsigned N>
-        std::ostream& operator<< (std::ostream& out, const State<N>& s)
+        template<unsigned N, unsigned DOF>
+        std::ostream& operator<< (std::ostream& out, const State<N, DOF>& s)
         {
           for (const auto& coord : s.v_)
             out << coord << ' ';
           return out;
         }
 
-        using State2 = State<2>;
-        using State2_Action = State<3>;
-        using State2_Extended = State<4>;
+        /// \brief {q_1, ..., q_DOF, p_1, ..., p_DOF}
+        template<unsigned DOF>
+        using PhaseSpaceState = State<2 * DOF, DOF>;
+
+        /// \brief the phase space position and the action J = integral of p.dq along the orbit
+        template<unsigned DOF>
+        using ActionState = State<2 * DOF + 1, DOF>;
+
+        /// \brief the phase space position, the action and the time
+        template<unsigned DOF>
+        using ExtendedState = State<2 * DOF + 2, DOF>;
+
+        using State2 = PhaseSpaceState<1>;
+        using State2_Action = ActionState<1>;
+        using State2_Extended = ExtendedState<1>;
+
+        using State4 = PhaseSpaceState<2>;
+        using State4_Action = ActionState<2>;
+        using State4_Extended = ExtendedState<2>;
     }
 }
 
@@ -213,28 +271,10 @@ namespace boost
     {
         namespace odeint
         {
-            template<>
-            struct vector_space_norm_inf<Integrators::Geometry::State2> {
-                typedef double result_type;
-                double operator() (const Integrators::Geometry::State2& s) const
-                {
-                  return s.inf_norm();
-                }
-            };
-
-            template<>
-            struct vector_space_norm_inf<Integrators::Geometry::State2_Action> {
-                typedef double result_type;
-                double operator() (const Integrators::Geometry::State2_Action& s) const
-                {
-                  return s.inf_norm();
-                }
-            };
-
-            template<>
-            struct vector_space_norm_inf<Integrators::Geometry::State2_Extended> {
+            template<unsigned N, unsigned DOF>
+            struct vector_space_norm_inf<Integrators::Geometry::State<N, DOF> > {
                 typedef double result_type;
-                double operator() (const Integrators::Geometry::State2_Extended& s) const
+                double operator() (const Integrators::Geometry::State<N, DOF>& s) const
                 {
                   return s.inf_norm();
                 }
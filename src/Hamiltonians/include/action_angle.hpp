@@ -5,6 +5,7 @@
 #ifndef HAMILTONIANS_ACTION_ANGLE_HPP
 #define HAMILTONIANS_ACTION_ANGLE_HPP
 
+#include <algorithm>
 #include <boost/math/constants/constants.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm_ext/push_back.hpp>
@@ -48,7 +49,8 @@ namespace Integrators
       }
     };
 
-    template<typename Ham>
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     AnglesPositions map_positions_to_angles_along_orbit (Ham hamiltonian,
                                                          Geometry::State2 s_start,
                                                          double orbit_completion_time,
@@ -57,7 +59,7 @@ namespace Integrators
     {
       auto times = PanosUtilities::linspace(0.0, orbit_completion_time, number_of_angles);
 
-      auto orbit_range = make_interval_range(Dynamics::DynamicSystem(hamiltonian), s_start, times, options);
+      auto orbit_range = make_interval_range<StepperPolicy>(Dynamics::DynamicSystem(hamiltonian), s_start, times, options);
 
       std::vector<Geometry::State2> positions{};
       boost::push_back(positions, orbit_range | boost::adaptors::transformed([] (const auto& p)
@@ -67,7 +69,92 @@ namespace Integrators
                              positions};
     }
 
-    template<typename Ham>
+    namespace Internals
+    {
+        /// \brief t, or its mirror image through half_orbit_end_time if it lies past it
+        inline double reversible_orbit_mirrored_time (double t, double half_orbit_end_time) noexcept
+        {
+          return t <= half_orbit_end_time ? t : 2 * half_orbit_end_time - t;
+        }
+
+        /// \brief the sorted times, all within the half orbit, at which to integrate for the positions at times
+        inline std::vector<double> reversible_orbit_integration_times (const std::vector<double>& times,
+                                                                       double half_orbit_end_time)
+        {
+          std::vector<double> integration_times{};
+          integration_times.reserve(times.size());
+          for (const auto t: times)
+            integration_times.push_back(reversible_orbit_mirrored_time(t, half_orbit_end_time));
+
+          std::sort(integration_times.begin(), integration_times.end());
+          integration_times.erase(std::unique(integration_times.begin(), integration_times.end()),
+                                  integration_times.end());
+
+          return integration_times;
+        }
+
+        /// \brief the positions at times, from the positions at the integration_times of
+        /// reversible_orbit_integration_times, using s(t_half + tau) = R(s(t_half - tau)) past the half orbit
+        inline std::vector<Geometry::State2>
+        unfold_reversible_orbit_positions (const std::vector<double>& times,
+                                           const std::vector<double>& integration_times,
+                                           const std::vector<Geometry::State2>& half_orbit_positions,
+                                           const Geometry::ReversingSymmetry& symmetry,
+                                           double half_orbit_end_time)
+        {
+          std::vector<Geometry::State2> positions{};
+          positions.reserve(times.size());
+
+          for (const auto t: times)
+            {
+              const auto t_half = reversible_orbit_mirrored_time(t, half_orbit_end_time);
+              const auto index = static_cast<size_t>(
+                  std::lower_bound(integration_times.begin(), integration_times.end(), t_half)
+                  - integration_times.begin());
+
+              const auto& s = half_orbit_positions[index];
+              positions.push_back(t <= half_orbit_end_time ? s : symmetry(s));
+            }
+
+          return positions;
+        }
+    }
+
+    /// \brief Like map_positions_to_angles_along_orbit, but only integrates up to the end of the half orbit. Positions
+    /// past it are mirrored through the symmetry, using s(t_half + tau) = R(s(t_half - tau)).
+    /// \param half_orbit_end_time the time, measured from s_start, at which the half orbit ends
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    AnglesPositions map_positions_to_angles_along_reversible_orbit (Ham hamiltonian,
+                                                                    Geometry::State2 s_start,
+                                                                    const Geometry::ReversingSymmetry& symmetry,
+                                                                    double orbit_completion_time,
+                                                                    double half_orbit_end_time,
+                                                                    const IntegrationOptions& options,
+                                                                    size_t number_of_angles)
+    {
+      const auto times = PanosUtilities::linspace(0.0, orbit_completion_time, number_of_angles);
+      const auto integration_times = Internals::reversible_orbit_integration_times(times, half_orbit_end_time);
+
+      auto orbit_range = make_interval_range<StepperPolicy>(Dynamics::DynamicSystem(hamiltonian),
+                                                            s_start,
+                                                            integration_times,
+                                                            options);
+
+      std::vector<Geometry::State2> half_orbit_positions{};
+      half_orbit_positions.reserve(integration_times.size());
+      boost::push_back(half_orbit_positions, orbit_range | boost::adaptors::transformed([] (const auto& p)
+                                                                                        { return p.first; }));
+
+      return AnglesPositions{PanosUtilities::linspace(0.0, boost::math::double_constants::two_pi, number_of_angles),
+                             Internals::unfold_reversible_orbit_positions(times,
+                                                                         integration_times,
+                                                                         half_orbit_positions,
+                                                                         symmetry,
+                                                                         half_orbit_end_time)};
+    }
+
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     ActionAngleOrbit calculate_action_angle_on_closed_orbit (Ham hamiltonian,
                                                              const Geometry::State2& s_start,
                                                              const TimeInterval& integrationTime,
@@ -75,24 +162,25 @@ namespace Integrators
                                                              size_t number_of_angles = 100)
     {
 
-      const auto s_out_extended = come_back_home_closed_orbit(hamiltonian, s_start, integrationTime, options);
+      const auto s_out_extended = come_back_home_closed_orbit<StepperPolicy>(hamiltonian, s_start, integrationTime, options);
 
       const auto action = s_out_extended.J();
-      const auto period = s_out_extended.t();
+      const auto period = s_out_extended.t() - integrationTime.t_begin();
       const auto omega = boost::math::double_constants::two_pi / period;
 
-      const auto anglesPositions = map_positions_to_angles_along_orbit(hamiltonian,
-                                                                       s_start,
-                                                                       period,
-                                                                       options,
-                                                                       number_of_angles);
+      const auto anglesPositions = map_positions_to_angles_along_orbit<StepperPolicy>(hamiltonian,
+                                                                                      s_start,
+                                                                                      period,
+                                                                                      options,
+                                                                                      number_of_angles);
 
 
       return ActionAngleOrbit{action, omega, anglesPositions};
 
     }
 
-    template<typename Ham>
+    template<typename StepperPolicy = Steppers::Default, typename Ham,
+        typename = Steppers::enable_if_policy_t<StepperPolicy>>
     ActionAngleOrbit calculate_action_angle_on_periodic_orbit (Ham hamiltonian,
                                                                const Geometry::State2& s_start,
                                                                const TimeInterval& integrationTime,
@@ -100,22 +188,104 @@ namespace Integrators
                                                                size_t number_of_angles = 100)
     {
 
-      const auto s_out_extended = come_back_home_periodic_orbit(hamiltonian, s_start, integrationTime, options);
+      const auto s_out_extended = come_back_home_periodic_orbit<StepperPolicy>(hamiltonian, s_start, integrationTime, options);
 
       const auto action = s_out_extended.J();
-      const auto period = s_out_extended.t();
+      const auto period = s_out_extended.t() - integrationTime.t_begin();
+      const auto omega = boost::math::double_constants::two_pi / period;
+
+      const auto anglesPositions = map_positions_to_angles_along_orbit<StepperPolicy>(hamiltonian,
+                                                                                      s_start,
+                                                                                      period,
+                                                                                      options,
+                                                                                      number_of_angles);
+
+
+      return ActionAngleOrbit{action, omega, anglesPositions};
+
+    }
+
+    /// \brief Like calculate_action_angle_on_closed_orbit, for orbits that are invariant under a reversing symmetry.
+    /// Only the half orbit is integrated, both for the action and for the angle mapping.
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    ActionAngleOrbit calculate_action_angle_on_reversible_orbit (Ham hamiltonian,
+                                                                 const Geometry::State2& s_start,
+                                                                 const Geometry::ReversingSymmetry& symmetry,
+                                                                 const TimeInterval& integrationTime,
+                                                                 const IntegrationOptions& options,
+                                                                 size_t number_of_angles = 100)
+    {
+
+      const auto half_orbit = calculate_reversible_half_orbit<StepperPolicy>(hamiltonian,
+                                                                             s_start,
+                                                                             symmetry,
+                                                                             integrationTime,
+                                                                             options);
+
+      const auto action = half_orbit.action();
+      const auto period = half_orbit.period();
       const auto omega = boost::math::double_constants::two_pi / period;
 
-      const auto anglesPositions = map_positions_to_angles_along_orbit(hamiltonian,
-                                                                       s_start,
-                                                                       period,
-                                                                       options,
-                                                                       number_of_angles);
+      const auto anglesPositions = map_positions_to_angles_along_reversible_orbit<StepperPolicy>(hamiltonian,
+                                                                                                 s_start,
+                                                                                                 symmetry,
+                                                                                                 period,
+                                                                                                 half_orbit.end.t()
+                                                                                                 - integrationTime.t_begin(),
+                                                                                                 options,
+                                                                                                 number_of_angles);
 
 
       return ActionAngleOrbit{action, omega, anglesPositions};
 
     }
 
+    // Hamiltonian first, as before the stepper policies, see Integration.hpp
+
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
+    AnglesPositions map_positions_to_angles_along_orbit (Internals::non_deduced_t<Ham> hamiltonian,
+                                                         Geometry::State2 s_start,
+                                                         double orbit_completion_time,
+                                                         const IntegrationOptions& options,
+                                                         size_t number_of_angles)
+    {
+      return map_positions_to_angles_along_orbit<StepperPolicy>(std::move(hamiltonian),
+                                                                s_start,
+                                                                orbit_completion_time,
+                                                                options,
+                                                                number_of_angles);
+    }
+
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
+    ActionAngleOrbit calculate_action_angle_on_closed_orbit (Internals::non_deduced_t<Ham> hamiltonian,
+                                                             const Geometry::State2& s_start,
+                                                             const TimeInterval& integrationTime,
+                                                             const IntegrationOptions& options,
+                                                             size_t number_of_angles = 100)
+    {
+      return calculate_action_angle_on_closed_orbit<StepperPolicy>(std::move(hamiltonian),
+                                                                   s_start,
+                                                                   integrationTime,
+                                                                   options,
+                                                                   number_of_angles);
+    }
+
+    template<typename Ham, typename StepperPolicy = Steppers::Default,
+        typename = Steppers::enable_if_not_policy_t<Ham, StepperPolicy>>
+    ActionAngleOrbit calculate_action_angle_on_periodic_orbit (Internals::non_deduced_t<Ham> hamiltonian,
+                                                               const Geometry::State2& s_start,
+                                                               const TimeInterval& integrationTime,
+                                                               const IntegrationOptions& options,
+                                                               size_t number_of_angles = 100)
+    {
+      return calculate_action_angle_on_periodic_orbit<StepperPolicy>(std::move(hamiltonian),
+                                                                     s_start,
+                                                                     integrationTime,
+                                                                     options,
+                                                                     number_of_angles);
+    }
+
 }
 #endif //HAMILTONIANS_ACTION_ANGLE_HPP
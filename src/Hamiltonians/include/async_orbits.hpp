@@ -0,0 +1,193 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_ASYNC_ORBITS_HPP
+#define HAMILTONIANS_ASYNC_ORBITS_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "reversing_symmetry.hpp"
+#include "Integration.hpp"
+#include "action_angle.hpp"
+
+namespace Integrators
+{
+    /// \brief A fixed pool of threads, fed through a bounded queue, on which orbit queries run asynchronously.
+    ///
+    /// submit() blocks while the queue is full, which pushes back on the callers; try_submit() returns at once
+    /// instead. The results and the exceptions of the tasks are delivered through std::futures. An executor is meant
+    /// to be shared by all the callers of a process, and is thread safe. Its destructor runs the queued tasks to
+    /// completion before it joins the threads.
+    class OrbitExecutor {
+      std::mutex mutex_{};
+      std::condition_variable not_empty_{};
+      std::condition_variable not_full_{};
+      std::deque<std::function<void ()>> tasks_{};
+      size_t queue_capacity_;
+      bool stopping_ = false;
+      std::vector<std::thread> workers_{};
+
+      void work ();
+
+      /// \return false if wait is false and the queue is full
+      bool enqueue (std::function<void ()> task, bool wait);
+
+      template<typename F>
+      static auto make_task (F f)
+      {
+        using result_type = std::invoke_result_t<F&>;
+
+        auto task = std::make_shared<std::packaged_task<result_type ()>>(std::move(f));
+        auto future = task->get_future();
+
+        return std::make_pair(std::function<void ()>{[task] ()
+                                                     { (*task)(); }}, std::move(future));
+      }
+
+     public:
+      /// \param number_of_threads 0 for one per core
+      /// \param queue_capacity the number of tasks that may wait for a thread
+      explicit OrbitExecutor (unsigned number_of_threads = 0, size_t queue_capacity = 1024);
+
+      OrbitExecutor (const OrbitExecutor&) = delete;
+      OrbitExecutor& operator= (const OrbitExecutor&) = delete;
+
+      ~OrbitExecutor ();
+
+      /// \brief queues f(), waiting while the queue is full
+      template<typename F>
+      std::future<std::invoke_result_t<F&>> submit (F f)
+      {
+        auto[task, future] = make_task(std::move(f));
+        enqueue(std::move(task), true);
+        return std::move(future);
+      }
+
+      /// \brief queues f(), unless the queue is full
+      /// \return no future if the queue is full
+      template<typename F>
+      std::optional<std::future<std::invoke_result_t<F&>>> try_submit (F f)
+      {
+        auto[task, future] = make_task(std::move(f));
+        if (!enqueue(std::move(task), false))
+          return std::nullopt;
+        return std::move(future);
+      }
+
+      size_t number_of_threads () const noexcept;
+      size_t queue_capacity () const noexcept;
+      /// \brief the number of tasks waiting for a thread
+      size_t pending ();
+    };
+
+    /// \brief The asynchronous counterparts of the orbit queries. They copy their arguments, so every request carries
+    /// its own IntegrationOptions and nothing is shared with the caller, and they queue the query on executor like
+    /// OrbitExecutor::submit, waiting while the queue is full. The future rethrows the exceptions of the query.
+    namespace Async
+    {
+        /// \brief see Integrators::come_back_home_closed_orbit
+        template<typename StepperPolicy = Steppers::Default, typename Ham>
+        std::future<Geometry::State2_Extended>
+        come_back_home_closed_orbit (OrbitExecutor& executor,
+                                     Ham hamiltonian,
+                                     Geometry::State2 s_start,
+                                     TimeInterval integrationTime,
+                                     IntegrationOptions options)
+        {
+          return executor.submit([=] ()
+                                 {
+                                     return Integrators::come_back_home_closed_orbit<StepperPolicy>(hamiltonian,
+                                                                                                     s_start,
+                                                                                                     integrationTime,
+                                                                                                     options);
+                                 });
+        }
+
+        /// \brief see Integrators::calculate_first_crossing
+        template<typename StepperPolicy = Steppers::Default, typename Ham>
+        std::future<Geometry::ExtendedState<Hamiltonian::degrees_of_freedom_v<Ham>>>
+        calculate_first_crossing (OrbitExecutor& executor,
+                                  Ham hamiltonian,
+                                  Geometry::PhaseSpaceState<Hamiltonian::degrees_of_freedom_v<Ham>> s_start,
+                                  Geometry::Hyperplane<Hamiltonian::degrees_of_freedom_v<Ham>> cross_line,
+                                  TimeInterval integrationTime,
+                                  IntegrationOptions options)
+        {
+          return executor.submit([=] ()
+                                 {
+                                     return Integrators::calculate_first_crossing<StepperPolicy>(hamiltonian,
+                                                                                                  s_start,
+                                                                                                  cross_line,
+                                                                                                  integrationTime,
+                                                                                                  options);
+                                 });
+        }
+
+        /// \brief see Integrators::calculate_action_angle_on_closed_orbit
+        template<typename StepperPolicy = Steppers::Default, typename Ham>
+        std::future<ActionAngleOrbit>
+        calculate_action_angle_on_closed_orbit (OrbitExecutor& executor,
+                                                Ham hamiltonian,
+                                                Geometry::State2 s_start,
+                                                TimeInterval integrationTime,
+                                                IntegrationOptions options,
+                                                size_t number_of_angles = 100)
+        {
+          return executor.submit([=] ()
+                                 {
+                                     return Integrators::calculate_action_angle_on_closed_orbit<StepperPolicy>(
+                                         hamiltonian, s_start, integrationTime, options, number_of_angles);
+                                 });
+        }
+
+        /// \brief see Integrators::calculate_action_angle_on_periodic_orbit
+        template<typename StepperPolicy = Steppers::Default, typename Ham>
+        std::future<ActionAngleOrbit>
+        calculate_action_angle_on_periodic_orbit (OrbitExecutor& executor,
+                                                  Ham hamiltonian,
+                                                  Geometry::State2 s_start,
+                                                  TimeInterval integrationTime,
+                                                  IntegrationOptions options,
+                                                  size_t number_of_angles = 100)
+        {
+          return executor.submit([=] ()
+                                 {
+                                     return Integrators::calculate_action_angle_on_periodic_orbit<StepperPolicy>(
+                                         hamiltonian, s_start, integrationTime, options, number_of_angles);
+                                 });
+        }
+
+        /// \brief see Integrators::calculate_action_angle_on_reversible_orbit
+        template<typename StepperPolicy = Steppers::Default, typename Ham>
+        std::future<ActionAngleOrbit>
+        calculate_action_angle_on_reversible_orbit (OrbitExecutor& executor,
+                                                    Ham hamiltonian,
+                                                    Geometry::State2 s_start,
+                                                    Geometry::ReversingSymmetry symmetry,
+                                                    TimeInterval integrationTime,
+                                                    IntegrationOptions options,
+                                                    size_t number_of_angles = 100)
+        {
+          return executor.submit([=] ()
+                                 {
+                                     return Integrators::calculate_action_angle_on_reversible_orbit<StepperPolicy>(
+                                         hamiltonian, s_start, symmetry, integrationTime, options, number_of_angles);
+                                 });
+        }
+    }
+}
+
+#endif //HAMILTONIANS_ASYNC_ORBITS_HPP
@@ -0,0 +1,262 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_BIRKHOFF_AVERAGE_HPP
+#define HAMILTONIANS_BIRKHOFF_AVERAGE_HPP
+
+#include <algorithm>
+#include <complex>
+#include <optional>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+#include <boost/range/algorithm/find_if.hpp>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "Hamiltonian.hpp"
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    /// \brief Options for the weighted Birkhoff averages
+    struct BirkhoffOptions {
+        /// \brief converged once the averages over the first N and the first N/2 values agree to
+        /// tolerance * max(1, |average|). The values carry the integration error, so it cannot usefully be set below
+        /// the accuracy of the orbit.
+        double tolerance = 1e-10;
+        /// \brief convergence is not checked before this many values
+        size_t minimum_values = 20;
+        /// \brief convergence is checked every this many values
+        size_t check_every = 10;
+        /// \brief the integration stops unconverged after this many values
+        size_t maximum_values = 5000;
+    };
+
+    /// \brief The weighted Birkhoff average of a stream of values f(x_0), f(x_1), ...
+    ///
+    /// The values are weighted by w(n/N), w(t) = exp(-1/(t(1-t))), which vanishes smoothly at both ends. On regular
+    /// (quasi-periodic) orbits the weighted average converges faster than any power of 1/N, against 1/N for the
+    /// plain average. On chaotic orbits it converges no faster than the plain average, so a failure to converge marks
+    /// the orbit as chaotic.
+    class WeightedBirkhoffAverage {
+      BirkhoffOptions options_;
+      std::vector<double> values_{};
+      double average_ = 0;
+      double difference_ = 0;
+      bool converged_ = false;
+
+     public:
+      explicit WeightedBirkhoffAverage (const BirkhoffOptions& options = BirkhoffOptions{});
+
+      /// \brief the weighted average of the first n values
+      double average_of_first (size_t n) const noexcept;
+
+      /// \brief appends value, and checks the convergence if it is due
+      /// \return true once the average has converged
+      bool push (double value);
+
+      size_t size () const noexcept;
+      /// \brief the average at the last check
+      double average () const noexcept;
+      /// \brief |average of the first N - average of the first N/2| at the last check
+      double difference () const noexcept;
+      bool converged () const noexcept;
+      /// \brief true once maximum_values values have been pushed
+      bool exhausted () const noexcept;
+    };
+
+    /// \brief The outcome of a weighted Birkhoff average along an orbit
+    struct BirkhoffResult {
+        /// \brief the weighted average of all the number_of_values values, which are more than at the last check if
+        /// the integration stopped unconverged
+        double average = 0;
+        /// \brief the last difference between the averages over the first N and N/2 values
+        double difference = 0;
+        size_t number_of_values = 0;
+        /// \brief false if the average did not converge within the time interval or maximum_values, which marks the
+        /// orbit as chaotic
+        bool converged = false;
+        /// \brief the time of the last value
+        double time = 0;
+    };
+
+    namespace Observables
+    {
+        /// \brief the time between two successive crossings
+        struct ReturnTime {
+            double operator() (const Geometry::State2_Extended& previous,
+                               const Geometry::State2_Extended& current) const noexcept
+            {
+              return current.t() - previous.t();
+            }
+        };
+
+        /// \brief the action accumulated between two successive crossings
+        struct ActionIncrement {
+            double operator() (const Geometry::State2_Extended& previous,
+                               const Geometry::State2_Extended& current) const noexcept
+            {
+              return current.J() - previous.J();
+            }
+        };
+    }
+
+    /// \brief The weighted Birkhoff average of observable(previous crossing, crossing) over the successive crossings
+    /// of cross_line.
+    ///
+    /// The crossings are consumed as they are found, without being stored, and the integration stops as soon as the
+    /// average converges.
+    /// \param observable double (const Geometry::State2_Extended& previous, const Geometry::State2_Extended& current),
+    /// see Observables
+    template<typename StepperPolicy = Steppers::Default, typename Ham, typename Observable>
+    BirkhoffResult calculate_crossings_birkhoff_average (const Ham& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const Geometry::Line& cross_line,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options,
+                                                         Observable observable,
+                                                         const BirkhoffOptions& birkhoff_options = BirkhoffOptions{})
+    {
+      Geometry::State2_Action s_start_Action{s_start};
+
+      const auto system = Dynamics::DynamicSystem{hamiltonian};
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       &step_record);
+
+      WeightedBirkhoffAverage birkhoff_average{birkhoff_options};
+      std::optional<Geometry::State2_Extended> previous{};
+      double time = integrationTime.t_begin();
+      bool done = false;
+
+      auto sink = [&] (const Geometry::State2_Extended& crossing)
+      {
+          time = crossing.t();
+          if (previous)
+            done = birkhoff_average.push(observable(*previous, crossing)) || birkhoff_average.exhausted();
+          previous = crossing;
+      };
+
+      auto observer = Integrators::make_project_on_line_observer_to_sink<StepperPolicy>(system, cross_line, [] (auto&)
+      { return true; }, sink, &step_record);
+
+      boost::range::find_if(integration_range, [&observer, &done] (const auto& s_t)
+      {
+          return observer(s_t) && done;
+      });
+
+      return BirkhoffResult{birkhoff_average.average_of_first(birkhoff_average.size()), birkhoff_average.difference(),
+                            birkhoff_average.size(), birkhoff_average.converged(), time};
+    }
+
+    /// \brief The rotation number of the time sampling_period map of the orbit around center, i.e. the weighted
+    /// Birkhoff average of the angle swept between successive samples, in turns.
+    ///
+    /// The angle is measured clockwise, the direction of the orbits of H = p^2/2m + V(q), and every increment is taken
+    /// in [0, 1) turns, so the result is the rotation number modulo 1. Choose sampling_period so that it stays away
+    /// from 0 and 1.
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    BirkhoffResult calculate_rotation_number (const Ham& hamiltonian,
+                                              const Geometry::State2& s_start,
+                                              const Geometry::State2& center,
+                                              double sampling_period,
+                                              const TimeInterval& integrationTime,
+                                              const IntegrationOptions& options,
+                                              const BirkhoffOptions& birkhoff_options = BirkhoffOptions{})
+    {
+      const auto duration = integrationTime.t_end() - integrationTime.t_begin();
+      const auto number_of_samples = std::min(birkhoff_options.maximum_values + 1,
+                                              static_cast<size_t>(duration / sampling_period) + 1);
+
+      std::vector<double> times(number_of_samples);
+      for (size_t i = 0; i < number_of_samples; ++i)
+        times[i] = integrationTime.t_begin() + sampling_period * static_cast<double>(i);
+
+      Geometry::State2 s{s_start};
+      auto orbit_range = make_interval_range<StepperPolicy>(Dynamics::DynamicSystem<Ham>{hamiltonian}, s, times, options);
+
+      WeightedBirkhoffAverage birkhoff_average{birkhoff_options};
+      std::optional<std::complex<double>> previous{};
+      double time = integrationTime.t_begin();
+
+      boost::range::find_if(orbit_range, [&] (const auto& s_t)
+      {
+          const Geometry::State2 x{s_t.first};
+          time = s_t.second;
+
+          // clockwise angles are the arguments of q - i p
+          const std::complex<double> z{x.q() - center.q(), -(x.p() - center.p())};
+
+          bool done = false;
+          if (previous)
+            {
+              auto turn = std::arg(z / *previous) * boost::math::double_constants::one_div_two_pi;
+              if (turn < 0)
+                turn += 1;
+              done = birkhoff_average.push(turn) || birkhoff_average.exhausted();
+            }
+          previous = z;
+          return done;
+      });
+
+      return BirkhoffResult{birkhoff_average.average_of_first(birkhoff_average.size()), birkhoff_average.difference(),
+                            birkhoff_average.size(), birkhoff_average.converged(), time};
+    }
+
+    extern template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    extern template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    extern template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    extern template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    extern template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+}
+
+#endif //HAMILTONIANS_BIRKHOFF_AVERAGE_HPP
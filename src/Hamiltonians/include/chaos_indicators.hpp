@@ -0,0 +1,247 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_CHAOS_INDICATORS_HPP
+#define HAMILTONIANS_CHAOS_INDICATORS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/numeric/odeint.hpp>
+
+#include "State.hpp"
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "IntegrationTimeInterval.hpp"
+#include "Integration.hpp"
+#include "steppers.hpp"
+#include "details/parallel_for.hpp"
+
+namespace Integrators
+{
+    namespace Dynamics
+    {
+        /// \brief The orbit, its tangent vector and the chaos indicators, integrated together:
+        /// {q, p, u_q, u_p, ln|delta|, y, w}.
+        ///
+        /// The tangent vector delta is kept as its direction u and the logarithm of its length, which cannot
+        /// overflow even on strongly chaotic orbits. With the local growth rate r = u.(A u)/(u.u), where A is the
+        /// linearized flow, y' = tau r and w' = 2 y / tau, tau being the time since the start. The MEGNO is
+        /// Y = 2 y / tau, and its mean is w / tau.
+        using VariationalState = Geometry::State<7>;
+
+        template<typename Ham>
+        inline VariationalState variational_system_impl (const Ham& ham, const VariationalState& x, double tau)
+        {
+          const Geometry::State2 s{x[0], x[1]};
+          const auto dHds = ham.derivative(s);
+          const auto[h_qq, h_qp, h_pp] = Hamiltonian::hessian(ham, s);
+
+          const auto u_q = x[2];
+          const auto u_p = x[3];
+
+          // the linearized flow: d(delta q)/dt = H_pq delta q + H_pp delta p, d(delta p)/dt = -H_qq delta q - H_qp delta p
+          const auto Au_q = h_qp * u_q + h_pp * u_p;
+          const auto Au_p = -h_qq * u_q - h_qp * u_p;
+
+          const auto rate = (u_q * Au_q + u_p * Au_p) / (u_q * u_q + u_p * u_p);
+
+          VariationalState dxdt{};
+          dxdt[0] = dHds.p();
+          dxdt[1] = -dHds.q();
+          dxdt[2] = Au_q - rate * u_q;
+          dxdt[3] = Au_p - rate * u_p;
+          dxdt[4] = rate;
+          dxdt[5] = tau * rate;
+          dxdt[6] = tau > 0 ? 2 * x[5] / tau : 0;
+
+          return dxdt;
+        }
+    }
+
+    enum class OrbitType { regular, chaotic, undecided };
+
+    /// \brief Options for calculate_chaos_indicators
+    struct ChaosIndicatorOptions {
+        /// \brief no orbit is classified before this time
+        double minimum_time = 100;
+        /// \brief the mean MEGNO is compared with its value one interval earlier
+        double check_interval = 50;
+        /// \brief an orbit is regular once its mean MEGNO changes by less than this over a check_interval
+        double megno_tolerance = 0.02;
+        /// \brief an orbit is chaotic once its mean MEGNO exceeds this. Regular orbits converge to 2 (0 for
+        /// isochronous ones), chaotic orbits grow linearly with time.
+        double chaotic_megno = 4;
+        /// \brief the initial tangent vector, normalized internally; must be nonzero
+        Geometry::State2 initial_tangent{1, 1};
+        /// \brief false integrates every orbit to the end of the time interval
+        bool stop_when_classified = true;
+    };
+
+    /// \brief The chaos indicators of an orbit at the time it was classified, or at the end of the integration
+    struct ChaosIndicators {
+        /// \brief the time averaged MEGNO
+        double mean_megno = 0;
+        /// \brief the MEGNO Y(t)
+        double megno = 0;
+        /// \brief the fast Lyapunov indicator, the largest ln|delta| along the orbit
+        double fli = 0;
+        /// \brief the time of the last step
+        double time = 0;
+        OrbitType type = OrbitType::undecided;
+    };
+
+    /// \brief Integrates the orbit starting at s_start together with its tangent vector, and accumulates the MEGNO and
+    /// the FLI along it, in a single stepper call per step.
+    ///
+    /// The integration stops as soon as the orbit is classified (see ChaosIndicatorOptions), so that regular and
+    /// clearly chaotic seeds cost only a fraction of the time interval. The second derivatives come from
+    /// Hamiltonian::hessian. Only the Runge-Kutta stepper policies are supported.
+    /// \throws std::invalid_argument if chaos_options.initial_tangent is zero or not finite
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    ChaosIndicators calculate_chaos_indicators (const Ham& hamiltonian,
+                                                const Geometry::State2& s_start,
+                                                const TimeInterval& integrationTime,
+                                                const IntegrationOptions& options,
+                                                const ChaosIndicatorOptions& chaos_options = ChaosIndicatorOptions{})
+    {
+      const auto t_begin = integrationTime.t_begin();
+      const auto t_end = integrationTime.t_end();
+
+      const auto tangent_magnitude = magnitude(chaos_options.initial_tangent);
+      if (!(tangent_magnitude > 0 && std::isfinite(tangent_magnitude)))
+        throw std::invalid_argument("calculate_chaos_indicators: the initial tangent must be nonzero and finite");
+
+      const auto tangent = chaos_options.initial_tangent / tangent_magnitude;
+
+      Dynamics::VariationalState x{s_start.q(), s_start.p(), tangent.q(), tangent.p(), 0, 0, 0};
+
+      auto variational_functor = [&hamiltonian, t_begin] (const Dynamics::VariationalState& s,
+                                                         Dynamics::VariationalState& dsdt,
+                                                         double t)
+      {
+          dsdt = Dynamics::variational_system_impl(hamiltonian, s, t - t_begin);
+      };
+
+      const auto system = Dynamics::DynamicSystem<Ham>{hamiltonian};
+      const auto& dt_max = integrationTime.dt_max();
+
+      auto controlled_stepper = dt_max
+                                ? StepperPolicy::template make_controlled<Dynamics::VariationalState>(
+              system, options.abs_err, options.rel_err, dt_max.value())
+                                : StepperPolicy::template make_controlled<Dynamics::VariationalState>(
+              system, options.abs_err, options.rel_err);
+
+      ChaosIndicators indicators{};
+      double last_check_mean_megno = 0;
+      double next_check = chaos_options.minimum_time;
+
+      auto range = boost::numeric::odeint::make_adaptive_time_range(controlled_stepper,
+                                                                    variational_functor,
+                                                                    x,
+                                                                    t_begin,
+                                                                    t_end,
+                                                                    options.initial_time_step);
+
+      for (const auto&[s, t]: boost::make_iterator_range(range))
+        {
+          const auto tau = t - t_begin;
+
+          indicators.time = t;
+          indicators.fli = std::max(indicators.fli, s[4]);
+          if (tau > 0)
+            {
+              indicators.megno = 2 * s[5] / tau;
+              indicators.mean_megno = s[6] / tau;
+            }
+
+          if (tau < chaos_options.minimum_time)
+            continue;
+
+          if (indicators.mean_megno > chaos_options.chaotic_megno)
+            indicators.type = OrbitType::chaotic;
+          else if (tau >= next_check)
+            {
+              const auto converged =
+                  std::abs(indicators.mean_megno - last_check_mean_megno) < chaos_options.megno_tolerance;
+              indicators.type = converged ? OrbitType::regular : OrbitType::undecided;
+              last_check_mean_megno = indicators.mean_megno;
+              next_check = tau + chaos_options.check_interval;
+            }
+
+          if (indicators.type != OrbitType::undecided && chaos_options.stop_when_classified)
+            break;
+        }
+
+      return indicators;
+    }
+
+    /// \brief calculate_chaos_indicators for every seed, in parallel.
+    /// \param number_of_threads 0 for one per core
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    std::vector<ChaosIndicators> calculate_chaos_map (const Ham& hamiltonian,
+                                                      const std::vector<Geometry::State2>& seeds,
+                                                      const TimeInterval& integrationTime,
+                                                      const IntegrationOptions& options,
+                                                      const ChaosIndicatorOptions& chaos_options = ChaosIndicatorOptions{},
+                                                      unsigned number_of_threads = 0)
+    {
+      std::vector<ChaosIndicators> indicators(seeds.size());
+
+      Internals::parallel_for(seeds.size(), number_of_threads, [&] (size_t i)
+      {
+          indicators[i] = calculate_chaos_indicators<StepperPolicy>(hamiltonian,
+                                                                    seeds[i],
+                                                                    integrationTime,
+                                                                    options,
+                                                                    chaos_options);
+      });
+
+      return indicators;
+    }
+
+    extern template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    extern template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    extern template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    extern template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    extern template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+}
+
+#endif //HAMILTONIANS_CHAOS_INDICATORS_HPP
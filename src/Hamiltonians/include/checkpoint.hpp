@@ -0,0 +1,337 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_CHECKPOINT_HPP
+#define HAMILTONIANS_CHECKPOINT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/numeric/odeint/util/detail/less_with_sign.hpp>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "periodic_q_surface.hpp"
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "IntegrationTimeInterval.hpp"
+#include "exact_flow.hpp"
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    /// \brief Where and how often the long integrations save their progress
+    struct CheckpointOptions {
+        /// \brief the checkpoint file. Each save appends the new crossings to it and then rewrites its header, so an
+        /// interrupted save leaves the previous checkpoint in place.
+        std::string path{};
+        /// \brief the integration time between two checkpoints; 0 saves only at the end
+        double interval = 1000;
+    };
+
+    namespace Internals
+    {
+        /// \brief Everything an integration carries from step to step, as plain numbers.
+        ///
+        /// The fingerprint identifies the run (Hamiltonian, stepper, start, surface, time interval and integration
+        /// options), so that a checkpoint is never resumed by another run. The file stores the doubles in the native
+        /// binary format, so checkpoints are not portable across architectures.
+        ///
+        /// The file holds two copies of the header, written in turn, and the crossings after them. A save appends the
+        /// new crossings past those counted by the last header, and then overwrites the older header: a save cut short
+        /// leaves the last complete header, and the crossings it counts, intact.
+        struct Checkpoint {
+            std::vector<double> fingerprint{};
+            /// \brief the action state, i.e. the state and the accumulated action
+            std::vector<double> state{};
+            double t = 0;
+            double dt = 0;
+            /// \brief the number of steps, or of samples for the Hamiltonians with an exact flow
+            std::uint64_t steps = 0;
+            std::uint64_t steps_since_projection = 0;
+            /// \brief the distance from the surface at the last state, the memory of the surface cross observer
+            double distance = 0;
+            std::uint64_t crossing_dimension = 0;
+            /// \brief the number of crossings times crossing_dimension
+            std::uint64_t crossing_values = 0;
+            /// \brief the saves of the run so far, this one included; the first save creates the file
+            std::uint64_t sequence = 0;
+            /// \brief the crossings so far, one after the other; filled by load_checkpoint only
+            std::vector<double> crossings{};
+        };
+
+        /// \brief saves checkpoint, whose crossings end with new_crossings. The crossings before them must be in the file
+        /// already.
+        void save_checkpoint (const std::string& path, const Checkpoint& checkpoint,
+                              const std::vector<double>& new_crossings);
+
+        /// \return no checkpoint if there is no file at path
+        /// \throws std::runtime_error if the file is not a complete checkpoint
+        std::optional<Checkpoint> load_checkpoint (const std::string& path);
+
+        /// \brief appends the length of name and its characters
+        inline void append (std::vector<double>& values, const char* name)
+        {
+          const std::string characters{name};
+          values.push_back(static_cast<double>(characters.size()));
+          for (const auto c: characters)
+            values.push_back(static_cast<double>(c));
+        }
+
+        /// \brief appends the number of values and the values
+        inline void append (std::vector<double>& values, const std::vector<double>& more_values)
+        {
+          values.push_back(static_cast<double>(more_values.size()));
+          values.insert(values.end(), more_values.begin(), more_values.end());
+        }
+
+        template<unsigned N, unsigned DOF>
+        void append (std::vector<double>& values, const Geometry::State<N, DOF>& s)
+        {
+          for (unsigned i = 0; i < N; ++i)
+            values.push_back(s[i]);
+        }
+
+        template<typename StateType>
+        StateType read_state (const double* values)
+        {
+          StateType s{};
+          for (unsigned i = 0; i < StateType::dimension; ++i)
+            s[i] = values[i];
+          return s;
+        }
+
+        /// \brief the crossings of surface by the orbit of s_start, stepped back along direction, saved to and resumed
+        /// from checkpoint_options.path
+        template<typename StepperPolicy, typename DS, typename SurfaceCrossObserver>
+        std::vector<typename DS::extended_state_type>
+        calculate_crossings_with_checkpoints (const DS& system,
+                                              const typename DS::state_type& s_start,
+                                              SurfaceCrossObserver surface,
+                                              const typename DS::state_type& direction,
+                                              const TimeInterval& integrationTime,
+                                              const IntegrationOptions& options,
+                                              const CheckpointOptions& checkpoint_options)
+        {
+          using state_type = typename DS::state_type;
+          using action_state_type = typename DS::action_state_type;
+          using extended_state_type = typename DS::extended_state_type;
+          using boost::numeric::odeint::detail::less_with_sign;
+
+          const auto t_begin = integrationTime.t_begin();
+          const auto t_end = integrationTime.t_end();
+
+          const auto& dt_max = integrationTime.dt_max();
+
+          std::vector<double> fingerprint{};
+          append(fingerprint, DS::hamiltonian_type::name);
+          append(fingerprint, system.hamiltonian().parameters());
+          append(fingerprint, StepperPolicy::name);
+          append(fingerprint, s_start);
+          append(fingerprint, direction);
+          {
+            auto probe = surface;
+            probe(s_start);
+            fingerprint.push_back(probe.distance());
+          }
+          fingerprint.insert(fingerprint.end(), {t_begin, t_end, dt_max ? 1.0 : 0.0, dt_max.value_or(0.0),
+                                                 options.abs_err, options.rel_err, options.initial_time_step,
+                                                 static_cast<double>(options.energy_projection_every),
+                                                 options.energy_drift_threshold, options.exact_flow_sampling_step});
+
+          Steppers::step_record_t<StepperPolicy> step_record{};
+          auto stepper = Internals::make_controlled_stepper<StepperPolicy>(system, integrationTime, options, s_start,
+                                                                           &step_record);
+
+          std::vector<extended_state_type> crossings{};
+          crossings.reserve(options.expected_crossings);
+
+          action_state_type s{s_start};
+          double t = t_begin;
+          double dt = options.initial_time_step;
+          std::uint64_t steps = 0;
+
+          auto observe = [&] ()
+          {
+              if (surface(state_type{s}))
+                crossings.push_back(step_back<StepperPolicy>(system, direction, s, t, surface.distance(),
+                                                                   &step_record));
+          };
+
+          // the crossings in the file, and the saves so far
+          size_t saved_crossings = 0;
+          std::uint64_t sequence = 0;
+
+          auto save = [&] ()
+          {
+              if (checkpoint_options.path.empty())
+                return;
+
+              Checkpoint checkpoint{};
+              checkpoint.fingerprint = fingerprint;
+              append(checkpoint.state, s);
+              checkpoint.t = t;
+              checkpoint.dt = dt;
+              checkpoint.steps = steps;
+              checkpoint.steps_since_projection = stepper.projection().steps_since_projection();
+              checkpoint.distance = surface.distance();
+              checkpoint.crossing_dimension = extended_state_type::dimension;
+              checkpoint.crossing_values = crossings.size() * extended_state_type::dimension;
+              checkpoint.sequence = sequence + 1;
+
+              std::vector<double> new_crossings{};
+              new_crossings.reserve((crossings.size() - saved_crossings) * extended_state_type::dimension);
+              for (auto i = saved_crossings; i < crossings.size(); ++i)
+                append(new_crossings, crossings[i]);
+
+              save_checkpoint(checkpoint_options.path, checkpoint, new_crossings);
+
+              saved_crossings = crossings.size();
+              sequence = checkpoint.sequence;
+          };
+
+          const auto checkpoint = checkpoint_options.path.empty() ? std::nullopt
+                                                                  : load_checkpoint(checkpoint_options.path);
+          if (checkpoint)
+            {
+              if (checkpoint->fingerprint != fingerprint
+                  || checkpoint->state.size() != action_state_type::dimension
+                  || checkpoint->crossing_dimension != extended_state_type::dimension)
+                throw std::runtime_error("checkpoint " + checkpoint_options.path + " belongs to another integration");
+
+              s = read_state<action_state_type>(checkpoint->state.data());
+              t = checkpoint->t;
+              dt = checkpoint->dt;
+              steps = checkpoint->steps;
+              stepper.restore(s_start, checkpoint->steps_since_projection);
+              surface.restore_distance(checkpoint->distance);
+
+              const auto number_of_crossings = checkpoint->crossings.size() / extended_state_type::dimension;
+              for (size_t i = 0; i < number_of_crossings; ++i)
+                crossings.push_back(read_state<extended_state_type>(
+                    checkpoint->crossings.data() + i * extended_state_type::dimension));
+
+              saved_crossings = crossings.size();
+              sequence = checkpoint->sequence;
+            }
+
+          auto next_checkpoint = t + checkpoint_options.interval;
+          auto checkpoint_if_due = [&] ()
+          {
+              if (checkpoint_options.interval > 0 && t >= next_checkpoint)
+                {
+                  save();
+                  next_checkpoint = t + checkpoint_options.interval;
+                }
+          };
+
+          if constexpr (Hamiltonian::has_exact_flow_v<typename DS::hamiltonian_type>)
+            {
+              // the samples of make_exact_flow_range
+              const action_state_type s_start_Action{s_start};
+              const auto sampling_step = exact_flow_sampling_step(system,
+                                                                  Geometry::State2{s_start},
+                                                                  integrationTime,
+                                                                  options.exact_flow_sampling_step);
+
+              const auto number_of_steps = static_cast<std::uint64_t>(std::max(
+                  std::ceil((t_end - t_begin) / sampling_step), 0.0));
+
+              for (auto k = checkpoint ? steps + 1 : 0; k <= number_of_steps; ++k)
+                {
+                  steps = k;
+                  t = std::min(t_begin + static_cast<double>(k) * sampling_step, t_end);
+                  s = exact_flow(system, s_start_Action, t - t_begin);
+                  observe();
+                  checkpoint_if_due();
+                }
+            }
+          else
+            {
+              auto integration_functor = [&system] (const action_state_type& x, action_state_type& dxdt, double)
+              {
+                  dxdt = system.dynamic_system_Action(x);
+              };
+
+              if (!checkpoint)
+                {
+                  if (less_with_sign(t_end, t, dt))
+                    return crossings;
+                  observe();
+                }
+
+              // the steps of odeint's adaptive iterator
+              while (less_with_sign(t, t_end, dt))
+                {
+                  Internals::adaptive_step(stepper, integration_functor, s, t, dt, t_end);
+
+                  ++steps;
+                  observe();
+                  checkpoint_if_due();
+                }
+            }
+
+          save();
+
+          return crossings;
+        }
+    }
+
+    /// \brief Like calculate_crossings, but the progress is saved to checkpoint_options.path every
+    /// checkpoint_options.interval of integration time, and at the end.
+    ///
+    /// If the file exists, the integration resumes from it and continues bit-identically: the checkpoint holds the
+    /// state, the time, the step size, the memory of the energy projection and of the cross observer, and the crossings
+    /// so far. A run that has completed returns the crossings of its checkpoint. It must be resumed with the same
+    /// arguments and StepperPolicy, which are all checked: the Hamiltonian and its parameters(), the stepper, the start,
+    /// the line, the time interval and the integration options that change the orbit. Ham and StepperPolicy must have a
+    /// name. Each save writes only the crossings found since the last one. The steppers without memory across steps
+    /// (the Runge-Kutta ones and Taylor) resume bit-identically; BulirschStoer starts over with its extrapolation
+    /// order, so it resumes on an equally accurate, but not identical, orbit.
+    /// \throws std::runtime_error if the file is not a checkpoint of this integration
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    std::vector<Geometry::ExtendedState<Hamiltonian::degrees_of_freedom_v<Ham>>>
+    calculate_crossings_with_checkpoints (const Ham& hamiltonian,
+                                          const Geometry::PhaseSpaceState<Hamiltonian::degrees_of_freedom_v<Ham>>& s_start,
+                                          const Geometry::Hyperplane<Hamiltonian::degrees_of_freedom_v<Ham>>& cross_line,
+                                          const TimeInterval& integrationTime,
+                                          const IntegrationOptions& options,
+                                          const CheckpointOptions& checkpoint_options)
+    {
+      return Internals::calculate_crossings_with_checkpoints<StepperPolicy>(
+          Dynamics::DynamicSystem{hamiltonian},
+          s_start,
+          Geometry::HyperplaneCrossObserver<Hamiltonian::degrees_of_freedom_v<Ham>>(cross_line),
+          cross_line.perpendicular_vector(),
+          integrationTime,
+          options,
+          checkpoint_options);
+    }
+
+    /// \brief see the overload for lines
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings_with_checkpoints (const Ham& hamiltonian,
+                                          const Geometry::State2& s_start,
+                                          const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                          const TimeInterval& integrationTime,
+                                          const IntegrationOptions& options,
+                                          const CheckpointOptions& checkpoint_options)
+    {
+      return Internals::calculate_crossings_with_checkpoints<StepperPolicy>(Dynamics::DynamicSystem{hamiltonian},
+                                                                            s_start,
+                                                                            periodicQSurfaceCrossObserver,
+                                                                            Geometry::State2{1, 0},
+                                                                            integrationTime,
+                                                                            options,
+                                                                            checkpoint_options);
+    }
+}
+
+#endif //HAMILTONIANS_CHECKPOINT_HPP
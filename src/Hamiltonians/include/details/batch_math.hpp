@@ -0,0 +1,31 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_BATCH_MATH_HPP
+#define HAMILTONIANS_BATCH_MATH_HPP
+
+#include <cstddef>
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        /// \brief the number of states that the batch functions gather into contiguous arrays at a time.
+        /// The kernels always run over whole chunks, so that their trip count is a compile time constant and the
+        /// compiler vectorizes them.
+        constexpr size_t batch_chunk_size = 64;
+
+        /// \brief out[i] = sin(x[i]) for the n elements of x.
+        ///
+        /// Branch free Cephes polynomials after a Cody-Waite reduction by pi/2, written so that the compiler can
+        /// vectorize them. Within 2 ulp of std::sin for |x| < 1e8; larger or non finite arguments, and the arguments
+        /// so close to a multiple of pi/2 that the reduction cancels, are passed to std::sin.
+        void sin_batch (const double* x, double* out, size_t n) noexcept;
+
+        /// \brief out[i] = cos(x[i]) for the n elements of x. See sin_batch.
+        void cos_batch (const double* x, double* out, size_t n) noexcept;
+    }
+}
+
+#endif //HAMILTONIANS_BATCH_MATH_HPP
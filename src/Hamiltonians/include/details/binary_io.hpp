@@ -0,0 +1,80 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_BINARY_IO_HPP
+#define HAMILTONIANS_BINARY_IO_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        // Numbers in the native binary format, for the files that are read back on the same machine (checkpoints,
+        // caches). A read past the end, or of a size larger than what is left of the stream, sets the failbit of the
+        // stream.
+
+        inline void write_u64 (std::ostream& out, std::uint64_t value)
+        {
+          out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        inline void write_double (std::ostream& out, double value)
+        {
+          out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        /// \brief the size, then the values
+        inline void write_doubles (std::ostream& out, const std::vector<double>& values)
+        {
+          write_u64(out, values.size());
+          out.write(reinterpret_cast<const char*>(values.data()),
+                    static_cast<std::streamsize>(values.size() * sizeof(double)));
+        }
+
+        inline std::uint64_t read_u64 (std::istream& in)
+        {
+          std::uint64_t value = 0;
+          in.read(reinterpret_cast<char*>(&value), sizeof(value));
+          return value;
+        }
+
+        inline double read_double (std::istream& in)
+        {
+          double value = 0;
+          in.read(reinterpret_cast<char*>(&value), sizeof(value));
+          return value;
+        }
+
+        /// \brief the values written by write_doubles; the size is checked against the rest of the stream, which must
+        /// be seekable, before anything is allocated
+        inline std::vector<double> read_doubles (std::istream& in)
+        {
+          const auto size = read_u64(in);
+          if (!in)
+            return {};
+
+          const auto position = in.tellg();
+          in.seekg(0, std::ios::end);
+          const auto end = in.tellg();
+          in.seekg(position);
+
+          if (!in || position < 0 || end < position
+              || size > static_cast<std::uint64_t>(end - position) / sizeof(double))
+            {
+              in.setstate(std::ios::failbit);
+              return {};
+            }
+
+          std::vector<double> values(size);
+          in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(size * sizeof(double)));
+          return values;
+        }
+    }
+}
+
+#endif //HAMILTONIANS_BINARY_IO_HPP
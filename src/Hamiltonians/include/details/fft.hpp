@@ -0,0 +1,37 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_FFT_HPP
+#define HAMILTONIANS_FFT_HPP
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        /// \brief An in place radix-2 FFT of a fixed size, with its twiddle factors and bit reversal permutation
+        /// computed once, so that it can be reused over many signals.
+        class FFTPlan {
+          size_t size_;
+          std::vector<size_t> bit_reversed_;
+          std::vector<std::complex<double>> twiddles_;
+         public:
+          /// \param size a power of 2
+          explicit FFTPlan (size_t size);
+
+          size_t size () const noexcept;
+
+          /// \brief data[k] = sum_n data[n] exp(-2 pi i n k / size)
+          void forward (std::complex<double>* data) const noexcept;
+        };
+
+        /// \brief the smallest power of 2 not less than n
+        size_t next_power_of_two (size_t n) noexcept;
+    }
+}
+
+#endif //HAMILTONIANS_FFT_HPP
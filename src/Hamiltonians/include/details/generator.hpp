@@ -0,0 +1,178 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_GENERATOR_HPP
+#define HAMILTONIANS_GENERATOR_HPP
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        /// \brief A single pass range over the values yielded by a coroutine.
+        ///
+        /// The coroutine runs in its own frame, and is resumed by the increments of the iterator; the values are handed
+        /// out by reference to the yielded object, which lives in the frame until the next resumption, so nothing is
+        /// copied. The iterators are plain handles, so begin() and end() are the same type and the range works with
+        /// the boost range algorithms. Exceptions thrown by the coroutine propagate out of the increment.
+        template<typename T>
+        class Generator {
+         public:
+          struct promise_type {
+              const T* value = nullptr;
+              std::exception_ptr exception{};
+
+              Generator get_return_object () noexcept
+              {
+                return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+              }
+
+              std::suspend_always initial_suspend () const noexcept
+              {
+                return {};
+              }
+
+              std::suspend_always final_suspend () const noexcept
+              {
+                return {};
+              }
+
+              std::suspend_always yield_value (const T& yielded) noexcept
+              {
+                value = std::addressof(yielded);
+                return {};
+              }
+
+              void return_void () const noexcept
+              { }
+
+              void unhandled_exception () noexcept
+              {
+                exception = std::current_exception();
+              }
+          };
+
+          using handle_type = std::coroutine_handle<promise_type>;
+
+          class iterator {
+            handle_type handle_{};
+
+            void resume ()
+            {
+              handle_.resume();
+              if (handle_.promise().exception)
+                std::rethrow_exception(std::exchange(handle_.promise().exception, nullptr));
+            }
+
+           public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator () noexcept = default;
+
+            /// \brief the begin iterator resumes the coroutine up to its first value
+            explicit iterator (handle_type handle)
+                : handle_{handle}
+            {
+              if (handle_ && !handle_.done())
+                resume();
+            }
+
+            reference operator* () const noexcept
+            {
+              return *handle_.promise().value;
+            }
+
+            pointer operator-> () const noexcept
+            {
+              return handle_.promise().value;
+            }
+
+            iterator& operator++ ()
+            {
+              resume();
+              return *this;
+            }
+
+            void operator++ (int)
+            {
+              ++*this;
+            }
+
+            /// \brief all the iterators of a finished coroutine are equal to end()
+            friend bool operator== (const iterator& a, const iterator& b) noexcept
+            {
+              const auto a_done = !a.handle_ || a.handle_.done();
+              const auto b_done = !b.handle_ || b.handle_.done();
+              return a_done || b_done ? a_done == b_done : a.handle_ == b.handle_;
+            }
+
+            friend bool operator!= (const iterator& a, const iterator& b) noexcept
+            {
+              return !(a == b);
+            }
+          };
+
+          using const_iterator = iterator;
+
+         private:
+          handle_type handle_{};
+
+          explicit Generator (handle_type handle) noexcept
+              : handle_{handle}
+          { }
+
+         public:
+          Generator (const Generator&) = delete;
+          Generator& operator= (const Generator&) = delete;
+
+          Generator (Generator&& other) noexcept
+              : handle_{std::exchange(other.handle_, nullptr)}
+          { }
+
+          Generator& operator= (Generator&& other) noexcept
+          {
+            if (this != &other)
+              {
+                if (handle_)
+                  handle_.destroy();
+                handle_ = std::exchange(other.handle_, nullptr);
+              }
+            return *this;
+          }
+
+          ~Generator ()
+          {
+            if (handle_)
+              handle_.destroy();
+          }
+
+          /// \brief starts the coroutine; a Generator can be iterated only once
+          iterator begin () const
+          {
+            return iterator{handle_};
+          }
+
+          iterator end () const noexcept
+          {
+            return iterator{};
+          }
+        };
+    }
+}
+
+#endif // __cpp_impl_coroutine
+
+#endif //HAMILTONIANS_GENERATOR_HPP
@@ -0,0 +1,81 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_PARALLEL_FOR_HPP
+#define HAMILTONIANS_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        /// \brief the number of threads to use, if the caller asked for 0
+        inline unsigned default_number_of_threads () noexcept
+        {
+          return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        /// \brief Calls f(i) for i in [0, n), on up to number_of_threads threads (0 for one per core).
+        ///
+        /// The threads take the next index from a shared counter, so uneven work items are balanced. The first
+        /// exception thrown by f is rethrown after all threads have joined.
+        template<typename F>
+        void parallel_for (size_t n, unsigned number_of_threads, F f)
+        {
+          if (number_of_threads == 0)
+            number_of_threads = default_number_of_threads();
+
+          const auto number_of_workers = std::min<size_t>(number_of_threads, n);
+
+          if (number_of_workers <= 1)
+            {
+              for (size_t i = 0; i < n; ++i)
+                f(i);
+              return;
+            }
+
+          std::atomic<size_t> next{0};
+          std::exception_ptr error{};
+          std::mutex error_mutex{};
+
+          auto worker = [&] ()
+          {
+              try
+                {
+                  for (auto i = next++; i < n; i = next++)
+                    f(i);
+                }
+              catch (...)
+                {
+                  std::lock_guard<std::mutex> lock{error_mutex};
+                  if (!error)
+                    error = std::current_exception();
+                  next = n;
+                }
+          };
+
+          std::vector<std::thread> workers{};
+          workers.reserve(number_of_workers - 1);
+          for (size_t i = 1; i < number_of_workers; ++i)
+            workers.emplace_back(worker);
+
+          worker();
+
+          for (auto& w: workers)
+            w.join();
+
+          if (error)
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif //HAMILTONIANS_PARALLEL_FOR_HPP
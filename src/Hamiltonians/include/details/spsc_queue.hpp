@@ -0,0 +1,105 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_SPSC_QUEUE_HPP
+#define HAMILTONIANS_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        /// \brief A bounded, lock free queue for exactly one producer thread and one consumer thread.
+        ///
+        /// The elements live in a ring buffer allocated at construction. Each side owns one index and only reads the
+        /// other one, with acquire/release ordering, and keeps a cached copy of it so that it touches the other side's
+        /// cache line only when the queue looks full (producer) or empty (consumer).
+        template<typename T>
+        class SpscQueue {
+          static constexpr size_t cache_line = 64;
+
+          std::vector<T> buffer_;
+          size_t mask_;
+
+          alignas(cache_line) std::atomic<size_t> head_{0}; // the next element to pop, written by the consumer
+          size_t cached_tail_ = 0;
+
+          alignas(cache_line) std::atomic<size_t> tail_{0}; // the next free slot, written by the producer
+          size_t cached_head_ = 0;
+
+          static size_t round_up_to_power_of_two (size_t n)
+          {
+            size_t power = 1;
+            while (power < n)
+              power <<= 1u;
+            return power;
+          }
+
+         public:
+          /// \param capacity rounded up to a power of two
+          explicit SpscQueue (size_t capacity)
+              : buffer_(round_up_to_power_of_two(capacity)),
+                mask_{buffer_.size() - 1}
+          {
+            if (capacity == 0)
+              throw std::invalid_argument("SpscQueue: the capacity must be positive");
+          }
+
+          SpscQueue (const SpscQueue&) = delete;
+          SpscQueue& operator= (const SpscQueue&) = delete;
+
+          size_t capacity () const noexcept
+          {
+            return buffer_.size();
+          }
+
+          /// \brief producer side
+          /// \return false if the queue is full
+          bool try_push (const T& value) noexcept(std::is_nothrow_copy_assignable_v<T>)
+          {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cached_head_ == buffer_.size())
+              {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail - cached_head_ == buffer_.size())
+                  return false;
+              }
+
+            buffer_[tail & mask_] = value;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+          }
+
+          /// \brief consumer side
+          bool empty () const noexcept
+          {
+            return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+          }
+
+          /// \brief consumer side
+          /// \return false if the queue is empty
+          bool try_pop (T& value) noexcept(std::is_nothrow_copy_assignable_v<T>)
+          {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head == cached_tail_)
+              {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (head == cached_tail_)
+                  return false;
+              }
+
+            value = buffer_[head & mask_];
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+          }
+        };
+    }
+}
+
+#endif //HAMILTONIANS_SPSC_QUEUE_HPP
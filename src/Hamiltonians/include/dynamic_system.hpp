@@ -14,32 +14,42 @@ namespace Integrators
 
         /// \brief dynamic_system_impl implements the dynamic system generated by the Hamiltonian Ham
         /// \tparam Ham the Hamiltonian generating the dynamic system
-        /// \param direction the direction along which the normalization takes place
+        /// \tparam DOF the number of degrees of freedom
         /// \param s the phase space position
-        /// \param dsdt the time derivatives are returned in this parameter
-        template<typename Ham>
-        inline Geometry::State2 dynamic_system_impl (const Ham& ham, const Geometry::State2& s)
+        /// \return the time derivatives dq_i/dt = dH/dp_i, dp_i/dt = -dH/dq_i
+        template<typename Ham, unsigned DOF>
+        inline Geometry::PhaseSpaceState<DOF> dynamic_system_impl (const Ham& ham,
+                                                                  const Geometry::PhaseSpaceState<DOF>& s)
         {
           const auto dHds = ham.derivative(s);
-          return Geometry::State2{dHds.p(), -dHds.q()};
+
+          Geometry::PhaseSpaceState<DOF> dsdt{};
+          for (unsigned i = 0; i < DOF; ++i)
+            {
+              dsdt.q(i) = dHds.p(i);
+              dsdt.p(i) = -dHds.q(i);
+            }
+          return dsdt;
         }
 
         /// \brief dynamic_system_Action implements the dynamic system generated by the Hamiltonian Ham, returning also the
-        /// derivative of the Action along the orbit.
+        /// derivative of the Action along the orbit, dJ/dt = sum p_i dq_i/dt.
         /// \tparam Ham the Hamiltonian generating the dynamic system
-        /// \param direction the direction along which the normalization takes place
+        /// \tparam DOF the number of degrees of freedom
         /// \param s the phase space position
-        /// \param dsdt the time derivatives are returned in this parameter
-        template<typename Ham>
-        inline Geometry::State2_Action dynamic_system_Action_impl (const Ham& ham, const Geometry::State2_Action& s)
+        template<typename Ham, unsigned DOF>
+        inline Geometry::ActionState<DOF> dynamic_system_Action_impl (const Ham& ham,
+                                                                     const Geometry::ActionState<DOF>& s)
         {
-          const auto s_recuced = Geometry::State2{s.q(),s.p()};
+          const auto s_recuced = Geometry::PhaseSpaceState<DOF>{s};
 
           const auto dzdt = dynamic_system_impl(ham, s_recuced);
 
-          const auto dJdt = s.p()*dzdt.q();
+          double dJdt = 0;
+          for (unsigned i = 0; i < DOF; ++i)
+            dJdt += s.p(i) * dzdt.q(i);
 
-          Geometry::State2_Action ret{dzdt};
+          Geometry::ActionState<DOF> ret{dzdt};
           ret.J()=dJdt;
 
           return ret;
@@ -50,6 +60,7 @@ namespace Integrators
         /// \brief system_along_direction  normalizes the dynamic system generated by the Hamiltonian Ham so that the  normalized
         /// derivative of the quantity s' = s*direction is equal to 1.
         /// \tparam Ham the Hamiltonian type
+        /// \tparam DOF the number of degrees of freedom
         /// \param ham the hamiltonian
         /// \param direction the direction along which the normalization takes place
         /// \param s the phase space position
@@ -58,16 +69,16 @@ namespace Integrators
         /// It is assumed that direction is not perpendicular to the dynamics flow. No check is carried out for this.
         /// Otherwise, division by zero takes place. Typically direction is chosen as the vector perpendicular to a
         /// Poincare cut in phase space.
-        template<typename Ham>
-        inline Geometry::State2_Extended dynamic_system_along_direction_impl (const Ham& ham,
-                                                                              const Geometry::State2& direction,
-                                                                              const Geometry::State2_Action& s)
+        template<typename Ham, unsigned DOF>
+        inline Geometry::ExtendedState<DOF> dynamic_system_along_direction_impl (const Ham& ham,
+                                                                                const Geometry::PhaseSpaceState<DOF>& direction,
+                                                                                const Geometry::ActionState<DOF>& s)
         {
-          const Geometry::State2_Action dsdt_Action = dynamic_system_Action_impl(ham, s);
+          const Geometry::ActionState<DOF> dsdt_Action = dynamic_system_Action_impl(ham, s);
 
-          const double  deriv_along_direction = Geometry::State2{dsdt_Action}*direction;
+          const double  deriv_along_direction = Geometry::PhaseSpaceState<DOF>{dsdt_Action}*direction;
 
-          Geometry::State2_Extended unnormalized_derivs{dsdt_Action};
+          Geometry::ExtendedState<DOF> unnormalized_derivs{dsdt_Action};
           unnormalized_derivs.t()=1;
 
           return unnormalized_derivs/deriv_along_direction;
@@ -76,27 +87,42 @@ namespace Integrators
 
 
 
+        /// \brief The dynamic system generated by Ham, on the phase space of Hamiltonian::degrees_of_freedom_v<Ham>
+        /// degrees of freedom
         template <typename Ham>
         class DynamicSystem
         {
           Ham ham_;
          public:
+          using hamiltonian_type = Ham;
+
+          static constexpr unsigned degrees_of_freedom = Hamiltonian::degrees_of_freedom_v<Ham>;
+
+          using state_type = Geometry::PhaseSpaceState<degrees_of_freedom>;
+          using action_state_type = Geometry::ActionState<degrees_of_freedom>;
+          using extended_state_type = Geometry::ExtendedState<degrees_of_freedom>;
+
           explicit DynamicSystem (Ham ham)
               : ham_(ham)
           {
           }
 
-          Geometry::State2 dynamic_system ( const Geometry::State2& s) const noexcept
+          const Ham& hamiltonian () const noexcept
+          {
+            return ham_;
+          }
+
+          state_type dynamic_system ( const state_type& s) const noexcept
           {
             return dynamic_system_impl(ham_,s);
           }
-          Geometry::State2_Action dynamic_system_Action (const Geometry::State2_Action& s) const noexcept
+          action_state_type dynamic_system_Action (const action_state_type& s) const noexcept
           {
             return dynamic_system_Action_impl(ham_,s);
           }
 
-          Geometry::State2_Extended dynamic_system_along_direction (const Geometry::State2& direction,
-                                                                    const Geometry::State2_Action& s) const noexcept
+          extended_state_type dynamic_system_along_direction (const state_type& direction,
+                                                              const action_state_type& s) const noexcept
           {
             return dynamic_system_along_direction_impl(ham_,direction, s);
           }
@@ -106,6 +132,7 @@ namespace Integrators
 
         extern template class DynamicSystem<Hamiltonian::HarmonicOscillator>;
         extern template class DynamicSystem<Hamiltonian::DuffingHamiltonian>;
+        extern template class DynamicSystem<Hamiltonian::HenonHeilesHamiltonian>;
     }
 }
 
@@ -0,0 +1,154 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_ENERGY_CONTOURS_HPP
+#define HAMILTONIANS_ENERGY_CONTOURS_HPP
+
+#include <vector>
+
+#include "State.hpp"
+#include "Hamiltonian.hpp"
+#include "details/parallel_for.hpp"
+
+namespace Integrators
+{
+    /// \brief A rectangular raster of n_q x n_p nodes over [q_min, q_max] x [p_min, p_max]
+    class PhaseSpaceGrid {
+      double q_min_;
+      double q_max_;
+      double p_min_;
+      double p_max_;
+      size_t n_q_;
+      size_t n_p_;
+     public:
+      PhaseSpaceGrid (double q_min, double q_max, size_t n_q, double p_min, double p_max, size_t n_p);
+
+      size_t n_q () const noexcept;
+      size_t n_p () const noexcept;
+      double q (size_t i_q) const noexcept;
+      double p (size_t i_p) const noexcept;
+    };
+
+    /// \brief The values of a Hamiltonian on the nodes of a PhaseSpaceGrid
+    class EnergyRaster {
+      PhaseSpaceGrid grid_;
+      std::vector<double> values_; // row major, one row per p
+     public:
+      EnergyRaster (PhaseSpaceGrid grid, std::vector<double> values);
+
+      const PhaseSpaceGrid& grid () const noexcept;
+
+      double value (size_t i_q, size_t i_p) const noexcept
+      {
+        return values_[i_p * grid_.n_q() + i_q];
+      }
+
+      const std::vector<double>& values () const noexcept;
+    };
+
+    /// \brief A level set of the Hamiltonian, as a polyline through the points where it crosses the grid lines
+    struct EnergyContour {
+        double energy = 0;
+        std::vector<Geometry::State2> points{};
+        /// \brief false if the contour leaves the grid
+        bool closed = false;
+
+        /// \brief the area enclosed by a closed contour (Green's theorem, i.e. the shoelace formula). NaN if the
+        /// contour is open.
+        double enclosed_area () const noexcept;
+
+        /// \brief enclosed_area() / 2pi, the approximate action of the orbit on the contour
+        double action () const noexcept;
+    };
+
+    /// \brief Evaluates the Hamiltonian on the grid, in tiles of rows that are processed in parallel with
+    /// Hamiltonian::value_batch.
+    /// \param number_of_threads 0 for one per core
+    template<typename Ham>
+    EnergyRaster evaluate_on_grid (const Ham& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads = 0,
+                                   size_t rows_per_tile = 16)
+    {
+      const auto n_q = grid.n_q();
+      const auto n_p = grid.n_p();
+      const auto number_of_tiles = (n_p + rows_per_tile - 1) / rows_per_tile;
+
+      std::vector<double> values(n_q * n_p);
+
+      Internals::parallel_for(number_of_tiles, number_of_threads, [&] (size_t tile)
+      {
+          const auto first_row = tile * rows_per_tile;
+          const auto last_row = std::min(first_row + rows_per_tile, n_p);
+
+          std::vector<Geometry::State2> states{};
+          states.reserve((last_row - first_row) * n_q);
+
+          for (auto i_p = first_row; i_p < last_row; ++i_p)
+            for (size_t i_q = 0; i_q < n_q; ++i_q)
+              states.push_back(Geometry::State2{grid.q(i_q), grid.p(i_p)});
+
+          Hamiltonian::value_batch(hamiltonian,
+                                   Span<const Geometry::State2>{states},
+                                   Span<double>{values.data() + first_row * n_q, states.size()});
+      });
+
+      return EnergyRaster{grid, std::move(values)};
+    }
+
+    /// \brief Extracts the level sets of energy from the raster with marching squares.
+    ///
+    /// Saddle cells are resolved with the mean of their four corners.
+    std::vector<EnergyContour> extract_contours (const EnergyRaster& raster, double energy);
+
+    /// \brief Extracts the level sets of all energies, one energy per task, in parallel.
+    /// \param number_of_threads 0 for one per core
+    std::vector<std::vector<EnergyContour>> extract_contours (const EnergyRaster& raster,
+                                                              const std::vector<double>& energies,
+                                                              unsigned number_of_threads = 0);
+
+    /// \brief The whole phase portrait in one pass: evaluates the Hamiltonian on the grid and extracts the level sets of
+    /// all energies. Returns one vector of contours per energy.
+    template<typename Ham>
+    std::vector<std::vector<EnergyContour>> calculate_energy_contours (const Ham& hamiltonian,
+                                                                       const PhaseSpaceGrid& grid,
+                                                                       const std::vector<double>& energies,
+                                                                       unsigned number_of_threads = 0)
+    {
+      const auto raster = evaluate_on_grid(hamiltonian, grid, number_of_threads);
+      return extract_contours(raster, energies, number_of_threads);
+    }
+
+    extern template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    extern template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    extern template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    extern template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::FreeParticle& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    extern template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+}
+
+#endif //HAMILTONIANS_ENERGY_CONTOURS_HPP
@@ -0,0 +1,210 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_ENERGY_PROJECTION_HPP
+#define HAMILTONIANS_ENERGY_PROJECTION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <boost/numeric/odeint.hpp>
+
+#include "State.hpp"
+
+namespace Integrators
+{
+
+    /// \brief Projects s onto the level set H = energy by Newton corrections along the gradient of H.
+    /// \tparam Ham the Hamiltonian type
+    /// \tparam DOF the number of degrees of freedom
+    /// \param max_iterations the maximum number of Newton corrections
+    template<typename Ham, unsigned DOF>
+    Geometry::PhaseSpaceState<DOF> project_on_energy_level (const Ham& hamiltonian,
+                                                            Geometry::PhaseSpaceState<DOF> s,
+                                                            double energy,
+                                                            size_t max_iterations = 3) noexcept
+    {
+      const double tolerance = 4 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(energy));
+
+      for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+        {
+          const double energy_error = hamiltonian.value(s) - energy;
+
+          if (std::abs(energy_error) <= tolerance)
+            break;
+
+          const auto gradient = hamiltonian.derivative(s);
+          const double gradient_magnitude_squared = magnitude_squared(gradient);
+
+          if (gradient_magnitude_squared == 0)
+            break;
+
+          s -= gradient * (energy_error / gradient_magnitude_squared);
+        }
+
+      return s;
+    }
+
+    /// \brief Decides when the state of an integration is projected back onto its initial energy level.
+    ///
+    /// A projection takes place every `every` accepted steps, or whenever the energy has drifted by more than
+    /// `drift_threshold`. Setting both to zero disables the projection.
+    template<typename DS>
+    class EnergyProjection {
+      using state_type = typename DS::state_type;
+
+      DS system_;
+      double energy_;
+      size_t every_;
+      double drift_threshold_;
+      size_t steps_since_projection_ = 0;
+
+      bool due (const state_type& s) const noexcept
+      {
+        if (every_ && steps_since_projection_ >= every_)
+          return true;
+
+        return drift_threshold_ > 0 && std::abs(system_.hamiltonian().value(s) - energy_) > drift_threshold_;
+      }
+
+     public:
+      EnergyProjection (DS system, const state_type& s_start, size_t every, double drift_threshold)
+          : system_{std::move(system)},
+            energy_{system_.hamiltonian().value(s_start)},
+            every_{every},
+            drift_threshold_{drift_threshold}
+      { }
+
+      bool enabled () const noexcept
+      {
+        return every_ || drift_threshold_ > 0;
+      }
+
+      double energy () const noexcept
+      {
+        return energy_;
+      }
+
+      /// \brief starts over on the energy level of s_start
+      void reset (const state_type& s_start) noexcept
+      {
+        energy_ = system_.hamiltonian().value(s_start);
+        steps_since_projection_ = 0;
+      }
+
+      /// \brief the accepted steps since the last projection, the only state carried from step to step
+      size_t steps_since_projection () const noexcept
+      {
+        return steps_since_projection_;
+      }
+
+      /// \brief like reset, but resumes an integration in which steps_since_projection steps were accepted since the
+      /// last projection
+      void restore (const state_type& s_start, size_t steps_since_projection) noexcept
+      {
+        reset(s_start);
+        steps_since_projection_ = steps_since_projection;
+      }
+
+      /// \brief to be called after every accepted step
+      /// \return true if s has been projected
+      template<unsigned N>
+      bool operator() (Geometry::State<N, DS::degrees_of_freedom>& s) noexcept
+      {
+        ++steps_since_projection_;
+
+        const state_type s_reduced{s};
+
+        if (!due(s_reduced))
+          return false;
+
+        const auto s_projected = project_on_energy_level(system_.hamiltonian(), s_reduced, energy_);
+        for (unsigned i = 0; i < state_type::dimension; ++i)
+          s[i] = s_projected[i];
+
+        steps_since_projection_ = 0;
+        return true;
+      }
+    };
+
+    namespace Internals
+    {
+        template<typename Stepper, typename = void>
+        struct has_reset: std::false_type {
+        };
+
+        template<typename Stepper>
+        struct has_reset<Stepper, std::void_t<decltype(std::declval<Stepper&>().reset())> >: std::true_type {
+        };
+    }
+
+    /// \brief A controlled stepper that forwards to ControlledStepper and applies an EnergyProjection after every
+    /// accepted step. It can be used wherever odeint expects a controlled stepper, e.g. in the integration ranges.
+    template<typename ControlledStepper, typename DS>
+    class EnergyProjectingStepper {
+      ControlledStepper stepper_;
+      EnergyProjection<DS> projection_;
+
+      using inner_category = typename ControlledStepper::stepper_category;
+     public:
+      using state_type = typename ControlledStepper::state_type;
+      using deriv_type = typename ControlledStepper::deriv_type;
+      using value_type = typename ControlledStepper::value_type;
+      using time_type = typename ControlledStepper::time_type;
+      using stepper_category = boost::numeric::odeint::controlled_stepper_tag;
+
+      EnergyProjectingStepper (ControlledStepper stepper, EnergyProjection<DS> projection)
+          : stepper_{std::move(stepper)}, projection_{std::move(projection)}
+      { }
+
+      template<typename System>
+      boost::numeric::odeint::controlled_step_result
+      try_step (System system, state_type& x, time_type& t, time_type& dt)
+      {
+        const auto result = stepper_.try_step(system, x, t, dt);
+
+        if (result == boost::numeric::odeint::success && projection_.enabled() && projection_(x))
+          {
+            // first same as last steppers have cached the derivative at the unprojected state
+            if constexpr (std::is_base_of_v<boost::numeric::odeint::explicit_controlled_stepper_fsal_tag,
+                                            inner_category>)
+              stepper_.reset();
+          }
+
+        return result;
+      }
+
+      /// \brief prepares the stepper for a new orbit starting at s_start: the steppers that carry information from
+      /// step to step (first same as last derivatives, extrapolation orders) start afresh, and the energy level is
+      /// the one of s_start. The internal buffers are kept.
+      void reset (const typename DS::state_type& s_start) noexcept
+      {
+        if constexpr (Internals::has_reset<ControlledStepper>::value)
+          stepper_.reset();
+        projection_.reset(s_start);
+      }
+
+      const EnergyProjection<DS>& projection () const noexcept
+      {
+        return projection_;
+      }
+
+      /// \brief like reset, but resumes an integration from a checkpoint, see EnergyProjection::restore
+      void restore (const typename DS::state_type& s_start, size_t steps_since_projection) noexcept
+      {
+        reset(s_start);
+        projection_.restore(s_start, steps_since_projection);
+      }
+    };
+
+    template<typename ControlledStepper, typename DS>
+    EnergyProjectingStepper<ControlledStepper, DS>
+    make_energy_projecting_stepper (ControlledStepper stepper, EnergyProjection<DS> projection)
+    {
+      return EnergyProjectingStepper<ControlledStepper, DS>{std::move(stepper), std::move(projection)};
+    }
+}
+#endif //HAMILTONIANS_ENERGY_PROJECTION_HPP
@@ -0,0 +1,186 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_EXACT_FLOW_HPP
+#define HAMILTONIANS_EXACT_FLOW_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/irange.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include "State.hpp"
+#include "Hamiltonian.hpp"
+#include "IntegrationTimeInterval.hpp"
+
+namespace Integrators
+{
+    /// \brief Propagates s by dt with the exact flow of the Hamiltonian of system
+    template<typename DS>
+    Geometry::State2_Action exact_flow (const DS& system, const Geometry::State2_Action& s, double dt) noexcept
+    {
+      return system.hamiltonian().flow(s, dt);
+    }
+
+    /// \brief The exact counterpart of step_back. Follows the flow from s until s*direction has changed by -distance.
+    ///
+    /// The time of flight is found by Newton iterations, starting from the linear estimate that step_back integrates.
+    /// The iterations are kept within a bracket of the crossing behind s, and bisect it whenever a Newton step would
+    /// leave it, e.g. near a tangential crossing, where the speed across the surface vanishes.
+    /// \throws std::runtime_error if no crossing is found behind s, or if the time of flight does not converge
+    template<typename DS>
+    Geometry::State2_Extended exact_step_back (const DS& system,
+                                               const Geometry::State2 direction,
+                                               const Geometry::State2_Action& s,
+                                               double t,
+                                               double distance)
+    {
+      constexpr int max_iterations = 200;
+      constexpr int max_bracket_expansions = 64;
+      constexpr double eps = std::numeric_limits<double>::epsilon();
+
+      const double target = Geometry::State2{s} * direction - distance;
+
+      auto extended = [t] (const Geometry::State2_Action& s_out, double dt)
+      {
+          auto s_extended = Geometry::State2_Extended{s_out};
+          s_extended.t() = t + dt;
+          return s_extended;
+      };
+
+      auto distance_after = [&system, &s, &direction, target] (double dt)
+      {
+          return Geometry::State2{exact_flow(system, s, dt)} * direction - target;
+      };
+
+      if (distance == 0)
+        return extended(s, 0);
+
+      // the crossing lies in [dt_low, dt_high], where the distance changes sign; the distance at dt_high == 0 is
+      // distance
+      double dt_high = 0;
+      double dt_low = -distance / (system.dynamic_system(Geometry::State2{s}) * direction);
+      if (!(std::isfinite(dt_low) && dt_low < 0))
+        {
+          dt_low = -std::abs(distance) / magnitude(system.dynamic_system(Geometry::State2{s}));
+          if (!(std::isfinite(dt_low) && dt_low < 0))
+            throw std::runtime_error("exact_step_back: no crossing behind a fixed point");
+        }
+
+      double distance_low = distance_after(dt_low);
+      for (int i = 0; distance_low != 0 && (distance_low < 0) == (distance < 0); ++i)
+        {
+          if (i == max_bracket_expansions)
+            throw std::runtime_error("exact_step_back: no crossing found behind s");
+
+          dt_high = dt_low;
+          dt_low *= 2;
+          distance_low = distance_after(dt_low);
+        }
+
+      const bool negative_low = distance_low < 0;
+      double dt = dt_low;
+
+      for (int i = 0; i < max_iterations; ++i)
+        {
+          const auto s_out = exact_flow(system, s, dt);
+          const auto s_out_reduced = Geometry::State2{s_out};
+          const double value = s_out_reduced * direction - target;
+
+          if (value == 0)
+            return extended(s_out, dt);
+
+          if ((value < 0) == negative_low)
+            dt_low = dt;
+          else
+            dt_high = dt;
+
+          auto next = dt - value / (system.dynamic_system(s_out_reduced) * direction);
+          if (!(std::isfinite(next) && next > dt_low && next < dt_high))
+            next = 0.5 * (dt_low + dt_high);
+
+          const auto tolerance = 4 * eps * std::max(1.0, std::abs(next));
+          if (std::abs(next - dt) <= tolerance || dt_high - dt_low <= tolerance)
+            return extended(exact_flow(system, s, next), next);
+
+          dt = next;
+        }
+
+      throw std::runtime_error("exact_step_back: the time of flight did not converge");
+    }
+
+    /// \brief The time between the samples of an exact flow.
+    ///
+    /// The crossings are located exactly by exact_step_back, but only between samples on opposite sides of a surface:
+    /// the crossing times are not computed from the flow, so a pair of crossings closer in time than the step, e.g. of
+    /// a surface nearly tangent to the orbit, goes unnoticed, as it does with the steppers. The step is bounded by
+    /// dt_max, if given, and by the time the flow needs to move s_start by max_displacement.
+    template<typename DS>
+    double exact_flow_sampling_step (const DS& system,
+                                     const Geometry::State2& s_start,
+                                     const TimeInterval& integrationTime,
+                                     double sampling_step,
+                                     double max_displacement = 0.5)
+    {
+      const auto& dt_max = integrationTime.dt_max();
+      if (dt_max)
+        sampling_step = std::min(sampling_step, dt_max.value());
+
+      const auto speed = magnitude(system.dynamic_system(s_start));
+      if (speed > 0)
+        sampling_step = std::min(sampling_step, max_displacement / speed);
+
+      return sampling_step;
+    }
+
+    /// \brief Samples the orbit of s_start at t_begin, t_begin + sampling_step, ..., t_end, using the exact flow.
+    ///
+    /// A drop in replacement of make_dynamic_system_integration_range: it yields (State2_Action, time) pairs, so the
+    /// same observers apply. Every sample is propagated from s_start, so no error accumulates along the orbit.
+    template<typename DS>
+    inline auto make_exact_flow_range (DS system,
+                                       const Geometry::State2_Action& s_start,
+                                       const TimeInterval& integrationTime,
+                                       double sampling_step)
+    {
+      const auto t_begin = integrationTime.t_begin();
+      const auto t_end = integrationTime.t_end();
+
+      const auto number_of_steps = static_cast<long>(std::ceil((t_end - t_begin) / sampling_step));
+
+      return boost::make_iterator_range(
+          boost::irange(0L, std::max(number_of_steps, 0L) + 1)
+          | boost::adaptors::transformed(
+              [sys = std::move(system), s_start, t_begin, t_end, sampling_step] (long k)
+              {
+                  const auto t = std::min(t_begin + static_cast<double>(k) * sampling_step, t_end);
+                  return std::make_pair(exact_flow(sys, s_start, t - t_begin), t);
+              }));
+    }
+
+    /// \brief The exact flow counterpart of make_interval_range: yields the orbit of s_start at times, where s_start
+    /// is the position at times.front().
+    template<typename DS, typename StateType>
+    inline auto make_exact_flow_interval_range (DS system,
+                                                const StateType& s_start,
+                                                const std::vector<double>& times)
+    {
+      const auto t_begin = times.empty() ? 0.0 : times.front();
+
+      return boost::make_iterator_range(
+          times | boost::adaptors::transformed(
+              [sys = std::move(system), s_start = Geometry::State2_Action{s_start}, t_begin] (double t)
+              {
+                  return std::make_pair(StateType{exact_flow(sys, s_start, t - t_begin)}, t);
+              }));
+    }
+}
+
+#endif //HAMILTONIANS_EXACT_FLOW_HPP
@@ -0,0 +1,165 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_FREQUENCY_ANALYSIS_HPP
+#define HAMILTONIANS_FREQUENCY_ANALYSIS_HPP
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include "State.hpp"
+#include "Hamiltonian.hpp"
+#include "Integration.hpp"
+#include "span.hpp"
+#include "details/fft.hpp"
+#include "details/parallel_for.hpp"
+
+namespace Integrators
+{
+    /// \brief A term a * exp(i omega t) of a quasi-periodic signal
+    struct FrequencyComponent {
+        /// \brief the angular frequency
+        double frequency = 0;
+        /// \brief the complex amplitude, with the phase at the first sample
+        std::complex<double> amplitude{};
+    };
+
+    /// \brief Samples the orbit starting at s_start at the given times, as z = q - i p, into samples.
+    ///
+    /// With this sign an orbit running clockwise in the (q, p) plane, as all the orbits of H = p^2/2m + V(q) do, has a
+    /// positive frequency.
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    void sample_orbit (const Ham& hamiltonian,
+                       Geometry::State2 s_start,
+                       const std::vector<double>& times,
+                       const IntegrationOptions& options,
+                       Span<std::complex<double>> samples)
+    {
+      auto orbit_range = make_interval_range<StepperPolicy>(Dynamics::DynamicSystem<Ham>{hamiltonian},
+                                                            s_start,
+                                                            times,
+                                                            options);
+      size_t n = 0;
+      for (const auto& p: orbit_range)
+        {
+          const Geometry::State2 s{p.first};
+          samples[n++] = std::complex<double>{s.q(), -s.p()};
+        }
+    }
+
+    /// \brief Numerical analysis of the fundamental frequencies (NAFF) of signals of a fixed length.
+    ///
+    /// The strongest peak of the Hann windowed spectrum is refined with Brent's method on the windowed correlation
+    /// |<f, exp(i omega t)>|, its amplitude is projected out of the signal, and the process is repeated for the next
+    /// frequency. Finally every term is refined once more with all the others projected out. The FFT plan and all
+    /// buffers are allocated once, so that one analyzer can be reused over many orbits.
+    class FrequencyAnalyzer {
+      size_t number_of_samples_;
+      double time_step_;
+      size_t number_of_frequencies_;
+      Internals::FFTPlan plan_;
+      std::vector<double> times_;
+      std::vector<double> window_;
+      std::vector<std::complex<double>> samples_;
+      std::vector<std::complex<double>> residual_;
+      std::vector<std::complex<double>> spectrum_;
+
+      /// \brief the windowed correlation of the residual with exp(i omega t)
+      std::complex<double> correlation (double omega) const noexcept;
+      /// \brief the derivative of |correlation(omega)|^2
+      double power_slope (double omega) const noexcept;
+      /// \brief the maximum of |correlation|^2 within half_width of omega
+      double refine (double omega, double half_width) const;
+      /// \brief adds sign * the term to the residual
+      void add_to_residual (const FrequencyComponent& component, double sign) noexcept;
+
+     public:
+      /// \param number_of_samples the length of the signals, sampled at t = 0, time_step, 2 time_step, ...
+      /// \param number_of_frequencies the number of terms to extract from every signal
+      FrequencyAnalyzer (size_t number_of_samples, double time_step, size_t number_of_frequencies = 1);
+
+      size_t number_of_samples () const noexcept;
+      double time_step () const noexcept;
+      size_t number_of_frequencies () const noexcept;
+
+      /// \brief the terms of signal, in the order they were extracted, i.e. strongest first
+      std::vector<FrequencyComponent> analyze (Span<const std::complex<double>> signal);
+
+      /// \brief samples the orbit starting at s_start (see sample_orbit) into the internal buffer, and analyzes it
+      template<typename StepperPolicy = Steppers::Default, typename Ham>
+      std::vector<FrequencyComponent> analyze_orbit (const Ham& hamiltonian,
+                                                     const Geometry::State2& s_start,
+                                                     const IntegrationOptions& options)
+      {
+        sample_orbit<StepperPolicy>(hamiltonian, s_start, times_, options, Span<std::complex<double>>{samples_});
+        return analyze(Span<const std::complex<double>>{samples_});
+      }
+    };
+
+    /// \brief The frequency map of the seeds: the terms of the orbit starting at every seed.
+    ///
+    /// The seeds are split into one contiguous block per thread, and every block reuses a single FrequencyAnalyzer.
+    /// \param number_of_threads 0 for one per core
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    std::vector<std::vector<FrequencyComponent>> calculate_frequency_map (const Ham& hamiltonian,
+                                                                          const std::vector<Geometry::State2>& seeds,
+                                                                          size_t number_of_samples,
+                                                                          double time_step,
+                                                                          const IntegrationOptions& options,
+                                                                          size_t number_of_frequencies = 1,
+                                                                          unsigned number_of_threads = 0)
+    {
+      if (number_of_threads == 0)
+        number_of_threads = Internals::default_number_of_threads();
+
+      const auto number_of_blocks = std::max<size_t>(1, std::min<size_t>(number_of_threads, seeds.size()));
+      const auto block_size = (seeds.size() + number_of_blocks - 1) / number_of_blocks;
+
+      std::vector<std::vector<FrequencyComponent>> frequencies(seeds.size());
+
+      Internals::parallel_for(number_of_blocks, number_of_threads, [&] (size_t block)
+      {
+          FrequencyAnalyzer analyzer{number_of_samples, time_step, number_of_frequencies};
+
+          const auto last = std::min(seeds.size(), (block + 1) * block_size);
+          for (auto i = block * block_size; i < last; ++i)
+            frequencies[i] = analyzer.analyze_orbit<StepperPolicy>(hamiltonian, seeds[i], options);
+      });
+
+      return frequencies;
+    }
+
+    extern template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    extern template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    extern template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    extern template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    extern template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+}
+
+#endif //HAMILTONIANS_FREQUENCY_ANALYSIS_HPP
@@ -0,0 +1,390 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_INTEGRATION_SESSION_HPP
+#define HAMILTONIANS_INTEGRATION_SESSION_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+#include <boost/range/algorithm/for_each.hpp>
+#include <boost/ref.hpp>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "reversing_symmetry.hpp"
+#include "periodic_q_surface.hpp"
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "observer.hpp"
+#include "energy_projection.hpp"
+#include "exact_flow.hpp"
+#include "Integration.hpp"
+#include "action_angle.hpp"
+
+namespace Integrators
+{
+    /// \brief Integrates many orbits of one Hamiltonian over the same time interval, without rebuilding the
+    /// integration machinery for every orbit.
+    ///
+    /// The session owns the dynamic system, the controlled stepper, the state that is integrated in place and the
+    /// buffer of the crossings. reset(s_start) only moves the start of the orbit, and the queries mirror the free
+    /// functions of Integration.hpp and action_angle.hpp. Every query restarts the stepper from the start of the orbit, so the results are
+    /// those of the free functions, but the buffers of the stepper and of the crossings are kept from query to query.
+    /// The one exception are the positions of the action-angle queries, which the session integrates together with the
+    /// action, so they agree with those of the free functions to the tolerance of the integration.
+    ///
+    /// A session is not thread safe; use one per thread.
+    template<typename Ham, typename StepperPolicy = Steppers::Default>
+    class IntegrationSession {
+     public:
+      using system_type = Dynamics::DynamicSystem<Ham>;
+      static constexpr unsigned degrees_of_freedom = system_type::degrees_of_freedom;
+      using state_type = typename system_type::state_type;
+      using action_state_type = typename system_type::action_state_type;
+      using extended_state_type = typename system_type::extended_state_type;
+      using line_type = Geometry::Hyperplane<degrees_of_freedom>;
+
+     private:
+      using stepper_type = decltype(Internals::make_controlled_stepper<StepperPolicy>(
+          std::declval<const system_type&>(),
+          std::declval<const TimeInterval&>(),
+          std::declval<const IntegrationOptions&>(),
+          std::declval<const state_type&>()));
+
+      using step_record_type = Steppers::step_record_t<StepperPolicy>;
+
+      system_type system_;
+      TimeInterval integrationTime_;
+      IntegrationOptions options_;
+      /// \brief on the heap, so that stepper_ keeps pointing at it when the session is moved
+      std::unique_ptr<step_record_type> step_record_;
+      stepper_type stepper_;
+      state_type s_start_;
+      action_state_type s_{};
+      std::vector<extended_state_type> crossings_{};
+
+      /// \brief the equations of motion of the action states, for the odeint ranges driving stepper_
+      auto integration_functor () const
+      {
+        return [sys = &system_] (const action_state_type& s, action_state_type& dsdt, double /*t*/)
+        {
+            dsdt = sys->dynamic_system_Action(s);
+        };
+      }
+
+      /// \brief the orbit of s_start, integrated in place in s_ by stepper_
+      auto integration_range (const state_type& s_start)
+      {
+        s_ = action_state_type{s_start};
+
+        if constexpr (Hamiltonian::has_exact_flow_v<Ham>)
+          {
+            const auto sampling_step = exact_flow_sampling_step(system_,
+                                                                Geometry::State2{s_start},
+                                                                integrationTime_,
+                                                                options_.exact_flow_sampling_step);
+
+            return make_exact_flow_range(system_, s_, integrationTime_, sampling_step);
+          }
+        else
+          {
+            stepper_.reset(s_start);
+
+            return boost::make_iterator_range(
+                boost::numeric::odeint::make_adaptive_time_range(boost::ref(stepper_),
+                                                                 integration_functor(),
+                                                                 s_,
+                                                                 integrationTime_.t_begin(),
+                                                                 integrationTime_.t_end(),
+                                                                 options_.initial_time_step));
+          }
+      }
+
+      auto integration_range ()
+      {
+        return integration_range(s_start_);
+      }
+
+      /// \brief the states of the orbit of s_start_ at times, see make_interval_range
+      std::vector<state_type> states_at (const std::vector<double>& times)
+      {
+        s_ = action_state_type{s_start_};
+
+        std::vector<state_type> states{};
+        states.reserve(times.size());
+
+        auto push_state = [&states] (const auto& s_t)
+        {
+            states.push_back(state_type{s_t.first});
+        };
+
+        if constexpr (Hamiltonian::has_exact_flow_v<Ham>)
+          boost::range::for_each(make_exact_flow_interval_range(system_, s_, times), push_state);
+        else
+          {
+            stepper_.reset(s_start_);
+
+            boost::range::for_each(
+                boost::make_iterator_range(
+                    boost::numeric::odeint::make_times_time_range(boost::ref(stepper_),
+                                                                  integration_functor(),
+                                                                  s_,
+                                                                  times.begin(),
+                                                                  times.end(),
+                                                                  options_.initial_time_step)),
+                push_state);
+          }
+
+        return states;
+      }
+
+      /// \brief the ActionAngleOrbit of the orbit of s_start_, given its action and period
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      ActionAngleOrbit action_angle_orbit (double action, double period, size_t number_of_angles)
+      {
+        const AnglesPositions anglesPositions{
+            PanosUtilities::linspace(0.0, boost::math::double_constants::two_pi, number_of_angles),
+            states_at(PanosUtilities::linspace(0.0, period, number_of_angles))};
+
+        return ActionAngleOrbit{action, boost::math::double_constants::two_pi / period, anglesPositions};
+      }
+
+      /// \brief an observer of the crossings of surface, which steps back along direction and appends the accepted
+      /// crossings to crossings_, after clearing it
+      template<typename SurfaceCrossObserver, typename FilterObservationPredicate>
+      auto make_observer (state_type direction, SurfaceCrossObserver surface, FilterObservationPredicate predicate)
+      {
+        crossings_.clear();
+
+        auto step_back_functor = [this, direction] (action_state_type s, double t, double distance)
+        {
+            return step_back<StepperPolicy>(system_, direction, s, t, distance, step_record_.get());
+        };
+
+        auto sink = [this] (const extended_state_type& s)
+        {
+            crossings_.push_back(s);
+        };
+
+        return Observer::makeProjectOnSurfaceObserverToSink(std::move(step_back_functor),
+                                                            std::move(surface),
+                                                            std::move(predicate),
+                                                            std::move(sink));
+      }
+
+      /// \brief the first crossing accepted by observer
+      template<typename ObserverType>
+      extended_state_type first_coming_back_home (ObserverType& observer)
+      {
+        Observer::cross_once(observer, integration_range());
+
+        if (crossings_.empty())
+          throw std::runtime_error("orbit never came back");
+
+        return crossings_.front();
+      }
+
+     public:
+      IntegrationSession (const Ham& hamiltonian,
+                          const TimeInterval& integrationTime,
+                          const IntegrationOptions& options,
+                          const state_type& s_start = state_type{})
+          : system_{hamiltonian},
+            integrationTime_{integrationTime},
+            options_{options},
+            step_record_{std::make_unique<step_record_type>()},
+            stepper_{Internals::make_controlled_stepper<StepperPolicy>(system_, integrationTime, options, s_start,
+                                                                       step_record_.get())},
+            s_start_{s_start}
+      {
+        crossings_.reserve(options.expected_crossings);
+      }
+
+      /// \brief stepper_ keeps its steps in *step_record_, which a copy would share
+      IntegrationSession (const IntegrationSession&) = delete;
+      IntegrationSession& operator= (const IntegrationSession&) = delete;
+      IntegrationSession (IntegrationSession&&) = default;
+      IntegrationSession& operator= (IntegrationSession&&) = default;
+
+      /// \brief the following queries integrate the orbit starting at s_start
+      void reset (const state_type& s_start) noexcept
+      {
+        s_start_ = s_start;
+      }
+
+      const state_type& start () const noexcept
+      {
+        return s_start_;
+      }
+
+      const system_type& system () const noexcept
+      {
+        return system_;
+      }
+
+      const TimeInterval& integration_time () const noexcept
+      {
+        return integrationTime_;
+      }
+
+      const IntegrationOptions& options () const noexcept
+      {
+        return options_;
+      }
+
+      /// \brief see Integrators::calculate_crossings
+      /// \return the crossings, valid until the next query
+      const std::vector<extended_state_type>& calculate_crossings (const line_type& cross_line)
+      {
+        auto observer = make_observer(cross_line.perpendicular_vector(),
+                                      Geometry::HyperplaneCrossObserver<degrees_of_freedom>(cross_line),
+                                      [] (const auto&)
+                                      { return true; });
+
+        Observer::cross(observer, integration_range());
+
+        return crossings_;
+      }
+
+      /// \brief see Integrators::calculate_crossings
+      /// \return the crossings, valid until the next query
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      const std::vector<extended_state_type>&
+      calculate_crossings (const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver)
+      {
+        auto observer = make_observer(Geometry::State2{1, 0}, periodicQSurfaceCrossObserver, [] (const auto&)
+        { return true; });
+
+        Observer::cross(observer, integration_range());
+
+        return crossings_;
+      }
+
+      /// \brief see Integrators::calculate_first_crossing
+      extended_state_type calculate_first_crossing (const line_type& cross_line)
+      {
+        auto observer = make_observer(cross_line.perpendicular_vector(),
+                                      Geometry::HyperplaneCrossObserver<degrees_of_freedom>(cross_line),
+                                      [] (const auto&)
+                                      { return true; });
+
+        return first_coming_back_home(observer);
+      }
+
+      /// \brief see Integrators::come_back_home_closed_orbit
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      Geometry::State2_Extended come_back_home_closed_orbit ()
+      {
+        const auto cross_line = make_init_cross_line(system_, s_start_);
+
+        auto observer = make_observer(cross_line.perpendicular_vector(),
+                                      Geometry::LineCrossObserver(cross_line),
+                                      [s_home = s_start_, near = StateNear{options_.distance_threshold}] (const auto& s)
+                                      { return near(s_home, s); });
+
+        return first_coming_back_home(observer);
+      }
+
+      /// \brief see Integrators::come_back_home_periodic_orbit
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      Geometry::State2_Extended come_back_home_periodic_orbit ()
+      {
+        auto observer = make_observer(Geometry::State2{1, 0},
+                                      Geometry::PeriodicQSurfaceCrossObserver{s_start_},
+                                      [p_start = s_start_.p(), distance_threshold = options_.distance_threshold]
+                                          (const auto& s)
+                                      { return std::abs(s.p() - p_start) < distance_threshold; });
+
+        return first_coming_back_home(observer);
+      }
+
+      /// \brief see Integrators::calculate_reversible_half_orbit
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      ReversibleHalfOrbit calculate_reversible_half_orbit (const Geometry::ReversingSymmetry& symmetry)
+      {
+        const auto& fixed_line = symmetry.fixed_line();
+        const auto half_orbit_start = Internals::reversible_half_orbit_start(fixed_line, s_start_, options_);
+
+        auto observer = make_observer(fixed_line.perpendicular_vector(),
+                                      Geometry::LineAnyDirectionCrossObserver(fixed_line),
+                                      [] (const auto&)
+                                      { return true; });
+
+        auto observe_past_start = Internals::skip_first_observation(observer, half_orbit_start.on_fixed_line);
+        Observer::cross_n_times(observe_past_start,
+                                integration_range(half_orbit_start.s),
+                                Internals::reversible_half_orbit_crossings(half_orbit_start));
+
+        return Internals::make_reversible_half_orbit(half_orbit_start, integrationTime_.t_begin(), crossings_);
+      }
+
+      /// \brief see Integrators::come_back_home_reversible_orbit
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      Geometry::State2_Extended come_back_home_reversible_orbit (const Geometry::ReversingSymmetry& symmetry)
+      {
+        const auto half_orbit = calculate_reversible_half_orbit(symmetry);
+
+        Geometry::State2_Extended s_home{s_start_};
+        s_home.J() = half_orbit.action();
+        s_home.t() = integrationTime_.t_begin() + half_orbit.period();
+
+        return s_home;
+      }
+
+      /// \brief see Integrators::calculate_action_angle_on_closed_orbit
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      ActionAngleOrbit calculate_action_angle_on_closed_orbit (size_t number_of_angles = 100)
+      {
+        const auto s_home = come_back_home_closed_orbit();
+
+        return action_angle_orbit(s_home.J(), s_home.t() - integrationTime_.t_begin(), number_of_angles);
+      }
+
+      /// \brief see Integrators::calculate_action_angle_on_periodic_orbit
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      ActionAngleOrbit calculate_action_angle_on_periodic_orbit (size_t number_of_angles = 100)
+      {
+        const auto s_home = come_back_home_periodic_orbit();
+
+        return action_angle_orbit(s_home.J(), s_home.t() - integrationTime_.t_begin(), number_of_angles);
+      }
+
+      /// \brief see Integrators::calculate_action_angle_on_reversible_orbit
+      template<unsigned D = degrees_of_freedom, typename = std::enable_if_t<D == 1> >
+      ActionAngleOrbit calculate_action_angle_on_reversible_orbit (const Geometry::ReversingSymmetry& symmetry,
+                                                                   size_t number_of_angles = 100)
+      {
+        const auto half_orbit = calculate_reversible_half_orbit(symmetry);
+        const auto period = half_orbit.period();
+        const auto half_orbit_end_time = half_orbit.end.t() - integrationTime_.t_begin();
+
+        const auto times = PanosUtilities::linspace(0.0, period, number_of_angles);
+        const auto integration_times = Internals::reversible_orbit_integration_times(times, half_orbit_end_time);
+
+        const AnglesPositions anglesPositions{
+            PanosUtilities::linspace(0.0, boost::math::double_constants::two_pi, number_of_angles),
+            Internals::unfold_reversible_orbit_positions(times,
+                                                         integration_times,
+                                                         states_at(integration_times),
+                                                         symmetry,
+                                                         half_orbit_end_time)};
+
+        return ActionAngleOrbit{half_orbit.action(), boost::math::double_constants::two_pi / period, anglesPositions};
+      }
+    };
+
+    extern template class IntegrationSession<Hamiltonian::HarmonicOscillator>;
+    extern template class IntegrationSession<Hamiltonian::DuffingHamiltonian>;
+    extern template class IntegrationSession<Hamiltonian::PendulumHamiltonian>;
+    extern template class IntegrationSession<Hamiltonian::FreeParticle>;
+    extern template class IntegrationSession<Hamiltonian::SplinePotentialHamiltonian>;
+    extern template class IntegrationSession<Hamiltonian::HenonHeilesHamiltonian>;
+}
+
+#endif //HAMILTONIANS_INTEGRATION_SESSION_HPP
@@ -5,6 +5,7 @@
 #ifndef HAMILTONIANS_LINE_HPP
 #define HAMILTONIANS_LINE_HPP
 #include <iostream>
+#include <stdexcept>
 #include "State.hpp"
 
 namespace Integrators
@@ -12,32 +13,124 @@ namespace Integrators
     namespace Geometry
     {
 
+        inline bool crossZeroPositiveDirectionPredicate (double current_value, double previous_value)
+        {
+          return (current_value >= 0 && previous_value< 0);
+        }
 
+        inline bool crossZeroAnyDirectionPredicate (double current_value, double previous_value)
+        {
+          return (current_value >= 0 && previous_value < 0) || (current_value <= 0 && previous_value > 0);
+        }
 
+        /// \brief The hyperplane n.s + c = 0 of the phase space of DOF degrees of freedom. In one degree of freedom it
+        /// is a line, see Line.
+        template<unsigned DOF>
+        class Hyperplane {
+          PhaseSpaceState<DOF> s_{};
+          double c_{0};
+         public:
+          /// \brief the hyperplane through position, perpendicular to perpendicular_vector
+          Hyperplane (const PhaseSpaceState<DOF>& position, PhaseSpaceState<DOF> perpendicular_vector)
+              : s_{perpendicular_vector}, c_{-(position * perpendicular_vector)}
+          {
+            if (magnitude_squared(s_) == 0)
+              throw std::invalid_argument("Hyperplane: the perpendicular vector must be nonzero");
+          }
 
+          /// \brief the signed distance of position from the hyperplane, in units of |perpendicular_vector|
+          double operator() (const PhaseSpaceState<DOF>& position) const noexcept
+          {
+            return s_ * position + c_;
+          }
 
+          PhaseSpaceState<DOF> perpendicular_vector () const noexcept
+          {
+            return s_;
+          }
 
-        class Line {
-          friend std::ostream& operator<< (std::ostream&, const Line&);
-          State2 s_{};
-          double c_{0};
-         public:
-          double operator() (const State2& position) const noexcept;
-          Line (const State2& position,State2 perpendicular_vector);
-          State2 perpendicular_vector() const noexcept;
+          double offset () const noexcept
+          {
+            return c_;
+          }
         };
 
+        using Line = Hyperplane<1>;
+
+        /// \brief prints a*x + b*y + c = 0
         std::ostream& operator<< (std::ostream&, const Line&);
 
-        class LineCrossObserver
+        /// \brief Reports the crossings of a hyperplane in the direction of its perpendicular vector
+        template<unsigned DOF>
+        class HyperplaneCrossObserver
+        {
+          Hyperplane<DOF> hyperplane_;
+          mutable double distance_=0;
+         public:
+          explicit HyperplaneCrossObserver (Hyperplane<DOF> hyperplane) noexcept
+              : hyperplane_(std::move(hyperplane))
+          { }
+
+          bool operator()(const PhaseSpaceState<DOF>& next_point) const noexcept
+          {
+            const double next_distance = hyperplane_(next_point);
+            const bool crossed = crossZeroPositiveDirectionPredicate(next_distance, distance_);
+            distance_ = next_distance;
+            return crossed;
+          }
+
+          double distance() const noexcept
+          {
+            return distance_;
+          }
+
+          /// \brief resumes the observation at a point at distance from the hyperplane, e.g. from a checkpoint
+          void restore_distance (double distance) noexcept
+          {
+            distance_ = distance;
+          }
+        };
+
+        /// \brief Like HyperplaneCrossObserver, but reports crossings of the hyperplane in both directions.
+        template<unsigned DOF>
+        class HyperplaneAnyDirectionCrossObserver
         {
-          Line line_;
+          Hyperplane<DOF> hyperplane_;
           mutable double distance_=0;
          public:
-          explicit LineCrossObserver (Line line) noexcept ;
-          bool operator()(const State2& next_point) const noexcept ;
-          double distance() const noexcept ;
+          explicit HyperplaneAnyDirectionCrossObserver (Hyperplane<DOF> hyperplane) noexcept
+              : hyperplane_(std::move(hyperplane))
+          { }
+
+          bool operator()(const PhaseSpaceState<DOF>& next_point) const noexcept
+          {
+            const double next_distance = hyperplane_(next_point);
+            const bool crossed = crossZeroAnyDirectionPredicate(next_distance, distance_);
+            distance_ = next_distance;
+            return crossed;
+          }
+
+          double distance() const noexcept
+          {
+            return distance_;
+          }
+
+          /// \brief resumes the observation at a point at distance from the hyperplane, e.g. from a checkpoint
+          void restore_distance (double distance) noexcept
+          {
+            distance_ = distance;
+          }
         };
+
+        using LineCrossObserver = HyperplaneCrossObserver<1>;
+        using LineAnyDirectionCrossObserver = HyperplaneAnyDirectionCrossObserver<1>;
+
+        extern template class Hyperplane<1>;
+        extern template class Hyperplane<2>;
+        extern template class HyperplaneCrossObserver<1>;
+        extern template class HyperplaneCrossObserver<2>;
+        extern template class HyperplaneAnyDirectionCrossObserver<1>;
+        extern template class HyperplaneAnyDirectionCrossObserver<2>;
     }
 
 }
@@ -18,34 +18,72 @@ namespace Integrators
 
 
 
-        class PushBackObserver {
+        /// \brief Stores every `every`-th observation
+        /// \tparam StateType the type of the observations
+        template<typename StateType>
+        class BasicPushBackObserver {
          public:
-          using value_type = Geometry::State2_Extended;
+          using value_type = StateType;
          private:
 
           std::vector<value_type> s_{};
           size_t every_ = 1;
           mutable size_t count = 0;
          public:
-          PushBackObserver () =default;
-          PushBackObserver (const PushBackObserver&) = default;
-          PushBackObserver (PushBackObserver&&) noexcept = default;
+          BasicPushBackObserver () =default;
+          BasicPushBackObserver (const BasicPushBackObserver&) = default;
+          BasicPushBackObserver (BasicPushBackObserver&&) noexcept = default;
 
-          explicit PushBackObserver (size_t every);
-          void operator() (value_type s);
-          std::vector<value_type> observations() const noexcept;
+          explicit BasicPushBackObserver (size_t every)
+              :
+              every_{every > 0 ? every : 1}
+          {
+
+          }
+
+          void operator() (value_type s)
+          {
+            if (!(count++ % every_))
+              {
+                s_.push_back(s);
+
+              }
+
+          }
+
+          std::vector<value_type> observations() const noexcept
+          {
+            return s_;
+          }
+
+          /// \brief reserves room for n stored observations, so that storing them does not allocate
+          void reserve (size_t n)
+          {
+            s_.reserve(n);
+          }
 
         };
 
+        using PushBackObserver = BasicPushBackObserver<Geometry::State2_Extended>;
+
+        extern template class BasicPushBackObserver<Geometry::State2_Extended>;
+        extern template class BasicPushBackObserver<Geometry::State4_Extended>;
+
         bool crossZeroPositiveDirectionPredicate (double current_value, double previous_value);
 
-        template<typename StepOnFunctor, typename SurfaceCrossObserver, typename FilterObservationPredicate>
+        /// \brief Detects the crossings of a surface, steps onto the surface, and hands the accepted crossings to the
+        /// sink: a PushBackObserver by default, or any callable taking the extended state returned by StepOnFunctor.
+        ///
+        /// It observes the states of any number of degrees of freedom; the surface observer sees their phase space
+        /// part.
+        template<typename StepOnFunctor, typename SurfaceCrossObserver, typename FilterObservationPredicate,
+            typename Sink = PushBackObserver>
         class ProjectOnSurfaceObserver {
          private:
 
           StepOnFunctor stepOnFunctor_;
           SurfaceCrossObserver surfaceCrossObserver_;
-          PushBackObserver pushBackObserver_;
+          Sink pushBackObserver_;
           FilterObservationPredicate validCrossingPredicate_;
 
 
@@ -53,8 +91,9 @@ namespace Integrators
           /// \param s the current position
           /// \param t the current time
           /// \param distance the distance from the surface
-          /// \return true, if the crossing has been accepted and forwarded to the pushBackObserver
-          bool after_crossing_action (const Geometry::State2_Action& s, double t, double distance)
+          /// \return true, if the crossing has been accepted and forwarded to the sink
+          template<typename ActionStateType>
+          bool after_crossing_action (const ActionStateType& s, double t, double distance)
           {
 
             const auto s_out_extended = stepOnFunctor_(s, t, distance);
@@ -68,41 +107,68 @@ namespace Integrators
          public:
           ProjectOnSurfaceObserver () = delete;
 
-          ProjectOnSurfaceObserver (StepOnFunctor af, SurfaceCrossObserver sf, PushBackObserver pbo, FilterObservationPredicate fop)
+          ProjectOnSurfaceObserver (StepOnFunctor af, SurfaceCrossObserver sf, Sink pbo, FilterObservationPredicate fop)
               : stepOnFunctor_{std::move(af)},
                 surfaceCrossObserver_{std::move(sf)},
-                pushBackObserver_{pbo},
+                pushBackObserver_{std::move(pbo)},
                 validCrossingPredicate_{fop}
           { };
 
-          bool operator() (const Geometry::State2_Action& s, double t)
+          template<unsigned N, unsigned DOF>
+          bool operator() (const Geometry::State<N, DOF>& s, double t)
           {
             bool crossing_accepted = false;
 
-            if (surfaceCrossObserver_(Geometry::State2{s}))
+            if (surfaceCrossObserver_(Geometry::PhaseSpaceState<DOF>{s}))
               crossing_accepted = after_crossing_action(s, t, surfaceCrossObserver_.distance());
 
             return crossing_accepted;
           }
 
-          bool operator() (const std::pair<Geometry::State2_Action, double>& s_t)
+          template<typename StateType, typename TimeType>
+          bool operator() (const std::pair<StateType, TimeType>& s_t)
           {
             const auto&[s, t] = s_t;
             return operator()(s, t);
           }
 
+          /// \brief only for sinks that store the crossings, like PushBackObserver
           auto observations() const noexcept
           {
             return pushBackObserver_.observations();
           }
+
+          const Sink& sink () const noexcept
+          {
+            return pushBackObserver_;
+          }
+
+          /// \brief only for sinks that store the crossings, like PushBackObserver
+          void reserve (size_t number_of_crossings)
+          {
+            pushBackObserver_.reserve(number_of_crossings);
+          }
         };
 
-        template<typename StepOnFunctor, typename SurfaceFunctor, typename ValidCrossingPredicate>
+        /// \tparam ExtendedStateType the type of the crossings, i.e. of the states returned by StepOnFunctor
+        template<typename ExtendedStateType = Geometry::State2_Extended, typename StepOnFunctor, typename SurfaceFunctor,
+            typename ValidCrossingPredicate>
         auto makeProjectOnSurfaceObserver (StepOnFunctor stepOnFunctor, SurfaceFunctor sf, ValidCrossingPredicate vcp,
                                            size_t every = 0)
         {
-          PushBackObserver pbo(every);
-          return ProjectOnSurfaceObserver<StepOnFunctor, SurfaceFunctor, ValidCrossingPredicate>(stepOnFunctor, sf, pbo, vcp);
+          BasicPushBackObserver<ExtendedStateType> pbo(every);
+          return ProjectOnSurfaceObserver<StepOnFunctor, SurfaceFunctor, ValidCrossingPredicate,
+              BasicPushBackObserver<ExtendedStateType> >(stepOnFunctor, sf, pbo, vcp);
+        }
+
+        /// \brief Like makeProjectOnSurfaceObserver, but the accepted crossings are handed to sink instead of being
+        /// stored.
+        template<typename StepOnFunctor, typename SurfaceFunctor, typename ValidCrossingPredicate, typename Sink>
+        auto makeProjectOnSurfaceObserverToSink (StepOnFunctor stepOnFunctor, SurfaceFunctor sf,
+                                                 ValidCrossingPredicate vcp, Sink sink)
+        {
+          return ProjectOnSurfaceObserver<StepOnFunctor, SurfaceFunctor, ValidCrossingPredicate, Sink>(
+              std::move(stepOnFunctor), std::move(sf), std::move(sink), std::move(vcp));
         }
 
 
@@ -133,6 +199,23 @@ namespace Integrators
           boost::range::find_if(integration_range, std::ref(observer));
         }
 
+        /// \brief Aplies the observer on the integration_range until the observer has returned true n times
+        /// \tparam Observer a type defining a bool operator() (const IntegrationRange::value_type & s_t)
+        /// \tparam IntegrationRange a boost range type
+        /// \param observer
+        /// \param integration_range
+        /// \param n the number of accepted observations after which the integration stops
+        template<typename Observer, typename IntegrationRange>
+        void cross_n_times (Observer& observer, const IntegrationRange& integration_range, size_t n)
+        {
+          size_t accepted = 0;
+
+          boost::range::find_if(integration_range, [&observer, &accepted, n] (const auto& s_t)
+          {
+              return observer(s_t) && ++accepted >= n;
+          });
+        }
+
 
     }
 }
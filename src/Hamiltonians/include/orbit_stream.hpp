@@ -0,0 +1,97 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_ORBIT_STREAM_HPP
+#define HAMILTONIANS_ORBIT_STREAM_HPP
+
+#include "details/generator.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <boost/numeric/odeint/util/detail/less_with_sign.hpp>
+
+#include "State.hpp"
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "IntegrationTimeInterval.hpp"
+#include "exact_flow.hpp"
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    /// \brief The (action state, time) pairs of the orbit starting at s_start, for C++20 and later: a coroutine
+    /// counterpart of make_dynamic_system_integration_range.
+    ///
+    /// The system, the controlled stepper and the state live in the coroutine frame, and every pair is handed out by
+    /// reference, so neither the stepper nor the system is ever copied after the start and nothing dangles: all the
+    /// arguments are taken by value. The steps are those of the adaptive range, and so are the samples of the
+    /// Hamiltonians with an exact flow. The stream is a single pass range, to be used with the observers and with
+    /// Observer::cross, cross_once and cross_n_times, or any other range algorithm that stops early.
+    /// \param step_record where the stepper keeps its last step, for the step_back of the observers of the stream (see
+    /// Steppers::step_record_t); it must outlive the stream
+    template<typename StepperPolicy = Steppers::Default, typename DS>
+    Internals::Generator<std::pair<typename DS::action_state_type, double>>
+    orbit_stream (DS system,
+                  typename DS::action_state_type s_start,
+                  TimeInterval integrationTime,
+                  IntegrationOptions options,
+                  [[maybe_unused]] Steppers::step_record_t<StepperPolicy>* step_record = nullptr)
+    {
+      using action_state_type = typename DS::action_state_type;
+      using boost::numeric::odeint::detail::less_with_sign;
+
+      const auto t_begin = integrationTime.t_begin();
+      const auto t_end = integrationTime.t_end();
+
+      if constexpr (Hamiltonian::has_exact_flow_v<typename DS::hamiltonian_type>)
+        {
+          const auto sampling_step = exact_flow_sampling_step(system,
+                                                              Geometry::State2{s_start},
+                                                              integrationTime,
+                                                              options.exact_flow_sampling_step);
+
+          const auto number_of_steps = static_cast<long>(std::ceil((t_end - t_begin) / sampling_step));
+
+          for (long k = 0; k <= std::max(number_of_steps, 0L); ++k)
+            {
+              const auto t = std::min(t_begin + static_cast<double>(k) * sampling_step, t_end);
+              co_yield std::make_pair(exact_flow(system, s_start, t - t_begin), t);
+            }
+        }
+      else
+        {
+          auto controlled_stepper = Internals::make_controlled_stepper<StepperPolicy>(
+              system, integrationTime, options, typename DS::state_type{s_start}, step_record);
+
+          auto integration_functor = [&system] (const action_state_type& s, action_state_type& dsdt, double /*t*/)
+          {
+              dsdt = system.dynamic_system_Action(s);
+          };
+
+          std::pair<action_state_type, double> s_t{s_start, t_begin};
+          auto&[s, t] = s_t;
+          auto dt = options.initial_time_step;
+
+          if (less_with_sign(t_end, t, dt))
+            co_return;
+
+          co_yield s_t;
+
+          // the steps of odeint's adaptive iterator
+          while (less_with_sign(t, t_end, dt))
+            {
+              Internals::adaptive_step(controlled_stepper, integration_functor, s, t, dt, t_end);
+              co_yield s_t;
+            }
+        }
+    }
+}
+
+#endif // __cpp_impl_coroutine
+
+#endif //HAMILTONIANS_ORBIT_STREAM_HPP
@@ -0,0 +1,309 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_PARAMETER_SENSITIVITY_HPP
+#define HAMILTONIANS_PARAMETER_SENSITIVITY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/numeric/odeint.hpp>
+#include <boost/math/constants/constants.hpp>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "IntegrationTimeInterval.hpp"
+#include "Integration.hpp"
+#include "steppers.hpp"
+
+namespace Integrators
+{
+    namespace Dynamics
+    {
+        /// \brief The orbit, its action and their derivatives with respect to P of the parameters of the
+        /// Hamiltonian, integrated together: {q, p, J, dq/dmu_1, dp/dmu_1, dJ/dmu_1, ..., dJ/dmu_P}.
+        template<size_t P>
+        using SensitivityState = Geometry::State<static_cast<unsigned>(3 * (P + 1))>;
+
+        /// \brief The forward sensitivity equations: each (dq/dmu, dp/dmu, dJ/dmu) evolves with the linearized flow,
+        /// driven by the derivative of the flow with respect to mu.
+        /// \param parameters the indices, in ham.parameters(), of mu_1, ..., mu_P
+        template<typename Ham, size_t P>
+        inline SensitivityState<P>
+        sensitivity_system_impl (const Ham& ham, const std::array<size_t, P>& parameters, const SensitivityState<P>& x)
+        {
+          const Geometry::State2 s{x[0], x[1]};
+          const auto p = s.p();
+          const auto dHds = ham.derivative(s);
+          const auto[h_qq, h_qp, h_pp] = Hamiltonian::hessian(ham, s);
+          const auto dHds_dmu = ham.parameter_derivatives(s);
+
+          SensitivityState<P> dxdt{};
+          dxdt[0] = dHds.p();
+          dxdt[1] = -dHds.q();
+          dxdt[2] = p * dHds.p();
+
+          for (size_t k = 0; k < P; ++k)
+            {
+              const auto i = static_cast<unsigned>(3 * (k + 1));
+              const auto S_q = x[i];
+              const auto S_p = x[i + 1];
+              const auto& f_mu = dHds_dmu[parameters[k]];
+
+              dxdt[i] = h_qp * S_q + h_pp * S_p + f_mu.p();
+              dxdt[i + 1] = -h_qq * S_q - h_qp * S_p - f_mu.q();
+              dxdt[i + 2] = p * (h_qp * S_q + h_pp * S_p + f_mu.p()) + dHds.p() * S_p;
+            }
+
+          return dxdt;
+        }
+    }
+
+    /// \brief The action and the frequency of a closed orbit, and their derivatives with respect to P of the
+    /// parameters of the Hamiltonian
+    template<size_t P>
+    struct OrbitSensitivities {
+        /// \brief the indices, in parameters(), of the parameters of d_action and d_omega
+        std::array<size_t, P> parameters{};
+        /// \brief the return of come_back_home_closed_orbit
+        Geometry::State2_Extended orbit{};
+        double action = 0;
+        double omega = 0;
+        std::array<double, P> d_action{};
+        std::array<double, P> d_omega{};
+    };
+
+    /// \brief The action and the frequency of the closed orbit through s_start, as by come_back_home_closed_orbit, and
+    /// their derivatives with respect to the parameters at the indices parameters of hamiltonian.parameters(), s_start
+    /// held fixed.
+    ///
+    /// After come_back_home_closed_orbit has found the period T, the orbit is integrated again over [0, T] together
+    /// with its forward sensitivities, see Dynamics::sensitivity_system_impl. The orbit of a neighbouring parameter
+    /// comes back to the crossing line of s_start at T + dT, with dT = -n.dx/dmu / n.dx/dt at T, n being the normal of
+    /// the line; the derivatives of the action and of omega = 2 pi / T follow.
+    ///
+    /// The second integration carries 3 P more components than the first, so ask only for the parameters needed.
+    ///
+    /// Ham must provide number_of_parameters and parameter_derivatives(s), see Hamiltonian::DuffingHamiltonian. Only
+    /// the Runge-Kutta stepper policies are supported.
+    /// \throws std::runtime_error if the orbit never comes back
+    template<typename StepperPolicy = Steppers::Default, typename Ham, size_t P>
+    OrbitSensitivities<P>
+    calculate_closed_orbit_sensitivities (const Ham& hamiltonian,
+                                          const std::array<size_t, P>& parameters,
+                                          const Geometry::State2& s_start,
+                                          const TimeInterval& integrationTime,
+                                          const IntegrationOptions& options)
+    {
+      using state_type = Dynamics::SensitivityState<P>;
+
+      OrbitSensitivities<P> sensitivities{};
+      sensitivities.parameters = parameters;
+      sensitivities.orbit = come_back_home_closed_orbit<StepperPolicy>(hamiltonian, s_start, integrationTime, options);
+
+      const auto t_begin = integrationTime.t_begin();
+      const auto period = sensitivities.orbit.t() - t_begin;
+
+      auto sensitivity_functor = [&hamiltonian, &parameters] (const state_type& x, state_type& dxdt, double)
+      {
+          dxdt = Dynamics::sensitivity_system_impl(hamiltonian, parameters, x);
+      };
+
+      const auto system = Dynamics::DynamicSystem<Ham>{hamiltonian};
+      const auto& dt_max = integrationTime.dt_max();
+
+      auto controlled_stepper = dt_max
+                                ? StepperPolicy::template make_controlled<state_type>(
+              system, options.abs_err, options.rel_err, dt_max.value())
+                                : StepperPolicy::template make_controlled<state_type>(
+              system, options.abs_err, options.rel_err);
+
+      state_type x{};
+      x[0] = s_start.q();
+      x[1] = s_start.p();
+
+      boost::numeric::odeint::integrate_adaptive(controlled_stepper, sensitivity_functor, x, t_begin,
+                                                 t_begin + period, options.initial_time_step);
+
+      const Geometry::State2 s_end{x[0], x[1]};
+      const auto dHds = hamiltonian.derivative(s_end);
+      const Geometry::State2 dsdt{dHds.p(), -dHds.q()};
+      const auto dJdt = s_end.p() * dHds.p();
+
+      const auto normal = make_init_cross_line(system, s_start).perpendicular_vector();
+      const auto normal_speed = normal.q() * dsdt.q() + normal.p() * dsdt.p();
+
+      sensitivities.action = sensitivities.orbit.J();
+      sensitivities.omega = boost::math::double_constants::two_pi / period;
+
+      for (size_t k = 0; k < P; ++k)
+        {
+          const auto i = static_cast<unsigned>(3 * (k + 1));
+          const auto d_period = -(normal.q() * x[i] + normal.p() * x[i + 1]) / normal_speed;
+
+          sensitivities.d_action[k] = x[i + 2] + dJdt * d_period;
+          sensitivities.d_omega[k] = -sensitivities.omega * d_period / period;
+        }
+
+      return sensitivities;
+    }
+
+    /// \brief calculate_closed_orbit_sensitivities with respect to all the parameters of the Hamiltonian, in the order
+    /// of parameters()
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    OrbitSensitivities<Ham::number_of_parameters>
+    calculate_closed_orbit_sensitivities (const Ham& hamiltonian,
+                                          const Geometry::State2& s_start,
+                                          const TimeInterval& integrationTime,
+                                          const IntegrationOptions& options)
+    {
+      std::array<size_t, Ham::number_of_parameters> parameters{};
+      for (size_t k = 0; k < parameters.size(); ++k)
+        parameters[k] = k;
+
+      return calculate_closed_orbit_sensitivities<StepperPolicy>(hamiltonian,
+                                                                 parameters,
+                                                                 s_start,
+                                                                 integrationTime,
+                                                                 options);
+    }
+
+    /// \brief Options for scan_parameter
+    struct ParameterScanOptions {
+        /// \brief 1 or 2: the order of the Taylor updates of the action and of omega. An integrated orbit costs about
+        /// twice a plain come_back_home_closed_orbit, for the second integration with the sensitivities, so order 1,
+        /// whose updates are good only for steps of about the square root of the tolerance, is a net loss at tight
+        /// tolerances: it integrates every value of a fine scan at 1e-6, taking about twice as long as integrating them
+        /// all plainly, and pays off only at loose tolerances, or over scans much finer than the tolerance.
+        unsigned order = 2;
+        /// \brief an update is used only if its predicted absolute error, in both the action and omega, is below this
+        double tolerance = 1e-8;
+    };
+
+    struct ParameterScanPoint {
+        double parameter = 0;
+        double action = 0;
+        double omega = 0;
+        /// \brief true if the orbit was integrated, false if it was updated from the last integrated one
+        bool integrated = false;
+        /// \brief the predicted error of the update; zero for the integrated orbits
+        double predicted_error = 0;
+    };
+
+    /// \brief The action and the frequency of the closed orbit through s_start, for each of the values of the
+    /// parameter at index parameter of hamiltonian.parameters().
+    ///
+    /// Each value is updated from the last integrated orbit by a Taylor polynomial of order scan_options.order. The
+    /// first derivatives come from calculate_closed_orbit_sensitivities, the second ones from the differences of the
+    /// first derivatives of the last integrated orbits, and the third ones from the differences of the second. The
+    /// error of an update is predicted by the next term of the polynomial; only where it exceeds
+    /// scan_options.tolerance, or cannot be predicted yet, is the orbit integrated. The first order + 1 values are
+    /// always integrated. Second order updates are the default; see ParameterScanOptions::order for the cost of
+    /// first order ones.
+    ///
+    /// Ham must provide set_parameter(index, value), see calculate_closed_orbit_sensitivities for the rest.
+    /// \throws std::invalid_argument if scan_options.order is neither 1 nor 2
+    /// \throws std::runtime_error if an integrated orbit never comes back
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    std::vector<ParameterScanPoint> scan_parameter (Ham hamiltonian,
+                                                    size_t parameter,
+                                                    const std::vector<double>& values,
+                                                    const Geometry::State2& s_start,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options,
+                                                    const ParameterScanOptions& scan_options = ParameterScanOptions{})
+    {
+      if (scan_options.order != 1 && scan_options.order != 2)
+        throw std::invalid_argument("scan_parameter: the order must be 1 or 2");
+
+      struct Anchor {
+          double parameter;
+          std::array<double, 2> value;
+          std::array<double, 2> derivative;
+      };
+
+      // the newest first; three are enough for the third derivatives
+      std::deque<Anchor> anchors{};
+
+      auto second_derivative = [&anchors] (size_t i, size_t j)
+      {
+          const auto& a = anchors[i];
+          const auto& b = anchors[i + 1];
+          return (a.derivative[j] - b.derivative[j]) / (a.parameter - b.parameter);
+      };
+
+      std::vector<ParameterScanPoint> points{};
+      points.reserve(values.size());
+
+      for (const auto mu: values)
+        {
+          ParameterScanPoint point{};
+          point.parameter = mu;
+
+          const auto order = scan_options.order;
+          if (anchors.size() > order)
+            {
+              const auto& anchor = anchors.front();
+              const auto delta = mu - anchor.parameter;
+
+              std::array<double, 2> updated{};
+              for (size_t j = 0; j < 2; ++j)
+                {
+                  updated[j] = anchor.value[j] + anchor.derivative[j] * delta;
+                  const auto d2 = second_derivative(0, j);
+
+                  double error = std::abs(d2) * delta * delta / 2;
+                  if (order == 2)
+                    {
+                      // the differences are the derivatives at the midpoints between the integrated orbits
+                      const auto d3 = (d2 - second_derivative(1, j)) / ((anchor.parameter - anchors[2].parameter) / 2);
+                      const auto d2_at_anchor = d2 + d3 * (anchor.parameter - anchors[1].parameter) / 2;
+
+                      updated[j] += d2_at_anchor * delta * delta / 2;
+                      error = std::abs(d3 * delta * delta * delta) / 6;
+                    }
+
+                  point.predicted_error = std::max(point.predicted_error, error);
+                }
+
+              if (point.predicted_error <= scan_options.tolerance)
+                {
+                  point.action = updated[0];
+                  point.omega = updated[1];
+                  points.push_back(point);
+                  continue;
+                }
+            }
+
+          hamiltonian.set_parameter(parameter, mu);
+          const auto sensitivities = calculate_closed_orbit_sensitivities<StepperPolicy>(hamiltonian,
+                                                                                         std::array<size_t, 1>{
+                                                                                             parameter},
+                                                                                         s_start,
+                                                                                         integrationTime,
+                                                                                         options);
+
+          point.action = sensitivities.action;
+          point.omega = sensitivities.omega;
+          point.integrated = true;
+          point.predicted_error = 0;
+          points.push_back(point);
+
+          anchors.push_front(Anchor{mu, {sensitivities.action, sensitivities.omega},
+                                    {sensitivities.d_action[0], sensitivities.d_omega[0]}});
+          if (anchors.size() > 3)
+            anchors.pop_back();
+        }
+
+      return points;
+    }
+}
+
+#endif //HAMILTONIANS_PARAMETER_SENSITIVITY_HPP
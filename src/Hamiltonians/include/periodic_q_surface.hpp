@@ -23,6 +23,8 @@ namespace Integrators
           {};
           bool operator()(const State2& next_point) const noexcept ;
           double distance() const noexcept ;
+          /// \brief resumes the observation at a point at distance from the surface, e.g. from a checkpoint
+          void restore_distance (double distance) noexcept;
 
         };
 
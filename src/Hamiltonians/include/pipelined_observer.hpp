@@ -0,0 +1,263 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_PIPELINED_OBSERVER_HPP
+#define HAMILTONIANS_PIPELINED_OBSERVER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "dynamic_system.hpp"
+#include "details/spsc_queue.hpp"
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    namespace Observer
+    {
+        /// \brief A ProjectOnSurfaceObserver split over two threads.
+        ///
+        /// On the integrating thread the observer only detects the crossings, and pushes the state, the time and the
+        /// distance from the surface into a bounded single producer, single consumer queue. A thread owned by the
+        /// observer pops them in order and runs the step on functor, the predicate and the sink, so that the
+        /// integration overlaps with the post processing. The integrating thread waits only if the queue is full. The
+        /// observer's thread, once the queue is empty, spins for a few rounds and then sleeps until the next crossing,
+        /// so it takes no core while the integration runs between crossings.
+        ///
+        /// Whether a crossing is accepted is not known when it is detected, so operator() always returns false: use the
+        /// observer with Observer::cross, not with cross_once or cross_n_times. The sink is called on the observer's
+        /// thread, and may be read only after finish().
+        ///
+        /// The step record of the integrating stepper, if given, is queued with every crossing, since the stepper
+        /// overwrites it before the observer's thread steps back; the step on functor gets that copy, or null, as its
+        /// fourth argument.
+        template<typename StepOnFunctor, typename SurfaceCrossObserver, typename FilterObservationPredicate,
+            typename Sink, typename ActionStateType, typename StepRecord = Steppers::NoStepRecord>
+        class PipelinedProjectOnSurfaceObserver {
+          struct Crossing {
+              ActionStateType s{};
+              double t = 0;
+              double distance = 0;
+              StepRecord step_record{};
+          };
+
+          StepOnFunctor stepOnFunctor_;
+          SurfaceCrossObserver surfaceCrossObserver_;
+          Sink sink_;
+          FilterObservationPredicate validCrossingPredicate_;
+          const StepRecord* step_record_;
+
+          /// \brief the rounds the observer's thread yields, waiting for a crossing, before it sleeps
+          static constexpr unsigned spin_rounds = 64;
+
+          Internals::SpscQueue<Crossing> queue_;
+          std::atomic<bool> producer_done_{false};
+          std::atomic<bool> consumer_asleep_{false};
+          std::mutex mutex_{};
+          std::condition_variable wake_up_{};
+          bool finished_ = false;
+          std::exception_ptr error_{};
+          std::thread consumer_;
+
+          /// \brief the consumer thread. After an exception the crossings are still popped, so that the integrating
+          /// thread never waits for ever on a full queue, but they are dropped.
+          void consume ()
+          {
+            Crossing crossing{};
+
+            while (true)
+              {
+                const bool done = producer_done_.load(std::memory_order_acquire);
+
+                while (queue_.try_pop(crossing))
+                  {
+                    if (error_)
+                      continue;
+
+                    try
+                      {
+                        const auto s_out_extended = stepOnFunctor_(crossing.s, crossing.t, crossing.distance,
+                                                                   step_record_ ? &crossing.step_record : nullptr);
+                        if (validCrossingPredicate_(s_out_extended))
+                          sink_(s_out_extended);
+                      }
+                    catch (...)
+                      {
+                        error_ = std::current_exception();
+                      }
+                  }
+
+                if (done)
+                  return;
+
+                wait_for_crossings();
+              }
+          }
+
+          bool has_work () const noexcept
+          {
+            return !queue_.empty() || producer_done_.load(std::memory_order_acquire);
+          }
+
+          /// \brief the consumer thread, on an empty queue: spins, then sleeps until wake_consumer()
+          void wait_for_crossings ()
+          {
+            for (unsigned round = 0; round < spin_rounds; ++round)
+              {
+                if (has_work())
+                  return;
+                std::this_thread::yield();
+              }
+
+            std::unique_lock<std::mutex> lock{mutex_};
+            consumer_asleep_.store(true, std::memory_order_relaxed);
+            // pairs with the fence of wake_consumer: either this thread sees the new crossing, or the producer sees
+            // consumer_asleep_
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            wake_up_.wait(lock, [this] ()
+            { return has_work(); });
+            consumer_asleep_.store(false, std::memory_order_relaxed);
+          }
+
+          /// \brief the producer side, after a push or once done: wakes the consumer thread if it sleeps. The lock is
+          /// taken only then, so a busy consumer costs the integrating thread a fence per crossing.
+          void wake_consumer ()
+          {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (consumer_asleep_.load(std::memory_order_relaxed))
+              {
+                const std::lock_guard<std::mutex> lock{mutex_};
+                wake_up_.notify_one();
+              }
+          }
+
+          void stop () noexcept
+          {
+            if (finished_)
+              return;
+
+            finished_ = true;
+            producer_done_.store(true, std::memory_order_release);
+            wake_consumer();
+            consumer_.join();
+          }
+
+         public:
+          PipelinedProjectOnSurfaceObserver (StepOnFunctor af, SurfaceCrossObserver sf, Sink sink,
+                                             FilterObservationPredicate fop, size_t queue_capacity,
+                                             const StepRecord* step_record = nullptr)
+              : stepOnFunctor_{std::move(af)},
+                surfaceCrossObserver_{std::move(sf)},
+                sink_{std::move(sink)},
+                validCrossingPredicate_{std::move(fop)},
+                step_record_{step_record},
+                queue_{queue_capacity},
+                consumer_{&PipelinedProjectOnSurfaceObserver::consume, this}
+          { }
+
+          /// \brief the consumer thread refers to the observer, so it can be neither copied nor moved
+          PipelinedProjectOnSurfaceObserver (const PipelinedProjectOnSurfaceObserver&) = delete;
+          PipelinedProjectOnSurfaceObserver& operator= (const PipelinedProjectOnSurfaceObserver&) = delete;
+
+          /// \brief waits for the queued crossings, dropping any exception; call finish() to see it
+          ~PipelinedProjectOnSurfaceObserver ()
+          {
+            stop();
+          }
+
+          template<unsigned N, unsigned DOF>
+          bool operator() (const Geometry::State<N, DOF>& s, double t)
+          {
+            if (finished_)
+              throw std::logic_error("PipelinedProjectOnSurfaceObserver: the observer has finished");
+
+            if (surfaceCrossObserver_(Geometry::PhaseSpaceState<DOF>{s}))
+              {
+                const Crossing crossing{ActionStateType{s}, t, surfaceCrossObserver_.distance(),
+                                        step_record_ ? *step_record_ : StepRecord{}};
+                while (!queue_.try_push(crossing))
+                  std::this_thread::yield();
+                wake_consumer();
+              }
+
+            return false;
+          }
+
+          template<typename StateType, typename TimeType>
+          bool operator() (const std::pair<StateType, TimeType>& s_t)
+          {
+            const auto&[s, t] = s_t;
+            return operator()(s, t);
+          }
+
+          /// \brief waits until all the detected crossings have reached the sink, and rethrows the first exception
+          /// thrown by the step on functor, the predicate or the sink. The observer takes no states afterwards.
+          void finish ()
+          {
+            stop();
+
+            if (error_)
+              std::rethrow_exception(std::exchange(error_, nullptr));
+          }
+
+          /// \brief only after finish()
+          const Sink& sink () const noexcept
+          {
+            return sink_;
+          }
+
+          /// \brief only after finish(), and only for sinks that store the crossings, like PushBackObserver
+          auto observations () const noexcept
+          {
+            return sink_.observations();
+          }
+        };
+    }
+
+    /// \brief The pipelined counterpart of make_project_on_line_observer_to_sink: the crossings of line are stepped
+    /// back onto it, filtered and handed to sink on a second thread, see Observer::PipelinedProjectOnSurfaceObserver.
+    ///
+    /// Worth it on long runs whose crossings are expensive to post process, e.g. with a costly predicate or sink.
+    /// Call finish() on the observer after the integration.
+    /// \param queue_capacity the number of detected crossings that may wait for the second thread
+    /// \param step_record the step record of the observed range (see make_dynamic_system_integration_range), or null
+    template<typename StepperPolicy = Steppers::Default, typename DS, typename FP, typename Sink>
+    inline auto make_pipelined_project_on_line_observer (DS system, // not const &. may dangle
+                                                         const Geometry::Hyperplane<DS::degrees_of_freedom>& line,
+                                                         FP filteringPredicate,
+                                                         Sink sink,
+                                                         size_t queue_capacity = 1024,
+                                                         const Steppers::step_record_t<StepperPolicy>* step_record
+                                                         = nullptr)
+    {
+      using StepRecord = Steppers::step_record_t<StepperPolicy>;
+
+      auto action_functor =
+          [sys = std::move(system), direction = line.perpendicular_vector()]
+              (typename DS::action_state_type s, double t, double current_distance, const StepRecord* crossing_record)
+          {
+              return step_back<StepperPolicy>(sys, direction, s, t, current_distance, crossing_record);
+          };
+
+      using SurfaceCrossObserver = Geometry::HyperplaneCrossObserver<DS::degrees_of_freedom>;
+
+      return Observer::PipelinedProjectOnSurfaceObserver<decltype(action_functor), SurfaceCrossObserver, FP, Sink,
+                                                         typename DS::action_state_type, StepRecord>(
+          std::move(action_functor),
+          SurfaceCrossObserver(line),
+          std::move(sink),
+          std::move(filteringPredicate),
+          queue_capacity,
+          step_record);
+    }
+}
+
+#endif //HAMILTONIANS_PIPELINED_OBSERVER_HPP
@@ -0,0 +1,138 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_PREDICTIVE_CROSSINGS_HPP
+#define HAMILTONIANS_PREDICTIVE_CROSSINGS_HPP
+
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include <boost/range/algorithm/find_if.hpp>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    /// \brief The crossings of calculate_crossings_predictive
+    struct PredictedCrossings {
+        std::vector<Geometry::State2_Extended> crossings{};
+        /// \brief the period, if the orbit was recognized as periodic
+        std::optional<double> period{};
+        /// \brief the number of crossings found by integration; the rest are predicted
+        size_t integrated_crossings = 0;
+    };
+
+    /// \brief Like calculate_crossings, but once the orbit is recognized as periodic the crossings of the remaining
+    /// periods are predicted instead of integrated.
+    ///
+    /// The orbit is periodic once a crossing comes back to the first one, within options.distance_threshold as in
+    /// come_back_home_closed_orbit. The crossings of verification_periods further periods, possibly none, are
+    /// integrated and must repeat those of the first period, again within distance_threshold; the period and the action
+    /// per period are then measured over all the integrated periods, and every later crossing is a crossing of the first
+    /// period shifted by a whole number of periods in time and in action. If the orbit does not come back, or a verification fails, the
+    /// whole orbit is integrated, and the crossings are those of calculate_crossings.
+    ///
+    /// The predicted crossings carry the error of the period times the number of periods, where the integrated ones
+    /// carry the integration error accumulated along the orbit; both grow linearly with the time.
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    PredictedCrossings calculate_crossings_predictive (const Ham& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const Geometry::Line& cross_line,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options,
+                                                       size_t verification_periods = 1)
+    {
+      Geometry::State2_Action s_start_Action{s_start};
+
+      const auto system = Dynamics::DynamicSystem{hamiltonian};
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       &step_record);
+
+      PredictedCrossings result{};
+      auto& crossings = result.crossings;
+      crossings.reserve(options.expected_crossings);
+
+      const StateNear near{options.distance_threshold};
+      const auto integrated_periods = verification_periods + 1;
+      size_t crossings_per_period = 0;
+      bool periodic = true;
+      bool done = false;
+
+      auto sink = [&] (const Geometry::State2_Extended& crossing)
+      {
+          crossings.push_back(crossing);
+          if (!periodic)
+            return;
+
+          const auto i = crossings.size() - 1;
+          const Geometry::State2 s{crossing};
+
+          if (crossings_per_period == 0)
+            {
+              if (i > 0 && near(crossings.front(), s))
+                {
+                  crossings_per_period = i;
+                  done = integrated_periods == 1;
+                }
+            }
+          else if (near(crossings[i % crossings_per_period], s))
+            done = i == integrated_periods * crossings_per_period;
+          else
+            periodic = false;
+      };
+
+      auto observer = Integrators::make_project_on_line_observer_to_sink<StepperPolicy>(system, cross_line, [] (auto&)
+      { return true; }, sink, &step_record);
+
+      boost::range::find_if(integration_range, [&observer, &done] (const auto& s_t)
+      {
+          return observer(s_t) && done;
+      });
+
+      if (!done)
+        {
+          result.integrated_crossings = crossings.size();
+          return result;
+        }
+
+      // the last integrated crossing closes the last integrated period: it is predicted like the following ones
+      const auto first = crossings.front();
+      const auto last = crossings.back();
+      crossings.pop_back();
+      result.integrated_crossings = crossings.size();
+
+      const auto periods = static_cast<double>(integrated_periods);
+      const auto period = (last.t() - first.t()) / periods;
+      const auto action_per_period = (last.J() - first.J()) / periods;
+      result.period = period;
+
+      const auto t_end = integrationTime.t_end();
+      const auto remaining_periods = std::floor((t_end - first.t()) / period) + 1;
+      crossings.reserve(crossings_per_period * static_cast<size_t>(std::max(remaining_periods, periods)));
+
+      for (auto n = integrated_periods;; ++n)
+        for (size_t i = 0; i < crossings_per_period; ++i)
+          {
+            auto crossing = crossings[i];
+            crossing.t() += static_cast<double>(n) * period;
+            crossing.J() += static_cast<double>(n) * action_per_period;
+
+            if (crossing.t() > t_end)
+              return result;
+
+            crossings.push_back(crossing);
+          }
+    }
+}
+
+#endif //HAMILTONIANS_PREDICTIVE_CROSSINGS_HPP
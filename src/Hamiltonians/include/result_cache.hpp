@@ -0,0 +1,144 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_RESULT_CACHE_HPP
+#define HAMILTONIANS_RESULT_CACHE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "State.hpp"
+#include "IntegrationTimeInterval.hpp"
+#include "Integration.hpp"
+#include "action_angle.hpp"
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        /// \brief The serialized inputs of a query, and their stable 64 bit FNV-1a hash
+        class CacheKey {
+          std::vector<unsigned char> bytes_{};
+
+         public:
+          CacheKey& add (std::uint64_t value);
+          CacheKey& add (double value);
+          CacheKey& add (const std::string& value);
+          CacheKey& add (const std::vector<double>& values);
+
+          const std::vector<unsigned char>& bytes () const noexcept;
+          std::uint64_t hash () const noexcept;
+        };
+
+        /// \brief The version of the cached results, the first part of every key. Raise it whenever a change of the
+        /// library changes the result of a query for the same inputs, or the format of the entries, so that the entries
+        /// of earlier versions are never hit again; eviction removes them in time.
+        constexpr std::uint64_t result_cache_version = 1;
+
+        /// \brief the key of query (a name) on the orbit of s_start, with all the inputs that change its result. Ham and
+        /// StepperPolicy are identified by their names, which are stable across compilers and builds.
+        template<typename StepperPolicy, typename Ham>
+        CacheKey make_cache_key (const std::string& query,
+                                 const Ham& hamiltonian,
+                                 const Geometry::State2& s_start,
+                                 const TimeInterval& integrationTime,
+                                 const IntegrationOptions& options,
+                                 std::uint64_t number_of_angles)
+        {
+          const auto& dt_max = integrationTime.dt_max();
+
+          CacheKey key{};
+          key.add(result_cache_version)
+              .add(query)
+              .add(std::string{Ham::name})
+              .add(hamiltonian.parameters())
+              .add(std::string{StepperPolicy::name})
+              .add(s_start.q()).add(s_start.p())
+              .add(integrationTime.t_begin()).add(integrationTime.t_end())
+              .add(std::uint64_t{dt_max.has_value()}).add(dt_max.value_or(0.0))
+              .add(options.abs_err).add(options.rel_err)
+              .add(options.initial_time_step)
+              .add(options.distance_threshold)
+              .add(std::uint64_t{options.energy_projection_every})
+              .add(options.energy_drift_threshold)
+              .add(options.exact_flow_sampling_step)
+              .add(number_of_angles);
+          return key;
+        }
+    }
+
+    /// \brief A content addressed store of orbit results in a directory, shared by the processes of one machine.
+    ///
+    /// Every result is a file named after the hash of its key; the file holds the whole key too, so that a collision
+    /// is a miss. Files are written to a temporary name and renamed into place, so readers see either a complete
+    /// entry or none, and concurrent writers of the same entry simply replace each other's identical results. The
+    /// store is kept under max_bytes by removing the least recently used entries: a hit refreshes the modification
+    /// time of its file. Each ResultCache checks the size after it has written max_bytes / 16 bytes, so the store may
+    /// exceed max_bytes by that much per writing process. The temporary files that writers which crashed left behind
+    /// are removed once they are older than stale_temporary_age.
+    ///
+    /// One ResultCache may be shared by the threads of a process: the count of the bytes written is atomic, and all
+    /// the rest goes through the file system, as between processes.
+    class ResultCache {
+      std::filesystem::path directory_;
+      std::uintmax_t max_bytes_;
+      std::atomic<std::uintmax_t> bytes_since_eviction_{0};
+      std::atomic<bool> evicted_{false};
+
+      std::filesystem::path entry_path (const Internals::CacheKey& key) const;
+
+     public:
+      /// \brief a temporary file that has not been renamed into an entry for this long belongs to a crashed writer
+      static constexpr std::chrono::minutes stale_temporary_age{10};
+
+      /// \param directory created if it does not exist
+      explicit ResultCache (std::filesystem::path directory, std::uintmax_t max_bytes = std::uintmax_t{1} << 30u);
+
+      std::optional<ActionAngleOrbit> load (const Internals::CacheKey& key) const;
+      void store (const Internals::CacheKey& key, const ActionAngleOrbit& orbit);
+
+      /// \brief removes the stale temporary files, and then the least recently used entries, until the store takes at
+      /// most max_bytes
+      void evict ();
+
+      const std::filesystem::path& directory () const noexcept;
+      std::uintmax_t max_bytes () const noexcept;
+    };
+
+    /// \brief calculate_action_angle_on_closed_orbit, memoized in cache: a hit returns the stored result without
+    /// integrating. Ham must provide parameters(), the numbers that define it.
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    ActionAngleOrbit calculate_action_angle_on_closed_orbit (ResultCache& cache,
+                                                             Ham hamiltonian,
+                                                             const Geometry::State2& s_start,
+                                                             const TimeInterval& integrationTime,
+                                                             const IntegrationOptions& options,
+                                                             size_t number_of_angles = 100)
+    {
+      const auto key = Internals::make_cache_key<StepperPolicy>("action_angle_on_closed_orbit",
+                                                                hamiltonian,
+                                                                s_start,
+                                                                integrationTime,
+                                                                options,
+                                                                number_of_angles);
+
+      if (auto cached = cache.load(key))
+        return std::move(*cached);
+
+      auto orbit = calculate_action_angle_on_closed_orbit<StepperPolicy>(hamiltonian,
+                                                                         s_start,
+                                                                         integrationTime,
+                                                                         options,
+                                                                         number_of_angles);
+      cache.store(key, orbit);
+      return orbit;
+    }
+}
+
+#endif //HAMILTONIANS_RESULT_CACHE_HPP
@@ -0,0 +1,42 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_REVERSING_SYMMETRY_HPP
+#define HAMILTONIANS_REVERSING_SYMMETRY_HPP
+
+#include "State.hpp"
+#include "line.hpp"
+
+namespace Integrators
+{
+    namespace Geometry
+    {
+
+        /// \brief A reversing symmetry R of a Hamiltonian flow, i.e. a reflection that satisfies
+        /// R(phi_t(s)) = phi_{-t}(R(s)).
+        ///
+        /// The symmetry is described by its line of fixed points. A closed orbit that is invariant under R crosses
+        /// the fixed line exactly twice per period, and the two halves of the orbit between the crossings are mirror
+        /// images of each other. Hence, both the period and the action of the orbit can be reconstructed from the half
+        /// orbit.
+        class ReversingSymmetry {
+          Line fixed_line_;
+         public:
+          explicit ReversingSymmetry (Line fixed_line) noexcept;
+
+          /// \brief (q,p) -> (q,-p). It is a reversing symmetry of every Hamiltonian that is even in p, e.g. the
+          /// pendulum, the harmonic oscillator and the Duffing model.
+          static ReversingSymmetry momentum_reversal ();
+
+          /// \brief (q,p) -> (-q,p). It is a reversing symmetry of every Hamiltonian that is even in q.
+          static ReversingSymmetry position_reversal ();
+
+          const Line& fixed_line () const noexcept;
+
+          /// \brief reflects s across the fixed line
+          State2 operator() (const State2& s) const noexcept;
+        };
+    }
+}
+#endif //HAMILTONIANS_REVERSING_SYMMETRY_HPP
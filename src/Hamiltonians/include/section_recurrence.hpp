@@ -0,0 +1,278 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_SECTION_RECURRENCE_HPP
+#define HAMILTONIANS_SECTION_RECURRENCE_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/range/algorithm/find_if.hpp>
+
+#include "State.hpp"
+#include "line.hpp"
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    /// \brief An incremental index of points of the phase space, for the neighbours within a fixed radius.
+    ///
+    /// The points are hashed into a uniform grid of cells of the size of the radius, so a query looks at the 3^(2 DOF)
+    /// cells around its point, and both insertions and queries take expected constant time, whatever the number of
+    /// points.
+    template<unsigned DOF>
+    class CrossingIndex {
+     public:
+      using point_type = Geometry::PhaseSpaceState<DOF>;
+      static constexpr unsigned dimension = point_type::dimension;
+
+     private:
+      using cell_type = std::array<std::int64_t, dimension>;
+
+      struct CellHash {
+          size_t operator() (const cell_type& cell) const noexcept
+          {
+            std::uint64_t hash = 14695981039346656037ull;
+            for (const auto c: cell)
+              {
+                hash ^= static_cast<std::uint64_t>(c);
+                hash *= 1099511628211ull;
+              }
+            return hash ^ (hash >> 32u);
+          }
+      };
+
+      double radius_;
+      std::vector<point_type> points_{};
+      std::unordered_map<cell_type, std::vector<size_t>, CellHash> cells_{};
+
+      cell_type cell_of (const point_type& s) const noexcept
+      {
+        cell_type cell{};
+        for (unsigned i = 0; i < dimension; ++i)
+          cell[i] = static_cast<std::int64_t>(std::floor(s[i] / radius_));
+        return cell;
+      }
+
+     public:
+      /// \param radius two points are neighbours if they are at most radius apart
+      explicit CrossingIndex (double radius)
+          : radius_{radius}
+      {
+        if (!(radius > 0))
+          throw std::invalid_argument("CrossingIndex: the radius must be positive");
+      }
+
+      /// \return the index of s, i.e. the number of points inserted before it
+      size_t insert (const point_type& s)
+      {
+        points_.push_back(s);
+        cells_[cell_of(s)].push_back(points_.size() - 1);
+        return points_.size() - 1;
+      }
+
+      /// \brief the index of the nearest point within radius of s, if there is one
+      std::optional<size_t> nearest (const point_type& s) const
+      {
+        const auto center = cell_of(s);
+
+        std::optional<size_t> nearest{};
+        double nearest_distance = radius_;
+
+        size_t number_of_neighbour_cells = 1;
+        for (unsigned i = 0; i < dimension; ++i)
+          number_of_neighbour_cells *= 3;
+
+        for (size_t offsets = 0; offsets < number_of_neighbour_cells; ++offsets)
+          {
+            auto cell = center;
+            auto digits = offsets;
+            for (unsigned i = 0; i < dimension; ++i, digits /= 3)
+              cell[i] += static_cast<std::int64_t>(digits % 3) - 1;
+
+            const auto found = cells_.find(cell);
+            if (found == cells_.end())
+              continue;
+
+            for (const auto index: found->second)
+              {
+                const auto distance = magnitude(points_[index] - s);
+                if (distance <= nearest_distance)
+                  {
+                    nearest = index;
+                    nearest_distance = distance;
+                  }
+              }
+          }
+
+        return nearest;
+      }
+
+      const point_type& operator[] (size_t index) const noexcept
+      {
+        return points_[index];
+      }
+
+      size_t size () const noexcept
+      {
+        return points_.size();
+      }
+
+      /// \brief the number of cells holding points, a measure of the part of the section covered
+      size_t occupied_cells () const noexcept
+      {
+        return cells_.size();
+      }
+
+      double radius () const noexcept
+      {
+        return radius_;
+      }
+    };
+
+    extern template class CrossingIndex<1>;
+    extern template class CrossingIndex<2>;
+
+    /// \brief When calculate_section_recurrences stops integrating
+    enum class RecurrenceStop {
+        /// \brief at the end of the time interval
+        never,
+        /// \brief at the first crossing that comes within radius of an earlier one: the orbit has closed after
+        /// Recurrence::turns crossings
+        first_recurrence,
+        /// \brief once coverage_window successive crossings have all come within radius of earlier ones: the orbit
+        /// has covered its part of the section, to the resolution of radius
+        dense_coverage
+    };
+
+    struct RecurrenceOptions {
+        /// \brief two crossings recur if they are at most radius apart
+        double radius = 1e-6;
+        RecurrenceStop stop = RecurrenceStop::first_recurrence;
+        size_t coverage_window = 1000;
+    };
+
+    /// \brief A crossing that came within the radius of an earlier one
+    struct Recurrence {
+        /// \brief the indices of the earlier and of the recurring crossing
+        size_t earlier = 0;
+        size_t index = 0;
+        /// \brief the number of crossings between the two, e.g. k for an orbit of period k
+        size_t turns = 0;
+        /// \brief the time and the action between the two crossings
+        double time = 0;
+        double action = 0;
+    };
+
+    template<unsigned DOF>
+    struct SectionRecurrences {
+        std::vector<Geometry::ExtendedState<DOF>> crossings{};
+        std::optional<Recurrence> first_recurrence{};
+        /// \brief the number of crossings within radius of an earlier crossing
+        size_t recurrent_crossings = 0;
+        /// \brief the number of grid cells of size radius visited by the crossings
+        size_t occupied_cells = 0;
+        bool densely_covered = false;
+
+        /// \brief the fraction of the crossings that recur
+        double recurrence_rate () const noexcept
+        {
+          return crossings.empty() ? 0 : static_cast<double>(recurrent_crossings)
+                                         / static_cast<double>(crossings.size());
+        }
+    };
+
+    /// \brief The crossings of cross_line by the orbit starting at s_start, each compared, as it is found, with all the
+    /// earlier ones through a CrossingIndex.
+    ///
+    /// Unlike come_back_home_closed_orbit, which compares every crossing with s_start only, this recognizes orbits
+    /// that close after several turns, or that come back near any of their earlier crossings, in expected constant
+    /// time per crossing; see RecurrenceStop for when the integration stops.
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    SectionRecurrences<Hamiltonian::degrees_of_freedom_v<Ham>>
+    calculate_section_recurrences (const Ham& hamiltonian,
+                                   const Geometry::PhaseSpaceState<Hamiltonian::degrees_of_freedom_v<Ham>>& s_start,
+                                   const Geometry::Hyperplane<Hamiltonian::degrees_of_freedom_v<Ham>>& cross_line,
+                                   const TimeInterval& integrationTime,
+                                   const IntegrationOptions& options,
+                                   const RecurrenceOptions& recurrence_options = RecurrenceOptions{})
+    {
+      constexpr auto DOF = Hamiltonian::degrees_of_freedom_v<Ham>;
+
+      Geometry::ActionState<DOF> s_start_Action{s_start};
+
+      const auto system = Dynamics::DynamicSystem{hamiltonian};
+      Steppers::step_record_t<StepperPolicy> step_record{};
+      const auto integration_range = Integrators::make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                                       s_start_Action,
+                                                                                                       integrationTime,
+                                                                                                       options,
+                                                                                                       &step_record);
+
+      SectionRecurrences<DOF> result{};
+      result.crossings.reserve(options.expected_crossings);
+
+      CrossingIndex<DOF> index{recurrence_options.radius};
+      size_t recurrent_in_a_row = 0;
+      bool done = false;
+
+      auto sink = [&] (const Geometry::ExtendedState<DOF>& crossing)
+      {
+          const Geometry::PhaseSpaceState<DOF> s{crossing};
+          const auto earlier = index.nearest(s);
+          const auto i = index.insert(s);
+          result.crossings.push_back(crossing);
+
+          if (!earlier)
+            {
+              recurrent_in_a_row = 0;
+              return;
+            }
+
+          ++result.recurrent_crossings;
+          ++recurrent_in_a_row;
+
+          if (!result.first_recurrence)
+            {
+              const auto& previous = result.crossings[*earlier];
+              result.first_recurrence = Recurrence{*earlier, i, i - *earlier, crossing.t() - previous.t(),
+                                                   crossing.J() - previous.J()};
+            }
+
+          result.densely_covered = recurrent_in_a_row >= recurrence_options.coverage_window;
+
+          switch (recurrence_options.stop)
+            {
+              case RecurrenceStop::never:
+                break;
+              case RecurrenceStop::first_recurrence:
+                done = true;
+              break;
+              case RecurrenceStop::dense_coverage:
+                done = result.densely_covered;
+              break;
+            }
+      };
+
+      auto observer = Integrators::make_project_on_line_observer_to_sink<StepperPolicy>(system, cross_line, [] (auto&)
+      { return true; }, sink, &step_record);
+
+      boost::range::find_if(integration_range, [&observer, &done] (const auto& s_t)
+      {
+          return observer(s_t) && done;
+      });
+
+      result.occupied_cells = index.occupied_cells();
+      return result;
+    }
+}
+
+#endif //HAMILTONIANS_SECTION_RECURRENCE_HPP
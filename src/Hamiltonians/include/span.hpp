@@ -0,0 +1,93 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_SPAN_HPP
+#define HAMILTONIANS_SPAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Integrators
+{
+    /// \brief A non owning view of a contiguous sequence of T, to be replaced by std::span once the project moves to
+    /// C++20.
+    template<typename T>
+    class Span {
+      T* data_ = nullptr;
+      size_t size_ = 0;
+     public:
+      using value_type = std::remove_cv_t<T>;
+
+      Span () = default;
+
+      Span (T* data, size_t size) noexcept
+          : data_{data}, size_{size}
+      { }
+
+      template<typename U, typename = std::enable_if_t<std::is_same_v<value_type, U>>>
+      Span (std::vector<U>& v) noexcept
+          : data_{v.data()}, size_{v.size()}
+      { }
+
+      template<typename U, typename = std::enable_if_t<std::is_same_v<value_type, U> && std::is_const_v<T>>>
+      Span (const std::vector<U>& v) noexcept
+          : data_{v.data()}, size_{v.size()}
+      { }
+
+      template<typename U, size_t N, typename = std::enable_if_t<std::is_same_v<value_type, U>>>
+      Span (std::array<U, N>& a) noexcept
+          : data_{a.data()}, size_{N}
+      { }
+
+      template<typename U, size_t N, typename = std::enable_if_t<std::is_same_v<value_type, U> && std::is_const_v<T>>>
+      Span (const std::array<U, N>& a) noexcept
+          : data_{a.data()}, size_{N}
+      { }
+
+      /// \brief a mutable span converts to a const one
+      template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+      Span (const Span<U>& other) noexcept
+          : data_{other.data()}, size_{other.size()}
+      { }
+
+      T* data () const noexcept
+      {
+        return data_;
+      }
+
+      size_t size () const noexcept
+      {
+        return size_;
+      }
+
+      bool empty () const noexcept
+      {
+        return size_ == 0;
+      }
+
+      T& operator[] (size_t i) const noexcept
+      {
+        return data_[i];
+      }
+
+      T* begin () const noexcept
+      {
+        return data_;
+      }
+
+      T* end () const noexcept
+      {
+        return data_ + size_;
+      }
+
+      Span subspan (size_t offset, size_t count) const noexcept
+      {
+        return Span{data_ + offset, count};
+      }
+    };
+}
+
+#endif //HAMILTONIANS_SPAN_HPP
@@ -0,0 +1,143 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_STATE_ALGEBRA_HPP
+#define HAMILTONIANS_STATE_ALGEBRA_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include <boost/numeric/odeint/algebra/default_operations.hpp>
+
+#include "State.hpp"
+
+namespace Integrators
+{
+    namespace Geometry
+    {
+
+        /// \brief odeint algebra for State<N>.
+        ///
+        /// With vector_space_algebra, odeint applies the operations on whole States, so every Runge-Kutta stage is
+        /// evaluated as a chain of State expressions, each of them with its own temporary and its own loop.
+        /// StateAlgebra applies the operations coordinate-wise instead: a stage becomes a single pass over the N
+        /// coordinates, which is unrolled at compile time, and the linear combination of every coordinate is one scalar
+        /// expression that the compiler can contract to fused multiply-adds.
+        struct StateAlgebra {
+
+          template<typename S1, typename Op>
+          static void for_each1 (S1& s1, Op op)
+          { apply(op, s1); }
+
+          template<typename S1, typename S2, typename Op>
+          static void for_each2 (S1& s1, S2& s2, Op op)
+          { apply(op, s1, s2); }
+
+          template<typename S1, typename S2, typename S3, typename Op>
+          static void for_each3 (S1& s1, S2& s2, S3& s3, Op op)
+          { apply(op, s1, s2, s3); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename Op>
+          static void for_each4 (S1& s1, S2& s2, S3& s3, S4& s4, Op op)
+          { apply(op, s1, s2, s3, s4); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename Op>
+          static void for_each5 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, Op op)
+          { apply(op, s1, s2, s3, s4, s5); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename Op>
+          static void for_each6 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename Op>
+          static void for_each7 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename Op>
+          static void for_each8 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename S9, typename Op>
+          static void for_each9 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, S9& s9, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8, s9); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename S9, typename S10, typename Op>
+          static void for_each10 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, S9& s9, S10& s10,
+                                  Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename S9, typename S10, typename S11, typename Op>
+          static void for_each11 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, S9& s9, S10& s10,
+                                  S11& s11, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename S9, typename S10, typename S11, typename S12, typename Op>
+          static void for_each12 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, S9& s9, S10& s10,
+                                  S11& s11, S12& s12, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename S9, typename S10, typename S11, typename S12, typename S13, typename Op>
+          static void for_each13 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, S9& s9, S10& s10,
+                                  S11& s11, S12& s12, S13& s13, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename S9, typename S10, typename S11, typename S12, typename S13, typename S14,
+              typename Op>
+          static void for_each14 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, S9& s9, S10& s10,
+                                  S11& s11, S12& s12, S13& s13, S14& s14, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14); }
+
+          template<typename S1, typename S2, typename S3, typename S4, typename S5, typename S6, typename S7,
+              typename S8, typename S9, typename S10, typename S11, typename S12, typename S13, typename S14,
+              typename S15, typename Op>
+          static void for_each15 (S1& s1, S2& s2, S3& s3, S4& s4, S5& s5, S6& s6, S7& s7, S8& s8, S9& s9, S10& s10,
+                                  S11& s11, S12& s12, S13& s13, S14& s14, S15& s15, Op op)
+          { apply(op, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15); }
+
+          template<typename S>
+          static double norm_inf (const S& s) noexcept
+          {
+            double norm = 0;
+            for (unsigned i = 0; i < S::dimension; ++i)
+              norm = std::max(norm, std::abs(s[i]));
+            return norm;
+          }
+
+         private:
+
+          template<typename Op, typename S1, typename... S>
+          static void apply (Op& op, S1& s1, S& ... s)
+          {
+            using state_type = std::remove_const_t<S1>;
+            apply_coordinatewise(op, std::make_integer_sequence<unsigned, state_type::dimension>{}, s1, s...);
+          }
+
+          template<typename Op, unsigned... I, typename... S>
+          static void apply_coordinatewise (Op& op, std::integer_sequence<unsigned, I...>, S& ... s)
+          {
+            const auto apply_on_coordinate = [&op, &s...] (auto i)
+            { op(s[i]...); };
+
+            (apply_on_coordinate(std::integral_constant<unsigned, I>{}), ...);
+          }
+        };
+
+        /// \brief odeint operations for StateAlgebra.
+        ///
+        /// Under StateAlgebra the operations act on single coordinates, where odeint's default operations already
+        /// evaluate a Runge-Kutta stage as one scalar linear combination.
+        using StateOperations = boost::numeric::odeint::default_operations;
+    }
+}
+#endif //HAMILTONIANS_STATE_ALGEBRA_HPP
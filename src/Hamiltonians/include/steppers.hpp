@@ -0,0 +1,259 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_STEPPERS_HPP
+#define HAMILTONIANS_STEPPERS_HPP
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <boost/numeric/odeint.hpp>
+
+#include "state_algebra.hpp"
+#include "taylor.hpp"
+
+namespace Integrators
+{
+    /// \brief Stepper policies for the integration functions.
+    ///
+    /// A stepper policy provides
+    ///   - error_stepper_type<StateType>: the explicit stepper used for the single steps onto a surface (see step_back)
+    ///   - make_controlled<StateType>(system, abs_err, rel_err[, dt_max]): the controlled stepper driving the integration
+    ///     ranges. Steppers that exploit the structure of the dynamic system (see Taylor) keep a copy of it.
+    ///   - optionally step_back(system, direction, s, t, distance): replaces the single step of error_stepper_type onto a
+    ///     surface (see Integrators::step_back)
+    ///   - optionally step_record_type: what the controlled stepper keeps of its last step for step_back. The caller
+    ///     owns the record and passes it to make_controlled(system, abs_err, rel_err[, dt_max], step_record) and to
+    ///     step_back(system, direction, s, t, distance, step_record), so that orbits integrated side by side, or
+    ///     stepped back on another thread, never share it (see step_record_t)
+    ///
+    /// Every integration function takes the policy as its first template parameter, defaulting to Steppers::Default,
+    /// so that the stepper is fixed at compile time and the inner loops are fully inlined. The functions that used to
+    /// take the Hamiltonian (or the dynamic system) as their first template parameter still accept it there, followed
+    /// by an optional policy, e.g. calculate_crossings<Ham>(...) or calculate_crossings<Ham, Steppers::Fehlberg78>(...).
+    /// All steppers use Geometry::StateAlgebra, i.e. their stages are evaluated coordinate-wise without State
+    /// temporaries.
+    ///
+    /// Every policy has a name, stable across compilers and builds, for the fingerprints of checkpoints and the keys of
+    /// cached results.
+    namespace Steppers
+    {
+        namespace Internals
+        {
+            template<template<typename> class ErrorStepper>
+            struct ErrorStepperPolicy {
+
+                template<typename StateType>
+                using error_stepper_type = ErrorStepper<StateType>;
+
+                template<typename StateType, typename DS>
+                static auto make_controlled (const DS& /*system*/, double abs_err, double rel_err)
+                {
+                  return boost::numeric::odeint::make_controlled(abs_err, rel_err, error_stepper_type<StateType>());
+                }
+
+                template<typename StateType, typename DS>
+                static auto make_controlled (const DS& /*system*/, double abs_err, double rel_err, double dt_max)
+                {
+                  return boost::numeric::odeint::make_controlled(abs_err,
+                                                                 rel_err,
+                                                                 dt_max,
+                                                                 error_stepper_type<StateType>());
+                }
+            };
+
+            template<typename StateType>
+            using cash_karp54_type = boost::numeric::odeint::runge_kutta_cash_karp54<StateType, double, StateType,
+                double, Geometry::StateAlgebra, Geometry::StateOperations>;
+
+            template<typename StateType>
+            using dopri5_type = boost::numeric::odeint::runge_kutta_dopri5<StateType, double, StateType,
+                double, Geometry::StateAlgebra, Geometry::StateOperations>;
+
+            template<typename StateType>
+            using fehlberg78_type = boost::numeric::odeint::runge_kutta_fehlberg78<StateType, double, StateType,
+                double, Geometry::StateAlgebra, Geometry::StateOperations>;
+        }
+
+        /// \brief Cash-Karp 5(4)
+        struct CashKarp54: Internals::ErrorStepperPolicy<Internals::cash_karp54_type> {
+            static constexpr const char* name = "cash_karp54";
+        };
+
+        /// \brief Dormand-Prince 5(4). First same as last, i.e. one evaluation of the system less per step.
+        struct DormandPrince5: Internals::ErrorStepperPolicy<Internals::dopri5_type> {
+            static constexpr const char* name = "dormand_prince5";
+        };
+
+        /// \brief Runge-Kutta-Fehlberg 7(8). Takes much larger steps at tight tolerances.
+        struct Fehlberg78: Internals::ErrorStepperPolicy<Internals::fehlberg78_type> {
+            static constexpr const char* name = "fehlberg78";
+        };
+
+        /// \brief Bulirsch-Stoer extrapolation.
+        ///
+        /// Bulirsch-Stoer is a controlled stepper by itself. It has no single step method, so the steps onto a
+        /// surface are carried out with Fehlberg 7(8). Its steps may cover a large part of an orbit, which makes the
+        /// single step onto a surface inaccurate; bound them with the dt_max of the TimeInterval.
+        ///
+        /// Unlike the other policies it allocates on every step: odeint's bulirsch_stoer keeps its step size
+        /// estimates in vectors local to try_step.
+        struct BulirschStoer {
+
+            static constexpr const char* name = "bulirsch_stoer";
+
+            template<typename StateType>
+            using error_stepper_type = Internals::fehlberg78_type<StateType>;
+
+            template<typename StateType>
+            using controlled_stepper_type = boost::numeric::odeint::bulirsch_stoer<StateType, double, StateType,
+                double, Geometry::StateAlgebra, Geometry::StateOperations>;
+
+            template<typename StateType, typename DS>
+            static auto make_controlled (const DS& /*system*/, double abs_err, double rel_err)
+            {
+              return controlled_stepper_type<StateType>(abs_err, rel_err);
+            }
+
+            template<typename StateType, typename DS>
+            static auto make_controlled (const DS& /*system*/, double abs_err, double rel_err, double dt_max)
+            {
+              return controlled_stepper_type<StateType>(abs_err, rel_err, 1.0, 1.0, dt_max);
+            }
+        };
+
+        /// \brief Taylor series of adaptive order and step, for Hamiltonians with a polynomial derivative
+        /// (see Hamiltonian::has_polynomial_derivative and Taylor::TaylorStepper).
+        ///
+        /// At tight tolerances its steps are many times larger than those of the Runge-Kutta steppers. The steps onto a
+        /// surface are taken along the Taylor series of the orbit, since a single Runge-Kutta step of that size is
+        /// inaccurate.
+        struct Taylor {
+
+            static constexpr const char* name = "taylor";
+
+            template<typename StateType>
+            using error_stepper_type = Internals::fehlberg78_type<StateType>;
+
+            using step_record_type = Integrators::Taylor::StepRecord;
+
+            template<typename StateType, typename DS>
+            static auto make_controlled (const DS& system, double abs_err, double rel_err)
+            {
+              return Integrators::Taylor::TaylorStepper<StateType, DS>(system, abs_err, rel_err);
+            }
+
+            template<typename StateType, typename DS>
+            static auto make_controlled (const DS& system, double abs_err, double rel_err, double dt_max)
+            {
+              return Integrators::Taylor::TaylorStepper<StateType, DS>(system, abs_err, rel_err, dt_max);
+            }
+
+            template<typename StateType, typename DS>
+            static auto make_controlled (const DS& system, double abs_err, double rel_err,
+                                         step_record_type* step_record)
+            {
+              return Integrators::Taylor::TaylorStepper<StateType, DS>(system,
+                                                                       abs_err,
+                                                                       rel_err,
+                                                                       std::numeric_limits<double>::infinity(),
+                                                                       step_record);
+            }
+
+            template<typename StateType, typename DS>
+            static auto make_controlled (const DS& system, double abs_err, double rel_err, double dt_max,
+                                         step_record_type* step_record)
+            {
+              return Integrators::Taylor::TaylorStepper<StateType, DS>(system, abs_err, rel_err, dt_max, step_record);
+            }
+
+            template<typename DS>
+            static Geometry::State2_Extended step_back (const DS& system,
+                                                        const Geometry::State2 direction,
+                                                        const Geometry::State2_Action& s,
+                                                        double t,
+                                                        double distance,
+                                                        const step_record_type* step_record = nullptr)
+            {
+              return Integrators::Taylor::step_back(system, direction, s, t, distance, step_record);
+            }
+        };
+
+        namespace Internals
+        {
+            template<typename StepperPolicy, typename DS, typename = void>
+            struct has_step_back: std::false_type {
+            };
+
+            template<typename StepperPolicy, typename DS>
+            struct has_step_back<StepperPolicy, DS, std::void_t<decltype(StepperPolicy::step_back(
+                std::declval<const DS&>(),
+                std::declval<Geometry::State2>(),
+                std::declval<const Geometry::State2_Action&>(),
+                0.0,
+                0.0))> >: std::true_type {
+            };
+        }
+
+        /// \brief the step record of the policies without a step_record_type: they keep nothing of their steps
+        struct NoStepRecord {
+        };
+
+        namespace Internals
+        {
+            template<typename StepperPolicy, typename = void>
+            struct step_record {
+                using type = NoStepRecord;
+            };
+
+            template<typename StepperPolicy>
+            struct step_record<StepperPolicy, std::void_t<typename StepperPolicy::step_record_type> > {
+                using type = typename StepperPolicy::step_record_type;
+            };
+        }
+
+        /// \brief what the controlled steppers of StepperPolicy keep of their last step for its step_back, or
+        /// NoStepRecord
+        template<typename StepperPolicy>
+        using step_record_t = typename Internals::step_record<StepperPolicy>::type;
+
+        /// \brief true if StepperPolicy keeps a record of the last step for its step_back
+        template<typename StepperPolicy>
+        constexpr bool has_step_record_v = !std::is_same_v<step_record_t<StepperPolicy>, NoStepRecord>;
+
+        namespace Internals
+        {
+            template<typename T, typename = void>
+            struct is_stepper_policy: std::false_type {
+            };
+
+            template<typename T>
+            struct is_stepper_policy<T, std::void_t<typename T::template error_stepper_type<Geometry::State2> > >
+                : std::true_type {
+            };
+        }
+
+        /// \brief true if T is a stepper policy, i.e. provides error_stepper_type
+        template<typename T>
+        constexpr bool is_stepper_policy_v = Internals::is_stepper_policy<T>::value;
+
+        /// \brief removes an integration function from overload resolution unless StepperPolicy is a stepper policy,
+        /// so that a Hamiltonian named as the first template parameter selects the overload taking it there
+        template<typename StepperPolicy>
+        using enable_if_policy_t = std::enable_if_t<is_stepper_policy_v<StepperPolicy> >;
+
+        /// \brief the counterpart of enable_if_policy_t, for the overloads taking a Hamiltonian or a dynamic system as
+        /// their first template parameter
+        template<typename T, typename StepperPolicy>
+        using enable_if_not_policy_t = std::enable_if_t<!is_stepper_policy_v<T> && is_stepper_policy_v<StepperPolicy> >;
+
+        /// \brief true if StepperPolicy replaces the single step onto a surface with its own step_back
+        template<typename StepperPolicy, typename DS>
+        constexpr bool has_step_back_v = Internals::has_step_back<StepperPolicy, DS>::value;
+
+        using Default = CashKarp54;
+    }
+}
+#endif //HAMILTONIANS_STEPPERS_HPP
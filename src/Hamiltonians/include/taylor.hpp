@@ -0,0 +1,586 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_TAYLOR_HPP
+#define HAMILTONIANS_TAYLOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/numeric/odeint/stepper/controlled_step_result.hpp>
+#include <boost/numeric/odeint/stepper/stepper_categories.hpp>
+
+#include "State.hpp"
+#include "Hamiltonian.hpp"
+
+namespace Integrators
+{
+    namespace Taylor
+    {
+        class Tape;
+
+        /// \brief A node of a Tape. Arithmetic on Variables records the operations on the tape.
+        class Variable {
+          friend class Tape;
+          Tape* tape_ = nullptr;
+          size_t index_ = 0;
+
+          Variable (Tape* tape, size_t index) noexcept
+              : tape_{tape}, index_{index}
+          { }
+         public:
+          Variable () = default;
+
+          size_t index () const noexcept
+          {
+            return index_;
+          }
+
+          friend Variable operator+ (const Variable& a, const Variable& b);
+          friend Variable operator- (const Variable& a, const Variable& b);
+          friend Variable operator* (const Variable& a, const Variable& b);
+          friend Variable operator+ (const Variable& a, double c);
+          friend Variable operator* (double c, const Variable& a);
+          friend Variable operator- (const Variable& a);
+        };
+
+        /// \brief Records the arithmetic of a polynomial vector field and evaluates the Taylor coefficients of its
+        /// intermediate results one order at a time.
+        ///
+        /// After the coefficients of order 0..k-1 of every node are known, coefficient(node, k) of a product costs k+1
+        /// multiplications (the Cauchy product), while sums and scalings cost one operation. The Taylor coefficients of
+        /// an orbit up to order K are therefore calculated in O(K^2) operations, instead of the O(K^3) of a straight
+        /// truncated power series arithmetic.
+        ///
+        /// The nodes and the coefficients are stored in fixed-size arrays, so that neither recording a vector field nor
+        /// copying a tape allocates.
+        class Tape {
+         public:
+          enum class Operation {
+              input, constant, add, subtract, multiply, add_constant, scale
+          };
+
+          static constexpr size_t max_order = 40;
+          /// \brief the maximum number of nodes, i.e. of inputs, constants and operations
+          static constexpr size_t capacity = 64;
+
+         private:
+          struct Node {
+              Operation operation = Operation::input;
+              size_t a = 0;
+              size_t b = 0;
+              double c = 0;
+          };
+
+          std::array<Node, capacity> nodes_{};
+          size_t number_of_nodes_ = 0;
+          std::array<std::array<double, max_order + 1>, capacity> coefficients_{};
+
+          Variable push (Operation operation, size_t a, size_t b, double c)
+          {
+            if (number_of_nodes_ == capacity)
+              throw std::length_error("Taylor::Tape: the vector field needs more than Tape::capacity nodes");
+
+            nodes_[number_of_nodes_] = Node{operation, a, b, c};
+            return Variable{this, number_of_nodes_++};
+          }
+
+         public:
+
+          Variable input ()
+          {
+            return push(Operation::input, 0, 0, 0);
+          }
+
+          Variable constant (double c)
+          {
+            return push(Operation::constant, 0, 0, c);
+          }
+
+          Variable record (Operation operation, const Variable& a, const Variable& b)
+          {
+            return push(operation, a.index(), b.index(), 0);
+          }
+
+          Variable record (Operation operation, const Variable& a, double c)
+          {
+            return push(operation, a.index(), 0, c);
+          }
+
+          double& coefficient (size_t node, size_t order) noexcept
+          {
+            return coefficients_[node][order];
+          }
+
+          double coefficient (size_t node, size_t order) const noexcept
+          {
+            return coefficients_[node][order];
+          }
+
+          /// \brief calculates the coefficient of order k of every node, except for the inputs.
+          /// The coefficients of order 0..k of the inputs and 0..k-1 of the rest of the nodes must be known.
+          void evaluate (size_t k) noexcept
+          {
+            for (size_t i = 0; i < number_of_nodes_; ++i)
+              {
+                const auto& node = nodes_[i];
+                const double* a = coefficients_[node.a].data();
+                const double* b = coefficients_[node.b].data();
+
+                double& result = coefficient(i, k);
+
+                switch (node.operation)
+                  {
+                    case Operation::input:
+                      break;
+                    case Operation::constant:
+                      result = k == 0 ? node.c : 0.0;
+                    break;
+                    case Operation::add:
+                      result = a[k] + b[k];
+                    break;
+                    case Operation::subtract:
+                      result = a[k] - b[k];
+                    break;
+                    case Operation::multiply:
+                      {
+                        double sum = 0;
+                        for (size_t j = 0; j <= k; ++j)
+                          sum += a[j] * b[k - j];
+                        result = sum;
+                      }
+                    break;
+                    case Operation::add_constant:
+                      result = k == 0 ? a[0] + node.c : a[k];
+                    break;
+                    case Operation::scale:
+                      result = node.c * a[k];
+                    break;
+                  }
+              }
+          }
+        };
+
+        inline Variable operator+ (const Variable& a, const Variable& b)
+        {
+          return a.tape_->record(Tape::Operation::add, a, b);
+        }
+
+        inline Variable operator- (const Variable& a, const Variable& b)
+        {
+          return a.tape_->record(Tape::Operation::subtract, a, b);
+        }
+
+        inline Variable operator* (const Variable& a, const Variable& b)
+        {
+          return a.tape_->record(Tape::Operation::multiply, a, b);
+        }
+
+        inline Variable operator+ (const Variable& a, double c)
+        {
+          return a.tape_->record(Tape::Operation::add_constant, a, c);
+        }
+
+        inline Variable operator* (double c, const Variable& a)
+        {
+          return a.tape_->record(Tape::Operation::scale, a, c);
+        }
+
+        inline Variable operator- (const Variable& a)
+        {
+          return -1.0 * a;
+        }
+
+        inline Variable operator+ (double c, const Variable& a)
+        {
+          return a + c;
+        }
+
+        inline Variable operator- (const Variable& a, double c)
+        {
+          return a + (-c);
+        }
+
+        inline Variable operator- (double c, const Variable& a)
+        {
+          return -a + c;
+        }
+
+        inline Variable operator* (const Variable& a, double c)
+        {
+          return c * a;
+        }
+
+        inline Variable operator/ (const Variable& a, double c)
+        {
+          return (1 / c) * a;
+        }
+
+        /// \brief The Taylor polynomials of the coordinates of an orbit around one of its points
+        template<unsigned Dimension>
+        struct Expansion {
+            std::array<std::array<double, Tape::max_order + 1>, Dimension> x{};
+            size_t order = 0;
+
+            /// \brief the polynomial of coordinate i at h
+            double evaluate (unsigned i, double h) const noexcept
+            {
+              double sum = x[i][order];
+              for (size_t k = order; k-- > 0;)
+                sum = sum * h + x[i][k];
+              return sum;
+            }
+
+            /// \brief the time derivative of the polynomial of coordinate i at h
+            double evaluate_derivative (unsigned i, double h) const noexcept
+            {
+              double sum = static_cast<double>(order) * x[i][order];
+              for (size_t k = order - 1; k > 0; --k)
+                sum = sum * h + static_cast<double>(k) * x[i][k];
+              return sum;
+            }
+        };
+
+        /// \brief The last step of a TaylorStepper over State2_Action: the orbit is expansion at t - t_start, from
+        /// t_start to t_end, where it reaches end.
+        ///
+        /// The record is owned by the caller, who hands it to the stepper, which overwrites it on every accepted step,
+        /// and to Taylor::step_back, which steps back along it onto a surface crossed by that step.
+        struct StepRecord {
+            Expansion<3> expansion{};
+            double t_start = 0;
+            double t_end = std::numeric_limits<double>::quiet_NaN();
+            std::array<double, 3> end{};
+
+            bool ends_at (const Geometry::State2_Action& s, double t) const noexcept
+            {
+              return t == t_end && s.q() == end[0] && s.p() == end[1] && s.J() == end[2];
+            }
+        };
+
+        /// \brief Controlled stepper that integrates the system generated by a Hamiltonian with a polynomial
+        /// derivative (see Hamiltonian::has_polynomial_derivative) with its Taylor series.
+        ///
+        /// The order and the step follow Jorba and Zou, "A software package for the numerical integration of ODEs by
+        /// means of high-order Taylor methods" (2005): for a tolerance eps the order is p = ceil(1 - ln(eps) / 2), and
+        /// the step is chosen from the decay of the coefficients of orders p - 1 and p, so that each of them contributes
+        /// less than eps, and shortened by their safety factor exp(-0.7 / (p - 1)). The tolerance is
+        /// abs_err + rel_err * |x_i| for every coordinate, as in odeint's error checker.
+        ///
+        /// The error of a step is estimated by the term of order p + 1, which the step then includes, as the
+        /// Runge-Kutta steppers propagate their higher order solution. A step whose estimate exceeds the tolerance is
+        /// rejected, and a shorter one is proposed in dt. The step size requested by the caller is otherwise only an
+        /// upper bound (e.g. the end of the integration interval). The system passed to try_step is ignored, the
+        /// vector field is the one recorded from the Hamiltonian at construction.
+        ///
+        /// Over State2_Action the expansion of each accepted step is kept in the StepRecord passed at construction, if
+        /// any, for the Taylor::step_back onto a surface crossed by that step.
+        template<typename StateType, typename DS>
+        class TaylorStepper {
+         public:
+          using state_type = StateType;
+          using deriv_type = StateType;
+          using value_type = double;
+          using time_type = double;
+          using stepper_category = boost::numeric::odeint::controlled_stepper_tag;
+
+          /// \brief the highest order of the steps; one more coefficient is calculated for the error estimate
+          static constexpr size_t max_order = Tape::max_order - 1;
+
+         private:
+          static constexpr unsigned dimension = StateType::dimension;
+
+          static_assert(Hamiltonian::has_polynomial_derivative_v<typename DS::hamiltonian_type>,
+                        "TaylorStepper: the Hamiltonian has no polynomial_derivative");
+          static_assert(dimension == 2 || dimension == 3, "TaylorStepper: State2 or State2_Action expected");
+
+          double abs_err_;
+          double rel_err_;
+          double dt_max_;
+
+          std::array<size_t, 2> inputs_{};
+          std::array<size_t, dimension> outputs_{};
+          Tape tape_{};
+          DS system_;
+          StepRecord* step_record_;
+
+          Expansion<dimension> expansion_{};
+
+          void record ()
+          {
+            const auto q = tape_.input();
+            const auto p = tape_.input();
+
+            const auto[dHdq, dHdp] = system_.hamiltonian().polynomial_derivative(q, p);
+
+            // shifting by a zero constant keeps the outputs distinct from the inputs, e.g. dq/dt = p for the
+            // harmonic oscillator
+            const auto dqdt = dHdp + 0.0;
+            const auto dpdt = -dHdq;
+
+            inputs_ = {q.index(), p.index()};
+            outputs_[0] = dqdt.index();
+            outputs_[1] = dpdt.index();
+
+            if constexpr (dimension > 2)
+              {
+                const auto dJdt = p * dqdt;
+                outputs_[2] = dJdt.index();
+              }
+          }
+
+          static size_t order_for (double eps) noexcept
+          {
+            const auto order = std::ceil(1 - 0.5 * std::log(eps));
+            return static_cast<size_t>(std::clamp(order, 2.0, static_cast<double>(max_order)));
+          }
+
+          void keep_last_step (double t_start, double t_end, const StateType& end) const noexcept
+          {
+            if constexpr (dimension == 3)
+              {
+                if (step_record_ == nullptr)
+                  return;
+
+                auto& last = *step_record_;
+                for (unsigned i = 0; i < dimension; ++i)
+                  {
+                    std::copy_n(expansion_.x[i].begin(), expansion_.order + 1, last.expansion.x[i].begin());
+                    last.end[i] = end[i];
+                  }
+                last.expansion.order = expansion_.order;
+                last.t_start = t_start;
+                last.t_end = t_end;
+              }
+          }
+
+         public:
+          /// \param step_record where the accepted steps over State2_Action are kept, if not null; it must outlive the
+          /// stepper and all its copies
+          TaylorStepper (DS system, double abs_err, double rel_err,
+                         double dt_max = std::numeric_limits<double>::infinity(),
+                         StepRecord* step_record = nullptr)
+              : abs_err_{abs_err}, rel_err_{rel_err}, dt_max_{dt_max}, system_{std::move(system)},
+                step_record_{step_record}
+          {
+            record();
+          }
+
+          /// \brief calculates the Taylor coefficients of the orbit through x up to the given order
+          void calculate_coefficients (const StateType& x, size_t order) noexcept
+          {
+            auto& c = expansion_.x;
+            expansion_.order = order;
+
+            for (unsigned i = 0; i < dimension; ++i)
+              c[i][0] = x[i];
+
+            for (size_t i = 0; i < inputs_.size(); ++i)
+              tape_.coefficient(inputs_[i], 0) = x[static_cast<unsigned>(i)];
+
+            for (size_t k = 0; k < order; ++k)
+              {
+                tape_.evaluate(k);
+
+                const auto inverse_k = 1.0 / static_cast<double>(k + 1);
+                for (size_t i = 0; i < outputs_.size(); ++i)
+                  c[i][k + 1] = tape_.coefficient(outputs_[i], k) * inverse_k;
+
+                for (size_t i = 0; i < inputs_.size(); ++i)
+                  tape_.coefficient(inputs_[i], k + 1) = c[i][k + 1];
+              }
+          }
+
+          /// \brief the Taylor polynomials calculated by the last calculate_coefficients
+          const Expansion<dimension>& expansion () const noexcept
+          {
+            return expansion_;
+          }
+
+          template<typename System>
+          boost::numeric::odeint::controlled_step_result
+          try_step (System /*system*/, StateType& x, double& t, double& dt)
+          {
+            double eps_min = std::numeric_limits<double>::infinity();
+            std::array<double, dimension> eps{};
+            for (unsigned i = 0; i < dimension; ++i)
+              {
+                eps[i] = std::max(abs_err_ + rel_err_ * std::abs(x[i]), std::numeric_limits<double>::min());
+                eps_min = std::min(eps_min, eps[i]);
+              }
+
+            const auto order = order_for(eps_min);
+            const auto safety = std::exp(-0.7 / static_cast<double>(order - 1));
+
+            calculate_coefficients(x, order + 1);
+            const auto& c = expansion_.x;
+
+            double h_series = std::numeric_limits<double>::infinity();
+            for (unsigned i = 0; i < dimension; ++i)
+              for (const auto j: {order - 1, order})
+                {
+                  const auto c_j = std::abs(c[i][j]);
+                  if (c_j > 0)
+                    h_series = std::min(h_series, std::pow(eps[i] / c_j, 1.0 / static_cast<double>(j)));
+                }
+
+            const auto h = std::min({dt, dt_max_, safety * h_series});
+
+            double error = 0;
+            for (unsigned i = 0; i < dimension; ++i)
+              error = std::max(error, std::abs(c[i][order + 1]) * std::pow(h, static_cast<double>(order + 1)) / eps[i]);
+
+            if (error > 1)
+              {
+                dt = h * std::max(0.2, safety * std::pow(error, -1.0 / static_cast<double>(order + 1)));
+                return boost::numeric::odeint::fail;
+              }
+
+            for (unsigned i = 0; i < dimension; ++i)
+              x[i] = expansion_.evaluate(i, h);
+
+            keep_last_step(t, t + h, x);
+
+            t += h;
+            dt = dt_max_;
+
+            return boost::numeric::odeint::success;
+          }
+        };
+
+        namespace Internals
+        {
+            /// \brief the h in [h_low, h_high] at which expansion * direction == target, by Newton iterations kept
+            /// within the interval by bisection. expansion * direction - target must change sign in the interval.
+            template<unsigned Dimension>
+            double time_on_surface (const Expansion<Dimension>& expansion,
+                                    const Geometry::State2 direction,
+                                    double target,
+                                    double h_low,
+                                    double h_high) noexcept
+            {
+              constexpr int max_iterations = 200;
+              constexpr double eps = std::numeric_limits<double>::epsilon();
+
+              const auto distance_at = [&expansion, &direction, target] (double h)
+              {
+                  return expansion.evaluate(0, h) * direction.q() + expansion.evaluate(1, h) * direction.p() - target;
+              };
+
+              const bool negative_low = distance_at(h_low) < 0;
+              double h = h_high;
+
+              for (int i = 0; i < max_iterations; ++i)
+                {
+                  const auto value = distance_at(h);
+                  if (value == 0)
+                    return h;
+
+                  if ((value < 0) == negative_low)
+                    h_low = h;
+                  else
+                    h_high = h;
+
+                  const auto velocity = expansion.evaluate_derivative(0, h) * direction.q()
+                                        + expansion.evaluate_derivative(1, h) * direction.p();
+
+                  auto next = h - value / velocity;
+                  if (!(std::isfinite(next) && next > std::min(h_low, h_high) && next < std::max(h_low, h_high)))
+                    next = 0.5 * (h_low + h_high);
+
+                  if (std::abs(next - h) <= 4 * eps * std::max(1.0, std::abs(next)))
+                    return next;
+
+                  h = next;
+                }
+
+              return h;
+            }
+        }
+
+        /// \brief The Taylor counterpart of step_back. Follows the Taylor series of the orbit through s until
+        /// s*direction has changed by -distance.
+        ///
+        /// If step_record is not null, and s and t are where its step has ended, the series is the expansion of that
+        /// step, i.e. its dense output, so the crossing is as accurate as the step itself, however large the step has
+        /// been, and no coefficient is calculated again. The crossing is then searched within the step, by Newton
+        /// iterations kept there by bisection. Otherwise the series is calculated at s, to an order
+        /// above the one of the steps for tolerances down to 1e-20, and the time of flight is found by Newton
+        /// iterations on it.
+        template<typename DS>
+        Geometry::State2_Extended step_back (const DS& system,
+                                             const Geometry::State2 direction,
+                                             const Geometry::State2_Action& s,
+                                             double t,
+                                             double distance,
+                                             const StepRecord* step_record = nullptr)
+        {
+          const double target = Geometry::State2{s} * direction - distance;
+
+          const auto on_surface = [t] (const Expansion<3>& expansion, double h, double dt)
+          {
+              return Geometry::State2_Extended{expansion.evaluate(0, h),
+                                               expansion.evaluate(1, h),
+                                               expansion.evaluate(2, h),
+                                               t + dt};
+          };
+
+          if (step_record != nullptr && step_record->ends_at(s, t))
+            {
+              const auto& expansion = step_record->expansion;
+              const auto step = t - step_record->t_start;
+              const auto distance_at_start = expansion.x[0][0] * direction.q() + expansion.x[1][0] * direction.p()
+                                             - target;
+
+              if (distance_at_start == 0)
+                return on_surface(expansion, 0, -step);
+
+              if ((distance_at_start < 0) != (distance < 0))
+                {
+                  const auto h = Internals::time_on_surface(expansion, direction, target, 0, step);
+                  return on_surface(expansion, h, h - step);
+                }
+            }
+
+          constexpr int max_iterations = 20;
+          constexpr double eps = std::numeric_limits<double>::epsilon();
+
+          using Stepper = TaylorStepper<Geometry::State2_Action, DS>;
+          constexpr size_t order = 25;
+
+          Stepper stepper{system, 0, 0};
+          stepper.calculate_coefficients(s, order);
+          const auto& expansion = stepper.expansion();
+
+          const auto position_along_direction = [&expansion, &direction] (double dt)
+          {
+              return expansion.evaluate(0, dt) * direction.q() + expansion.evaluate(1, dt) * direction.p();
+          };
+
+          const auto velocity_along_direction = [&expansion, &direction] (double dt)
+          {
+              return expansion.evaluate_derivative(0, dt) * direction.q()
+                     + expansion.evaluate_derivative(1, dt) * direction.p();
+          };
+
+          double dt = -distance / velocity_along_direction(0);
+
+          for (int i = 0; i < max_iterations; ++i)
+            {
+              const double correction = (position_along_direction(dt) - target) / velocity_along_direction(dt);
+              dt -= correction;
+
+              if (std::abs(correction) <= 4 * eps * std::max(1.0, std::abs(dt)))
+                break;
+            }
+
+          return on_surface(expansion, dt, dt);
+        }
+    }
+}
+
+#endif //HAMILTONIANS_TAYLOR_HPP
@@ -0,0 +1,59 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_TWO_LEVEL_RETURN_HPP
+#define HAMILTONIANS_TWO_LEVEL_RETURN_HPP
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "State.hpp"
+#include "IntegrationTimeInterval.hpp"
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    /// \brief The loose pass of come_back_home_closed_orbit_two_level
+    struct CoarsePassOptions {
+        /// \brief the absolute and relative tolerance of the loose pass; never tighter than the fine one
+        double tolerance = 1e-6;
+        /// \brief the loose pass lets an orbit through to the fine pass at its first crossing within fallback_distance
+        /// of s_start, and rejects it if none comes that near. It must exceed the error of the loose pass over one
+        /// period: on long periods, e.g. near a separatrix, that error grows, and may even carry the loose orbit across
+        /// the separatrix, so that orbits which do come back are rejected.
+        double fallback_distance = 0.1;
+    };
+
+    /// \brief come_back_home_closed_orbit, behind a screening pass at CoarsePassOptions::tolerance that rejects the
+    /// orbits that never come near s_start again.
+    ///
+    /// The orbits that never come back, e.g. rotations or escapes while scanning seeds, are pursued by
+    /// come_back_home_closed_orbit at full precision up to the end of integrationTime before it throws; here they are
+    /// integrated at the loose tolerance only. The orbits that pass the screening are computed by
+    /// come_back_home_closed_orbit itself, so their result is the same, bit for bit, but they pay for the loose pass,
+    /// up to their first crossing within CoarsePassOptions::fallback_distance, on top. So this only pays off when a
+    /// good part of the orbits never come back; see CoarsePassOptions::fallback_distance for the orbits it may reject
+    /// wrongly.
+    /// \throws std::runtime_error if the orbit never comes back, or is rejected by the screening
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    Geometry::State2_Extended
+    come_back_home_closed_orbit_two_level (const Ham& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options,
+                                           const CoarsePassOptions& coarse_options = CoarsePassOptions{})
+    {
+      auto loose_options = options;
+      loose_options.set_abs_err(std::max(options.abs_err, coarse_options.tolerance));
+      loose_options.set_rel_err(std::max(options.rel_err, coarse_options.tolerance));
+      loose_options.set_distance_threshold(coarse_options.fallback_distance);
+
+      // throws for the orbits that never come near s_start
+      come_back_home_closed_orbit<StepperPolicy>(hamiltonian, s_start, integrationTime, loose_options);
+
+      return come_back_home_closed_orbit<StepperPolicy>(hamiltonian, s_start, integrationTime, options);
+    }
+}
+
+#endif //HAMILTONIANS_TWO_LEVEL_RETURN_HPP
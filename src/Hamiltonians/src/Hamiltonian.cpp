@@ -2,21 +2,110 @@
 // Created by Panagiotis Zestanakis on 03/10/18.
 //
 #include <boost/math/special_functions/pow.hpp>
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include "Hamiltonian.hpp"
+#include "details/batch_math.hpp"
 namespace Integrators
 {
     namespace Hamiltonian
     {
+        namespace
+        {
+            using Internals::batch_chunk_size;
+
+            /// \brief Gathers the states into contiguous, zero padded arrays of q and p, one chunk at a time, and calls
+            /// kernel(q, p, offset, count) on each chunk.
+            template<typename Kernel>
+            void for_each_chunk (Span<const Geometry::State2> states, Kernel kernel)
+            {
+              alignas(64) double q[batch_chunk_size];
+              alignas(64) double p[batch_chunk_size];
+
+              for (size_t offset = 0; offset < states.size(); offset += batch_chunk_size)
+                {
+                  const auto count = std::min(batch_chunk_size, states.size() - offset);
+
+                  for (size_t i = 0; i < count; ++i)
+                    {
+                      q[i] = states[offset + i].q();
+                      p[i] = states[offset + i].p();
+                    }
+                  for (size_t i = count; i < batch_chunk_size; ++i)
+                    {
+                      q[i] = 0;
+                      p[i] = 0;
+                    }
+
+                  kernel(q, p, offset, count);
+                }
+            }
+
+            void scatter (const double* values, Span<double> out, size_t offset, size_t count) noexcept
+            {
+              for (size_t i = 0; i < count; ++i)
+                out[offset + i] = values[i];
+            }
+
+            void scatter (const double* dHdq, const double* dHdp, Span<Geometry::State2> out, size_t offset,
+                          size_t count) noexcept
+            {
+              for (size_t i = 0; i < count; ++i)
+                {
+                  out[offset + i].q() = dHdq[i];
+                  out[offset + i].p() = dHdp[i];
+                }
+            }
+        }
 
         double HarmonicOscillator::value (const Geometry::State2& s) const noexcept
         {
           return 0.5 * magnitude_squared(s);
         }
+        std::vector<double> HarmonicOscillator::parameters () const
+        {
+          return {};
+        }
         Geometry::State2 HarmonicOscillator::derivative (const Geometry::State2& s) const noexcept
         {
           return s;
         }
+        std::array<double, 3> HarmonicOscillator::hessian (const Geometry::State2& /*s*/) const noexcept
+        {
+          return {1, 0, 1};
+        }
+        Geometry::State2_Action HarmonicOscillator::flow (const Geometry::State2_Action& s, double dt) const noexcept
+        {
+          const auto q0 = s.q();
+          const auto p0 = s.p();
+          const auto cos_dt = std::cos(dt);
+          const auto sin_dt = std::sin(dt);
+          const auto sin_2dt = std::sin(2 * dt);
+
+          // J = integral of p*dq/dt = integral of p^2
+          const auto dJ = p0 * p0 * (0.5 * dt + 0.25 * sin_2dt)
+                          + q0 * q0 * (0.5 * dt - 0.25 * sin_2dt)
+                          - q0 * p0 * sin_dt * sin_dt;
+
+          return Geometry::State2_Action{q0 * cos_dt + p0 * sin_dt, p0 * cos_dt - q0 * sin_dt, s.J() + dJ};
+        }
+
+        void HarmonicOscillator::value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept
+        {
+          for_each_chunk(states, [values] (const double* q, const double* p, size_t offset, size_t count)
+          {
+              alignas(64) double h[batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                h[i] = 0.5 * (q[i] * q[i] + p[i] * p[i]);
+              scatter(h, values, offset, count);
+          });
+        }
+        void HarmonicOscillator::derivative_batch (Span<const Geometry::State2> states,
+                                                   Span<Geometry::State2> derivatives) const noexcept
+        {
+          std::copy(states.begin(), states.end(), derivatives.begin());
+        }
 
         DuffingHamiltonian::DuffingHamiltonian (double omega, double omega0, double e_alpha, double e_gamma)
             : omega_(omega), omega0_(omega0), e_alpha_(e_alpha), e_gamma_(e_gamma)
@@ -53,6 +142,30 @@ namespace Integrators
         {
           e_gamma_ = e_gamma;
         }
+        std::vector<double> DuffingHamiltonian::parameters () const
+        {
+          return {omega_, omega0_, e_alpha_, e_gamma_};
+        }
+        void DuffingHamiltonian::set_parameter (size_t index, double value)
+        {
+          switch (index)
+            {
+              case 0:
+                omega_ = value;
+              break;
+              case 1:
+                omega0_ = value;
+              break;
+              case 2:
+                e_alpha_ = value;
+              break;
+              case 3:
+                e_gamma_ = value;
+              break;
+              default:
+                throw std::out_of_range("DuffingHamiltonian: no parameter at this index");
+            }
+        }
         double DuffingHamiltonian::value (const Geometry::State2& s) const noexcept
         {
           using boost::math::pow;
@@ -67,18 +180,74 @@ namespace Integrators
         }
         Geometry::State2 DuffingHamiltonian::derivative (const Geometry::State2& s) const noexcept
         {
-          using boost::math::pow;
+          const auto[dHdq, dHdp] = polynomial_derivative(s.q(), s.p());
 
-          const double q = s.q();
-          const double p = s.p();
+          return Geometry::State2{dHdq,dHdp};
 
-          const double hypot_sq = magnitude_squared(s);
+        }
+        std::array<double, 3> DuffingHamiltonian::hessian (const Geometry::State2& s) const noexcept
+        {
+          const auto q = s.q();
+          const auto p = s.p();
+          const auto a = 3 * e_alpha_ / 4;
 
-          const double dHdq = -(e_Omega() * q + 3 * e_alpha_ / 4 * hypot_sq * q - e_gamma_) / (2 * omega_);
-          const double dHdp = -(e_Omega() * p + 3 * e_alpha_ / 4 * hypot_sq * p) / (2 * omega_);
+          return {-(e_Omega() + a * (3 * q * q + p * p)) / (2 * omega_),
+                  -(2 * a * q * p) / (2 * omega_),
+                  -(e_Omega() + a * (q * q + 3 * p * p)) / (2 * omega_)};
+        }
+        std::array<Geometry::State2, DuffingHamiltonian::number_of_parameters>
+        DuffingHamiltonian::parameter_derivatives (const Geometry::State2& s) const noexcept
+        {
+          const auto q = s.q();
+          const auto p = s.p();
+          const auto hypot_sq = q * q + p * p;
 
-          return Geometry::State2{dHdq,dHdp};
+          const auto[dHdq, dHdp] = polynomial_derivative(q, p);
 
+          // dH/ds = -N(s) / (2 omega), where N depends on omega through e_Omega = omega0^2 - omega^2
+          return {Geometry::State2{q - dHdq / omega_, p - dHdp / omega_},
+                  Geometry::State2{-omega0_ * q / omega_, -omega0_ * p / omega_},
+                  Geometry::State2{-3 * hypot_sq * q / (8 * omega_), -3 * hypot_sq * p / (8 * omega_)},
+                  Geometry::State2{1 / (2 * omega_), 0}};
+        }
+
+        void DuffingHamiltonian::value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept
+        {
+          const double c_hypot_sq = -e_Omega() / (4 * omega_);
+          const double c_hypot_sq_2 = -3 * e_alpha_ / (32 * omega_);
+          const double c_q = 2 * e_gamma_ / (4 * omega_);
+
+          for_each_chunk(states, [=] (const double* q, const double* p, size_t offset, size_t count)
+          {
+              alignas(64) double h[batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                {
+                  const double hypot_sq = q[i] * q[i] + p[i] * p[i];
+                  h[i] = c_hypot_sq * hypot_sq + c_hypot_sq_2 * hypot_sq * hypot_sq + c_q * q[i];
+                }
+              scatter(h, values, offset, count);
+          });
+        }
+        void DuffingHamiltonian::derivative_batch (Span<const Geometry::State2> states,
+                                                   Span<Geometry::State2> derivatives) const noexcept
+        {
+          const double c_linear = -e_Omega() / (2 * omega_);
+          const double c_cubic = -3 * e_alpha_ / (8 * omega_);
+          const double c_constant = e_gamma_ / (2 * omega_);
+
+          for_each_chunk(states, [=] (const double* q, const double* p, size_t offset, size_t count)
+          {
+              alignas(64) double dHdq[batch_chunk_size];
+              alignas(64) double dHdp[batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                {
+                  const double hypot_sq = q[i] * q[i] + p[i] * p[i];
+                  const double factor = c_linear + c_cubic * hypot_sq;
+                  dHdq[i] = factor * q[i] + c_constant;
+                  dHdp[i] = factor * p[i];
+                }
+              scatter(dHdq, dHdp, derivatives, offset, count);
+          });
         }
 
         PendulumHamiltonian::PendulumHamiltonian (double FF, double GG)
@@ -92,6 +261,10 @@ namespace Integrators
         {
           return G_;
         }
+        std::vector<double> PendulumHamiltonian::parameters () const
+        {
+          return {F_, G_};
+        }
 
 
         double PendulumHamiltonian::value (const Geometry::State2& s) const noexcept
@@ -113,16 +286,376 @@ namespace Integrators
 
           return Geometry::State2{F_*sin(q),p};
         }
+        std::array<double, 3> PendulumHamiltonian::hessian (const Geometry::State2& s) const noexcept
+        {
+          // consistent with derivative()
+          return {F_ * std::cos(s.q()), 0, 1};
+        }
+
+        void PendulumHamiltonian::value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept
+        {
+          for_each_chunk(states, [this, values] (const double* q, const double* p, size_t offset, size_t count)
+          {
+              alignas(64) double cos_q[batch_chunk_size];
+              Internals::cos_batch(q, cos_q, batch_chunk_size);
+
+              alignas(64) double h[batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                h[i] = 0.5 * G_ * p[i] * p[i] - F_ * cos_q[i];
+              scatter(h, values, offset, count);
+          });
+        }
+        void PendulumHamiltonian::derivative_batch (Span<const Geometry::State2> states,
+                                                    Span<Geometry::State2> derivatives) const noexcept
+        {
+          for_each_chunk(states, [this, derivatives] (const double* q, const double* p, size_t offset, size_t count)
+          {
+              alignas(64) double dHdq[batch_chunk_size];
+              Internals::sin_batch(q, dHdq, batch_chunk_size);
+
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                dHdq[i] *= F_;
+              scatter(dHdq, p, derivatives, offset, count);
+          });
+        }
 
         double FreeParticle::value (const Geometry::State2& s) const noexcept
         {
           using boost::math::pow;
           return 0.5*pow<2>(s.p());
         }
+        std::vector<double> FreeParticle::parameters () const
+        {
+          return {};
+        }
         Geometry::State2 FreeParticle::derivative (const Geometry::State2& s) const noexcept
         {
           return Integrators::Geometry::State2{0,s.p()};
         }
+        std::array<double, 3> FreeParticle::hessian (const Geometry::State2& /*s*/) const noexcept
+        {
+          return {0, 0, 1};
+        }
+        void FreeParticle::value_batch (Span<const Geometry::State2> states, Span<double> values) const noexcept
+        {
+          for_each_chunk(states, [values] (const double* /*q*/, const double* p, size_t offset, size_t count)
+          {
+              alignas(64) double h[batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                h[i] = 0.5 * p[i] * p[i];
+              scatter(h, values, offset, count);
+          });
+        }
+        void FreeParticle::derivative_batch (Span<const Geometry::State2> states,
+                                             Span<Geometry::State2> derivatives) const noexcept
+        {
+          for (size_t i = 0; i < states.size(); ++i)
+            derivatives[i] = Geometry::State2{0, states[i].p()};
+        }
+        Geometry::State2_Action FreeParticle::flow (const Geometry::State2_Action& s, double dt) const noexcept
+        {
+          const auto p = s.p();
+          return Geometry::State2_Action{s.q() + p * dt, p, s.J() + p * p * dt};
+        }
+
+        namespace
+        {
+            /// \brief solves the system with the given diagonal, ones on the off diagonals, and right hand side rhs
+            std::vector<double> solve_tridiagonal (std::vector<double> diagonal, std::vector<double> rhs)
+            {
+              const auto m = diagonal.size();
+              if (m == 0)
+                return {};
+
+              for (size_t i = 1; i < m; ++i)
+                {
+                  const auto w = 1 / diagonal[i - 1];
+                  diagonal[i] -= w;
+                  rhs[i] -= w * rhs[i - 1];
+                }
+
+              std::vector<double> x(m);
+              x[m - 1] = rhs[m - 1] / diagonal[m - 1];
+              for (size_t i = m - 1; i-- > 0;)
+                x[i] = (rhs[i] - x[i + 1]) / diagonal[i];
+
+              return x;
+            }
+
+            /// \brief solves M[i-1] + 4 M[i] + M[i+1] = rhs[i], with the indices taken cyclically (Sherman-Morrison)
+            std::vector<double> solve_cyclic_tridiagonal (const std::vector<double>& rhs)
+            {
+              const auto m = rhs.size();
+              if (m == 0)
+                return {};
+
+              constexpr double gamma = -4;
+
+              std::vector<double> diagonal(m, 4.0);
+              diagonal[0] -= gamma;
+              diagonal[m - 1] -= 1 / gamma;
+
+              auto x = solve_tridiagonal(diagonal, rhs);
+
+              std::vector<double> u(m, 0.0);
+              u[0] = gamma;
+              u[m - 1] = 1;
+              const auto z = solve_tridiagonal(diagonal, u);
+
+              const auto factor = (x[0] + x[m - 1] / gamma) / (1 + z[0] + z[m - 1] / gamma);
+              for (size_t i = 0; i < m; ++i)
+                x[i] -= factor * z[i];
+
+              return x;
+            }
+
+            /// \brief the second derivatives of the spline (times h^2) at the samples
+            std::vector<double> spline_curvatures (const std::vector<double>& y, bool periodic)
+            {
+              const auto n = y.size();
+              std::vector<double> curvature(n, 0.0);
+
+              if (periodic)
+                {
+                  std::vector<double> rhs(n);
+                  for (size_t i = 0; i < n; ++i)
+                    rhs[i] = 6 * (y[(i + 1) % n] - 2 * y[i] + y[(i + n - 1) % n]);
+                  curvature = solve_cyclic_tridiagonal(rhs);
+                }
+              else if (n > 2)
+                {
+                  // natural spline: zero curvature at the ends, a tridiagonal system for the interior samples
+                  std::vector<double> rhs(n - 2);
+                  for (size_t i = 1; i + 1 < n; ++i)
+                    rhs[i - 1] = 6 * (y[i + 1] - 2 * y[i] + y[i - 1]);
+                  const auto interior = solve_tridiagonal(std::vector<double>(n - 2, 4.0), rhs);
+                  std::copy(interior.begin(), interior.end(), curvature.begin() + 1);
+                }
+
+              return curvature;
+            }
+        }
+
+        SplinePotentialHamiltonian::SplinePotentialHamiltonian (double q_min,
+                                                                double q_max,
+                                                                const std::vector<double>& potential,
+                                                                double mass,
+                                                                SplineBoundary boundary)
+            : q_min_(q_min), inverse_h_(0), inverse_mass_(1 / mass), boundary_(boundary), cells_{}
+        {
+          const auto periodic = boundary == SplineBoundary::periodic;
+          const auto n = potential.size();
+
+          if (!(mass > 0))
+            throw std::invalid_argument("SplinePotentialHamiltonian: the mass must be positive");
+          if (!(q_min < q_max))
+            throw std::invalid_argument("SplinePotentialHamiltonian: empty range");
+          if (n < (periodic ? 3u : 2u))
+            throw std::invalid_argument("SplinePotentialHamiltonian: too few samples");
+          if (periodic && std::abs(q_max - q_min - boost::math::double_constants::two_pi) > 1e-9)
+            throw std::invalid_argument("SplinePotentialHamiltonian: the period must be 2pi");
+
+          const auto number_of_cells = periodic ? n : n - 1;
+          inverse_h_ = static_cast<double>(number_of_cells) / (q_max - q_min);
+
+          const auto curvature = spline_curvatures(potential, periodic);
+
+          // the natural spline has a linear cell on either side, for the continuation outside [q_min, q_max]
+          std::vector<std::array<double, 4>> cells{};
+          cells.reserve(periodic ? number_of_cells : number_of_cells + 2);
+          if (!periodic)
+            cells.push_back({});
+
+          for (size_t i = 0; i < number_of_cells; ++i)
+            {
+              const auto j = (i + 1) % n;
+              cells.push_back({potential[i],
+                               potential[j] - potential[i] - (2 * curvature[i] + curvature[j]) / 6,
+                               curvature[i] / 2,
+                               (curvature[j] - curvature[i]) / 6});
+            }
+
+          if (!periodic)
+            {
+              const auto& first = cells[1];
+              const auto& last = cells.back();
+
+              cells.front() = {first[0] - first[1], first[1], 0, 0};
+              const std::array<double, 4> right{last[0] + last[1] + last[2] + last[3],
+                                                last[1] + 2 * last[2] + 3 * last[3], 0, 0};
+              cells.push_back(right);
+            }
+
+          cells_ = std::make_shared<const std::vector<std::array<double, 4>>>(std::move(cells));
+        }
+
+        double SplinePotentialHamiltonian::mass () const noexcept
+        {
+          return 1 / inverse_mass_;
+        }
+
+        std::vector<double> SplinePotentialHamiltonian::parameters () const
+        {
+          std::vector<double> parameters{q_min_, inverse_h_, inverse_mass_,
+                                         boundary_ == SplineBoundary::periodic ? 1.0 : 0.0};
+          parameters.reserve(parameters.size() + 4 * cells_->size());
+          for (const auto& cell: *cells_)
+            parameters.insert(parameters.end(), cell.begin(), cell.end());
+          return parameters;
+        }
+
+        SplinePotentialHamiltonian::SplineBoundary SplinePotentialHamiltonian::boundary () const noexcept
+        {
+          return boundary_;
+        }
+
+        size_t SplinePotentialHamiltonian::locate (double q, double& t) const noexcept
+        {
+          auto u = (q - q_min_) * inverse_h_;
+
+          if (boundary_ == SplineBoundary::periodic)
+            {
+              const auto n = static_cast<double>(cells_->size());
+              u -= n * std::floor(u / n);
+              if (!(u >= 0 && u < n)) // not finite, or rounded up to n
+                {
+                  t = u == n ? 0 : u;
+                  return 0;
+                }
+              const auto i = static_cast<size_t>(u);
+              t = u - static_cast<double>(i);
+              return i;
+            }
+
+          const auto number_of_cells = static_cast<double>(cells_->size() - 2);
+          if (!(u >= 0))
+            {
+              t = u + 1;
+              return 0;
+            }
+          if (u >= number_of_cells)
+            {
+              t = u - number_of_cells;
+              return cells_->size() - 1;
+            }
+          const auto i = static_cast<size_t>(u);
+          t = u - static_cast<double>(i);
+          return i + 1;
+        }
+
+        double SplinePotentialHamiltonian::potential (double q) const noexcept
+        {
+          double t;
+          const auto& c = (*cells_)[locate(q, t)];
+          return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+        }
+
+        double SplinePotentialHamiltonian::potential_derivative (double q) const noexcept
+        {
+          double t;
+          const auto& c = (*cells_)[locate(q, t)];
+          return ((3 * c[3] * t + 2 * c[2]) * t + c[1]) * inverse_h_;
+        }
+
+        double SplinePotentialHamiltonian::potential_second_derivative (double q) const noexcept
+        {
+          double t;
+          const auto& c = (*cells_)[locate(q, t)];
+          return (6 * c[3] * t + 2 * c[2]) * inverse_h_ * inverse_h_;
+        }
+
+        double SplinePotentialHamiltonian::value (const Geometry::State2& s) const noexcept
+        {
+          const auto p = s.p();
+          return 0.5 * inverse_mass_ * p * p + potential(s.q());
+        }
+
+        Geometry::State2 SplinePotentialHamiltonian::derivative (const Geometry::State2& s) const noexcept
+        {
+          return Geometry::State2{potential_derivative(s.q()), inverse_mass_ * s.p()};
+        }
+
+        std::array<double, 3> SplinePotentialHamiltonian::hessian (const Geometry::State2& s) const noexcept
+        {
+          return {potential_second_derivative(s.q()), 0, inverse_mass_};
+        }
+
+        void SplinePotentialHamiltonian::value_batch (Span<const Geometry::State2> states,
+                                                      Span<double> values) const noexcept
+        {
+          for_each_chunk(states, [this, values] (const double* q, const double* p, size_t offset, size_t count)
+          {
+              // the cell lookups are gathers; only the polynomials are evaluated over the whole chunk
+              alignas(64) double t[batch_chunk_size];
+              alignas(64) double c[4][batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                {
+                  const auto& cell = (*cells_)[locate(q[i], t[i])];
+                  for (size_t k = 0; k < 4; ++k)
+                    c[k][i] = cell[k];
+                }
+
+              alignas(64) double h[batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                h[i] = 0.5 * inverse_mass_ * p[i] * p[i] + ((c[3][i] * t[i] + c[2][i]) * t[i] + c[1][i]) * t[i] + c[0][i];
+              scatter(h, values, offset, count);
+          });
+        }
+
+        void SplinePotentialHamiltonian::derivative_batch (Span<const Geometry::State2> states,
+                                                           Span<Geometry::State2> derivatives) const noexcept
+        {
+          for_each_chunk(states, [this, derivatives] (const double* q, const double* p, size_t offset, size_t count)
+          {
+              alignas(64) double t[batch_chunk_size];
+              alignas(64) double c[3][batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                {
+                  const auto& cell = (*cells_)[locate(q[i], t[i])];
+                  for (size_t k = 0; k < 3; ++k)
+                    c[k][i] = cell[k + 1];
+                }
+
+              alignas(64) double dHdq[batch_chunk_size];
+              alignas(64) double dHdp[batch_chunk_size];
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                {
+                  dHdq[i] = ((3 * c[2][i] * t[i] + 2 * c[1][i]) * t[i] + c[0][i]) * inverse_h_;
+                  dHdp[i] = inverse_mass_ * p[i];
+                }
+              scatter(dHdq, dHdp, derivatives, offset, count);
+          });
+        }
+
+        HenonHeilesHamiltonian::HenonHeilesHamiltonian (double lambda)
+            : lambda_{lambda}
+        { }
+
+        double HenonHeilesHamiltonian::lambda () const noexcept
+        {
+          return lambda_;
+        }
+
+        std::vector<double> HenonHeilesHamiltonian::parameters () const
+        {
+          return {lambda_};
+        }
+
+        double HenonHeilesHamiltonian::value (const Geometry::State4& s) const noexcept
+        {
+          const auto x = s.q(0);
+          const auto y = s.q(1);
+
+          return 0.5 * (s.p(0) * s.p(0) + s.p(1) * s.p(1) + x * x + y * y) + lambda_ * (x * x * y - y * y * y / 3);
+        }
+
+        Geometry::State4 HenonHeilesHamiltonian::derivative (const Geometry::State4& s) const noexcept
+        {
+          const auto x = s.q(0);
+          const auto y = s.q(1);
+
+          return Geometry::State4{x + 2 * lambda_ * x * y, y + lambda_ * (x * x - y * y), s.p(0), s.p(1)};
+        }
 
     }
 }
\ No newline at end of file
@@ -6,122 +6,766 @@
 namespace Integrators
 {
 
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
                                                     const Geometry::State2& s_start,
-                                                    const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                    const Geometry::Line& cross_line,
                                                     const TimeInterval& integrationTime,
                                                     const IntegrationOptions& options);
 
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
 
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                                           const Geometry::State2& s_start,
-                                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
-                                                           const TimeInterval& integrationTime,
-                                                           const IntegrationOptions& options);
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
-
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
                                                     const Geometry::State2& s_start,
                                                     const Geometry::Line& cross_line,
                                                     const TimeInterval& integrationTime,
                                                     const IntegrationOptions& options);
 
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::Line& cross_line,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
 
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::HarmonicOscillator& hamiltonian,
                                                            const Geometry::State2& s_start,
-                                                           const Geometry::Line& cross_line,
+                                                           const Geometry::ReversingSymmetry& symmetry,
                                                            const TimeInterval& integrationTime,
                                                            const IntegrationOptions& options);
 
-    template std::vector<Geometry::State2_Extended>
-    calculate_crossings<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
-                                                          const Geometry::State2& s_start,
-                                                          const Geometry::Line& cross_line,
-                                                          const TimeInterval& integrationTime,
-                                                          const IntegrationOptions& options);
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
 
     template
     Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::CashKarp54> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
                                                          const Geometry::State2& s_start,
-                                                         const Geometry::Line& cross_line,
                                                          const TimeInterval& integrationTime,
                                                          const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
     template
     Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::HarmonicOscillator& hamiltonian,
                                                                const Geometry::State2& s_start,
-                                                               const Geometry::Line& cross_line,
+                                                               const Geometry::ReversingSymmetry& symmetry,
                                                                const TimeInterval& integrationTime,
                                                                const IntegrationOptions& options);
+
     template
     Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                                                const Geometry::State2& s_start,
-                                                                const Geometry::Line& cross_line,
-                                                                const TimeInterval& integrationTime,
-                                                                const IntegrationOptions& options);
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                               const Geometry::State2& s_start,
+                                                               const Geometry::ReversingSymmetry& symmetry,
+                                                               const TimeInterval& integrationTime,
+                                                               const IntegrationOptions& options);
+
     template
     Geometry::State2_Extended
-    calculate_first_crossing<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
                                                                const Geometry::State2& s_start,
-                                                               const Geometry::Line& cross_line,
+                                                               const Geometry::ReversingSymmetry& symmetry,
                                                                const TimeInterval& integrationTime,
                                                                const IntegrationOptions& options);
 
     template
     Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::FreeParticle> (const Hamiltonian::FreeParticle& hamiltonian,
+    come_back_home_periodic_orbit<Steppers::DormandPrince5> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                             const Geometry::State2& s_start,
+                                                             const TimeInterval& integrationTime,
+                                                             const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
                                                const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
                                                const TimeInterval& integrationTime,
                                                const IntegrationOptions& options);
 
     template
     Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::HarmonicOscillator> (const Hamiltonian::HarmonicOscillator& hamiltonian,
-                                                     const Geometry::State2& s_start,
-                                                     const TimeInterval& integrationTime,
-                                                     const IntegrationOptions& options);
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
     template
     Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::PendulumHamiltonian> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                                      const Geometry::State2& s_start,
-                                                      const TimeInterval& integrationTime,
-                                                      const IntegrationOptions& options);
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::Fehlberg78> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::CashKarp54> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const Geometry::Line& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                        const Geometry::State2& s_start,
+                                                        const Geometry::Line& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                               const Geometry::State2& s_start,
+                                                               const Geometry::ReversingSymmetry& symmetry,
+                                                               const TimeInterval& integrationTime,
+                                                               const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::DormandPrince5> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                             const Geometry::State2& s_start,
+                                                             const TimeInterval& integrationTime,
+                                                             const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                               const Geometry::State2& s_start,
+                                               const Geometry::Line& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                    const Geometry::State2& s_start,
+                                                    const Geometry::Line& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_reversible_orbit<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                           const Geometry::State2& s_start,
+                                                           const Geometry::ReversingSymmetry& symmetry,
+                                                           const TimeInterval& integrationTime,
+                                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_periodic_orbit<Steppers::Fehlberg78> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const TimeInterval& integrationTime,
+                                                         const IntegrationOptions& options);
+
+
+    template
+    std::vector<Geometry::State4_Extended>
+    calculate_crossings<Steppers::CashKarp54> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                               const Geometry::State4& s_start,
+                                               const Geometry::Hyperplane<2>& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    Geometry::State4_Extended
+    calculate_first_crossing<Steppers::CashKarp54> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                    const Geometry::State4& s_start,
+                                                    const Geometry::Hyperplane<2>& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State4_Extended>
+    calculate_crossings<Steppers::DormandPrince5> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                   const Geometry::State4& s_start,
+                                                   const Geometry::Hyperplane<2>& cross_line,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    Geometry::State4_Extended
+    calculate_first_crossing<Steppers::DormandPrince5> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                        const Geometry::State4& s_start,
+                                                        const Geometry::Hyperplane<2>& cross_line,
+                                                        const TimeInterval& integrationTime,
+                                                        const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State4_Extended>
+    calculate_crossings<Steppers::Fehlberg78> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                               const Geometry::State4& s_start,
+                                               const Geometry::Hyperplane<2>& cross_line,
+                                               const TimeInterval& integrationTime,
+                                               const IntegrationOptions& options);
+
+    template
+    Geometry::State4_Extended
+    calculate_first_crossing<Steppers::Fehlberg78> (const Hamiltonian::HenonHeilesHamiltonian& hamiltonian,
+                                                    const Geometry::State4& s_start,
+                                                    const Geometry::Hyperplane<2>& cross_line,
+                                                    const TimeInterval& integrationTime,
+                                                    const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::PeriodicQSurfaceCrossObserver& periodicQSurfaceCrossObserver,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::Line& cross_line,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::Line& cross_line,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    template
+    std::vector<Geometry::State2_Extended>
+    calculate_crossings<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                           const Geometry::State2& s_start,
+                                           const Geometry::Line& cross_line,
+                                           const TimeInterval& integrationTime,
+                                           const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                const Geometry::State2& s_start,
+                                                const Geometry::Line& cross_line,
+                                                const TimeInterval& integrationTime,
+                                                const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                const Geometry::State2& s_start,
+                                                const Geometry::Line& cross_line,
+                                                const TimeInterval& integrationTime,
+                                                const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    calculate_first_crossing<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                const Geometry::State2& s_start,
+                                                const Geometry::Line& cross_line,
+                                                const TimeInterval& integrationTime,
+                                                const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Taylor> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
+    template
+    Geometry::State2_Extended
+    come_back_home_closed_orbit<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options);
+
     template
     Geometry::State2_Extended
-    come_back_home_closed_orbit<Hamiltonian::DuffingHamiltonian> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
-                                                     const Geometry::State2& s_start,
-                                                     const TimeInterval& integrationTime,
-                                                     const IntegrationOptions& options);
+    come_back_home_reversible_orbit<Steppers::Taylor> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const Geometry::ReversingSymmetry& symmetry,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
 
     template
     Geometry::State2_Extended
-    come_back_home_periodic_orbit (const Hamiltonian::PendulumHamiltonian& hamiltonian,
-                                   const Geometry::State2& s_start,
-                                   const TimeInterval& integrationTime,
-                                   const IntegrationOptions& options);
+    come_back_home_reversible_orbit<Steppers::Taylor> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                       const Geometry::State2& s_start,
+                                                       const Geometry::ReversingSymmetry& symmetry,
+                                                       const TimeInterval& integrationTime,
+                                                       const IntegrationOptions& options);
 
 
 
@@ -0,0 +1,95 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <stdexcept>
+#include "async_orbits.hpp"
+#include "details/parallel_for.hpp"
+
+namespace Integrators
+{
+    OrbitExecutor::OrbitExecutor (unsigned number_of_threads, size_t queue_capacity)
+        : queue_capacity_{queue_capacity}
+    {
+      if (queue_capacity == 0)
+        throw std::invalid_argument("OrbitExecutor: the queue capacity must be positive");
+
+      if (number_of_threads == 0)
+        number_of_threads = Internals::default_number_of_threads();
+
+      workers_.reserve(number_of_threads);
+      for (unsigned i = 0; i < number_of_threads; ++i)
+        workers_.emplace_back(&OrbitExecutor::work, this);
+    }
+
+    OrbitExecutor::~OrbitExecutor ()
+    {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+      }
+      not_empty_.notify_all();
+      not_full_.notify_all();
+
+      for (auto& worker: workers_)
+        worker.join();
+    }
+
+    void OrbitExecutor::work ()
+    {
+      while (true)
+        {
+          std::function<void ()> task{};
+          {
+            std::unique_lock<std::mutex> lock{mutex_};
+            not_empty_.wait(lock, [this] ()
+            { return stopping_ || !tasks_.empty(); });
+
+            if (tasks_.empty())
+              return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+          }
+          not_full_.notify_one();
+
+          // a packaged_task, which stores the exceptions in its future
+          task();
+        }
+    }
+
+    bool OrbitExecutor::enqueue (std::function<void ()> task, bool wait)
+    {
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        if (wait)
+          not_full_.wait(lock, [this] ()
+          { return stopping_ || tasks_.size() < queue_capacity_; });
+        else if (tasks_.size() >= queue_capacity_)
+          return false;
+
+        if (stopping_)
+          throw std::logic_error("OrbitExecutor: the executor is shutting down");
+
+        tasks_.push_back(std::move(task));
+      }
+      not_empty_.notify_one();
+      return true;
+    }
+
+    size_t OrbitExecutor::number_of_threads () const noexcept
+    {
+      return workers_.size();
+    }
+
+    size_t OrbitExecutor::queue_capacity () const noexcept
+    {
+      return queue_capacity_;
+    }
+
+    size_t OrbitExecutor::pending ()
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return tasks_.size();
+    }
+}
@@ -0,0 +1,131 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+#include <stdexcept>
+#include "birkhoff_average.hpp"
+
+namespace Integrators
+{
+    WeightedBirkhoffAverage::WeightedBirkhoffAverage (const BirkhoffOptions& options)
+        : options_(options)
+    {
+      if (options.check_every == 0)
+        throw std::invalid_argument("WeightedBirkhoffAverage: check_every must be positive");
+      if (options.minimum_values < 2)
+        throw std::invalid_argument("WeightedBirkhoffAverage: at least two values are needed");
+
+      values_.reserve(std::min<size_t>(options.maximum_values, 1u << 16u));
+    }
+
+    double WeightedBirkhoffAverage::average_of_first (size_t n) const noexcept
+    {
+      n = std::min(n, values_.size());
+
+      // the weights at t = (k + 1) / (n + 1), clear of the zeros at both ends
+      const auto step = 1 / static_cast<double>(n + 1);
+
+      double weighted_sum = 0;
+      double weight_sum = 0;
+      for (size_t k = 0; k < n; ++k)
+        {
+          const auto t = static_cast<double>(k + 1) * step;
+          const auto weight = std::exp(-1 / (t * (1 - t)));
+          weighted_sum += weight * values_[k];
+          weight_sum += weight;
+        }
+
+      return weight_sum > 0 ? weighted_sum / weight_sum : 0;
+    }
+
+    bool WeightedBirkhoffAverage::push (double value)
+    {
+      values_.push_back(value);
+
+      const auto n = values_.size();
+      if (converged_ || n < options_.minimum_values || (n - options_.minimum_values) % options_.check_every != 0)
+        return converged_;
+
+      average_ = average_of_first(n);
+      difference_ = std::abs(average_ - average_of_first(n / 2));
+      converged_ = difference_ <= options_.tolerance * std::max(1.0, std::abs(average_));
+
+      return converged_;
+    }
+
+    size_t WeightedBirkhoffAverage::size () const noexcept
+    {
+      return values_.size();
+    }
+
+    double WeightedBirkhoffAverage::average () const noexcept
+    {
+      return average_;
+    }
+
+    double WeightedBirkhoffAverage::difference () const noexcept
+    {
+      return difference_;
+    }
+
+    bool WeightedBirkhoffAverage::converged () const noexcept
+    {
+      return converged_;
+    }
+
+    bool WeightedBirkhoffAverage::exhausted () const noexcept
+    {
+      return values_.size() >= options_.maximum_values;
+    }
+
+    template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+
+    template
+    BirkhoffResult
+    calculate_rotation_number<Steppers::Default> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                  const Geometry::State2& s_start,
+                                                  const Geometry::State2& center,
+                                                  double sampling_period,
+                                                  const TimeInterval& integrationTime,
+                                                  const IntegrationOptions& options,
+                                                  const BirkhoffOptions& birkhoff_options);
+}
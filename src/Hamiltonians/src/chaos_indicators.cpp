@@ -0,0 +1,48 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include "chaos_indicators.hpp"
+
+namespace Integrators
+{
+    template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+
+    template
+    ChaosIndicators
+    calculate_chaos_indicators<Steppers::Default> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                   const Geometry::State2& s_start,
+                                                   const TimeInterval& integrationTime,
+                                                   const IntegrationOptions& options,
+                                                   const ChaosIndicatorOptions& chaos_options);
+}
@@ -0,0 +1,176 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <array>
+#include <fstream>
+#include <sstream>
+#include "checkpoint.hpp"
+#include "details/binary_io.hpp"
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        namespace
+        {
+            // the file: the magic, the size of a header slot, two header slots, the crossings. A slot holds the
+            // sequence of its save, the hash and the size of the header, and the header.
+            constexpr std::array<char, 8> checkpoint_magic{'H', 'A', 'M', 'C', 'K', 'P', 'T', '2'};
+            constexpr std::uint64_t slot_prefix_size = 3 * sizeof(std::uint64_t);
+            constexpr std::uint64_t slots_offset = checkpoint_magic.size() + sizeof(std::uint64_t);
+
+            std::uint64_t fnv1a (const std::string& bytes) noexcept
+            {
+              std::uint64_t hash = 14695981039346656037ull;
+              for (const auto c: bytes)
+                {
+                  hash ^= static_cast<unsigned char>(c);
+                  hash *= 1099511628211ull;
+                }
+              return hash;
+            }
+
+            std::string serialize_header (const Checkpoint& checkpoint)
+            {
+              std::ostringstream out{std::ios::binary};
+              write_doubles(out, checkpoint.fingerprint);
+              write_doubles(out, checkpoint.state);
+              write_double(out, checkpoint.t);
+              write_double(out, checkpoint.dt);
+              write_u64(out, checkpoint.steps);
+              write_u64(out, checkpoint.steps_since_projection);
+              write_double(out, checkpoint.distance);
+              write_u64(out, checkpoint.crossing_dimension);
+              write_u64(out, checkpoint.crossing_values);
+              return out.str();
+            }
+
+            /// \brief the header in the slot at the read position of in, if it is complete
+            std::optional<Checkpoint> read_slot (std::istream& in, std::uint64_t slot_size)
+            {
+              const auto sequence = read_u64(in);
+              const auto hash = read_u64(in);
+              const auto size = read_u64(in);
+              if (!in || sequence == 0 || size > slot_size - slot_prefix_size)
+                return std::nullopt;
+
+              std::string bytes(size, '\0');
+              in.read(bytes.data(), static_cast<std::streamsize>(size));
+              if (!in || fnv1a(bytes) != hash)
+                return std::nullopt;
+
+              std::istringstream header{bytes, std::ios::binary};
+
+              Checkpoint checkpoint{};
+              checkpoint.sequence = sequence;
+              checkpoint.fingerprint = read_doubles(header);
+              checkpoint.state = read_doubles(header);
+              checkpoint.t = read_double(header);
+              checkpoint.dt = read_double(header);
+              checkpoint.steps = read_u64(header);
+              checkpoint.steps_since_projection = read_u64(header);
+              checkpoint.distance = read_double(header);
+              checkpoint.crossing_dimension = read_u64(header);
+              checkpoint.crossing_values = read_u64(header);
+
+              if (!header)
+                return std::nullopt;
+
+              return checkpoint;
+            }
+        }
+
+        void save_checkpoint (const std::string& path, const Checkpoint& checkpoint,
+                              const std::vector<double>& new_crossings)
+        {
+          const auto header = serialize_header(checkpoint);
+
+          // the header keeps its size from save to save, so the slots are sized by the first one
+          if (checkpoint.sequence == 1)
+            {
+              std::ofstream out{path, std::ios::binary | std::ios::trunc};
+              out.write(checkpoint_magic.data(), checkpoint_magic.size());
+              write_u64(out, slot_prefix_size + header.size());
+              const std::string empty_slots(2 * (slot_prefix_size + header.size()), '\0');
+              out.write(empty_slots.data(), static_cast<std::streamsize>(empty_slots.size()));
+              if (!out)
+                throw std::runtime_error("cannot write the checkpoint " + path);
+            }
+
+          std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+
+          std::array<char, 8> magic{};
+          file.read(magic.data(), magic.size());
+          const auto slot_size = read_u64(file);
+          if (!file || magic != checkpoint_magic || slot_size != slot_prefix_size + header.size()
+              || checkpoint.crossing_values < new_crossings.size())
+            throw std::runtime_error("cannot write the checkpoint " + path);
+
+          // the new crossings first, past those of the last header, so that an interrupted save leaves it valid
+          const auto crossings_offset = slots_offset + 2 * slot_size;
+          const auto saved_values = checkpoint.crossing_values - new_crossings.size();
+          file.seekp(static_cast<std::streamoff>(crossings_offset + saved_values * sizeof(double)));
+          file.write(reinterpret_cast<const char*>(new_crossings.data()),
+                     static_cast<std::streamsize>(new_crossings.size() * sizeof(double)));
+          file.flush();
+
+          file.seekp(static_cast<std::streamoff>(slots_offset + (checkpoint.sequence % 2) * slot_size));
+          write_u64(file, checkpoint.sequence);
+          write_u64(file, fnv1a(header));
+          write_u64(file, header.size());
+          file.write(header.data(), static_cast<std::streamsize>(header.size()));
+          file.flush();
+
+          if (!file)
+            throw std::runtime_error("cannot write the checkpoint " + path);
+        }
+
+        std::optional<Checkpoint> load_checkpoint (const std::string& path)
+        {
+          std::ifstream in{path, std::ios::binary};
+          if (!in)
+            return std::nullopt;
+
+          in.seekg(0, std::ios::end);
+          const auto file_size = static_cast<std::uint64_t>(in.tellg());
+          in.seekg(0);
+
+          std::array<char, 8> magic{};
+          in.read(magic.data(), magic.size());
+          if (!in || magic != checkpoint_magic)
+            throw std::runtime_error(path + " is not a checkpoint");
+
+          const auto slot_size = read_u64(in);
+          if (!in || slot_size < slot_prefix_size || slot_size > file_size)
+            throw std::runtime_error("corrupt checkpoint " + path);
+
+          std::optional<Checkpoint> checkpoint{};
+          for (std::uint64_t slot = 0; slot < 2; ++slot)
+            {
+              in.clear();
+              in.seekg(static_cast<std::streamoff>(slots_offset + slot * slot_size));
+              auto candidate = read_slot(in, slot_size);
+              if (candidate && (!checkpoint || candidate->sequence > checkpoint->sequence))
+                checkpoint = std::move(candidate);
+            }
+
+          const auto crossings_offset = slots_offset + 2 * slot_size;
+          if (!checkpoint || checkpoint->crossing_dimension == 0
+              || checkpoint->crossing_values % checkpoint->crossing_dimension
+              || crossings_offset > file_size
+              || checkpoint->crossing_values > (file_size - crossings_offset) / sizeof(double))
+            throw std::runtime_error("corrupt checkpoint " + path);
+
+          checkpoint->crossings.resize(checkpoint->crossing_values);
+          in.clear();
+          in.seekg(static_cast<std::streamoff>(crossings_offset));
+          in.read(reinterpret_cast<char*>(checkpoint->crossings.data()),
+                  static_cast<std::streamsize>(checkpoint->crossings.size() * sizeof(double)));
+          if (!in)
+            throw std::runtime_error("corrupt checkpoint " + path);
+
+          return checkpoint;
+        }
+    }
+}
@@ -0,0 +1,144 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "details/batch_math.hpp"
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        namespace
+        {
+            // pi/2 in three parts, for the Cody-Waite reduction
+            constexpr double pi_over_two_1 = 1.57079625129699707031e+00;
+            constexpr double pi_over_two_2 = 7.54978941586159635336e-08;
+            constexpr double pi_over_two_3 = 5.39030285815811905290e-15;
+            constexpr double two_over_pi = 6.36619772367581382433e-01;
+
+            // adding and subtracting 1.5 * 2^52 rounds to the nearest integer without a branch or a conversion
+            constexpr double round_to_integer = 6755399441055744.0;
+
+            constexpr double reduction_limit = 1e8;
+
+            // the three parts of pi/2 leave an error of about 1e-30 per multiple of pi/2 removed, so near the zeros of
+            // sin and cos the reduced argument is accurate only while |r| is well above 1e-14 |x|
+            constexpr double cancellation_limit = 1e-13;
+
+            inline double sin_polynomial (double r, double r2) noexcept
+            {
+              const double p = ((((1.58962301576546568060e-10 * r2
+                                   - 2.50507477628578072866e-8) * r2
+                                  + 2.75573136213857245213e-6) * r2
+                                 - 1.98412698295895385996e-4) * r2
+                                + 8.33333333332211858878e-3) * r2
+                               - 1.66666666666666307295e-1;
+              return r + r * r2 * p;
+            }
+
+            inline double cos_polynomial (double r2) noexcept
+            {
+              const double p = ((((-1.13585365213876817300e-11 * r2
+                                   + 2.08757008419747316778e-9) * r2
+                                  - 2.75573141792967388112e-7) * r2
+                                 + 2.48015872888517045348e-5) * r2
+                                - 1.38888888888730564116e-3) * r2
+                               + 4.16666666666665929218e-2;
+              return 1.0 - 0.5 * r2 + r2 * r2 * p;
+            }
+
+            inline double round_nearest (double x) noexcept
+            {
+              return (x + round_to_integer) - round_to_integer;
+            }
+
+            /// \brief reduces x to r in [-pi/4, pi/4], with x = r + k*pi/2, and returns k mod 4 in quadrant, as one of
+            /// -2, -1, 0, 1, 2. std::floor would not be vectorized under the default -ftrapping-math.
+            inline double reduce (double x, double& quadrant) noexcept
+            {
+              const double k = round_nearest(x * two_over_pi);
+              quadrant = k - 4 * round_nearest(0.25 * k);
+              return ((x - k * pi_over_two_1) - k * pi_over_two_2) - k * pi_over_two_3;
+            }
+
+            /// \brief marks as NaN the results of the arguments x beyond reduction_limit, or reduced to r by
+            /// cancellation, see cancellation_limit
+            inline double if_reduced (double x, double r, double value) noexcept
+            {
+              const double a = std::abs(x);
+              return a < reduction_limit && std::abs(r) >= cancellation_limit * a
+                     ? value : std::numeric_limits<double>::quiet_NaN();
+            }
+
+            /// \brief applies kernel(in, out) on zero padded copies of x, one chunk at a time. The kernels run over a
+            /// constant trip count on non aliasing arrays, which the vectorizer needs at -O2. The results that the
+            /// kernels mark as NaN, see if_reduced, are calculated by scalar.
+            template<typename Kernel, typename Scalar>
+            void for_each_chunk (const double* x, double* out, size_t n, Kernel kernel, Scalar scalar) noexcept
+            {
+              alignas(64) double in[batch_chunk_size];
+              alignas(64) double result[batch_chunk_size];
+
+              for (size_t offset = 0; offset < n; offset += batch_chunk_size)
+                {
+                  const auto count = std::min(batch_chunk_size, n - offset);
+
+                  std::copy(x + offset, x + offset + count, in);
+                  std::fill(in + count, in + batch_chunk_size, 0.0);
+
+                  kernel(in, result);
+
+                  for (size_t i = 0; i < count; ++i)
+                    out[offset + i] = std::isnan(result[i]) ? scalar(in[i]) : result[i];
+                }
+            }
+
+            void sin_chunk (const double* __restrict__ x, double* __restrict__ out) noexcept
+            {
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                {
+                  double quadrant;
+                  const double r = reduce(x[i], quadrant);
+                  const double r2 = r * r;
+
+                  const double s = sin_polynomial(r, r2);
+                  const double c = cos_polynomial(r2);
+
+                  const double value = std::abs(quadrant) == 1.0 ? c : s;
+                  out[i] = if_reduced(x[i], r, (quadrant == -1.0 || std::abs(quadrant) == 2.0) ? -value : value);
+                }
+            }
+
+            void cos_chunk (const double* __restrict__ x, double* __restrict__ out) noexcept
+            {
+              for (size_t i = 0; i < batch_chunk_size; ++i)
+                {
+                  double quadrant;
+                  const double r = reduce(x[i], quadrant);
+                  const double r2 = r * r;
+
+                  const double s = sin_polynomial(r, r2);
+                  const double c = cos_polynomial(r2);
+
+                  const double value = std::abs(quadrant) == 1.0 ? s : c;
+                  out[i] = if_reduced(x[i], r, (quadrant == 1.0 || std::abs(quadrant) == 2.0) ? -value : value);
+                }
+            }
+        }
+
+        void sin_batch (const double* x, double* out, size_t n) noexcept
+        {
+          for_each_chunk(x, out, n, sin_chunk, [] (double y)
+          { return std::sin(y); });
+        }
+
+        void cos_batch (const double* x, double* out, size_t n) noexcept
+        {
+          for_each_chunk(x, out, n, cos_chunk, [] (double y)
+          { return std::cos(y); });
+        }
+    }
+}
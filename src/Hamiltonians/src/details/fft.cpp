@@ -0,0 +1,83 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <boost/math/constants/constants.hpp>
+#include "details/fft.hpp"
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        namespace
+        {
+            /// \brief the plain complex product; operator* checks for infinities and NaNs in a library call
+            inline std::complex<double> multiply (std::complex<double> a, std::complex<double> b) noexcept
+            {
+              return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+            }
+        }
+
+        size_t next_power_of_two (size_t n) noexcept
+        {
+          size_t power = 1;
+          while (power < n)
+            power *= 2;
+          return power;
+        }
+
+        FFTPlan::FFTPlan (size_t size)
+            : size_(size), bit_reversed_(size), twiddles_(size / 2)
+        {
+          if (size == 0 || next_power_of_two(size) != size)
+            throw std::invalid_argument("FFTPlan: the size must be a power of 2");
+
+          size_t bits = 0;
+          while ((size_t{1} << bits) < size)
+            ++bits;
+
+          for (size_t i = 0; i < size; ++i)
+            {
+              size_t reversed = 0;
+              for (size_t b = 0; b < bits; ++b)
+                reversed |= ((i >> b) & 1u) << (bits - 1 - b);
+              bit_reversed_[i] = reversed;
+            }
+
+          // computed directly rather than by recurrence, for accuracy at large sizes
+          for (size_t k = 0; k < size / 2; ++k)
+            twiddles_[k] = std::polar(1.0, -boost::math::double_constants::two_pi * static_cast<double>(k)
+                                           / static_cast<double>(size));
+        }
+
+        size_t FFTPlan::size () const noexcept
+        {
+          return size_;
+        }
+
+        void FFTPlan::forward (std::complex<double>* data) const noexcept
+        {
+          for (size_t i = 0; i < size_; ++i)
+            if (i < bit_reversed_[i])
+              std::swap(data[i], data[bit_reversed_[i]]);
+
+          for (size_t length = 2; length <= size_; length *= 2)
+            {
+              const auto half = length / 2;
+              const auto stride = size_ / length;
+
+              for (size_t start = 0; start < size_; start += length)
+                for (size_t k = 0; k < half; ++k)
+                  {
+                    const auto even = data[start + k];
+                    const auto odd = multiply(data[start + k + half], twiddles_[k * stride]);
+                    data[start + k] = even + odd;
+                    data[start + k + half] = even - odd;
+                  }
+            }
+        }
+    }
+}
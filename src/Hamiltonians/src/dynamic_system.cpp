@@ -10,5 +10,6 @@ namespace Integrators
     {
         template class DynamicSystem<Hamiltonian::HarmonicOscillator>;
         template class DynamicSystem<Hamiltonian::DuffingHamiltonian>;
+        template class DynamicSystem<Hamiltonian::HenonHeilesHamiltonian>;
     }
 }
\ No newline at end of file
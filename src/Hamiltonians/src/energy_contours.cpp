@@ -0,0 +1,332 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <boost/math/constants/constants.hpp>
+#include "energy_contours.hpp"
+
+namespace Integrators
+{
+    using Geometry::State2;
+
+    PhaseSpaceGrid::PhaseSpaceGrid (double q_min, double q_max, size_t n_q, double p_min, double p_max, size_t n_p)
+        : q_min_(q_min), q_max_(q_max), p_min_(p_min), p_max_(p_max), n_q_(n_q), n_p_(n_p)
+    {
+      if (n_q < 2 || n_p < 2)
+        throw std::invalid_argument("PhaseSpaceGrid: at least two nodes are needed in each direction");
+      if (!(q_min < q_max) || !(p_min < p_max))
+        throw std::invalid_argument("PhaseSpaceGrid: empty range");
+    }
+
+    size_t PhaseSpaceGrid::n_q () const noexcept
+    {
+      return n_q_;
+    }
+
+    size_t PhaseSpaceGrid::n_p () const noexcept
+    {
+      return n_p_;
+    }
+
+    double PhaseSpaceGrid::q (size_t i_q) const noexcept
+    {
+      return q_min_ + (q_max_ - q_min_) * static_cast<double>(i_q) / static_cast<double>(n_q_ - 1);
+    }
+
+    double PhaseSpaceGrid::p (size_t i_p) const noexcept
+    {
+      return p_min_ + (p_max_ - p_min_) * static_cast<double>(i_p) / static_cast<double>(n_p_ - 1);
+    }
+
+    EnergyRaster::EnergyRaster (PhaseSpaceGrid grid, std::vector<double> values)
+        : grid_(grid), values_(std::move(values))
+    {
+      if (values_.size() != grid_.n_q() * grid_.n_p())
+        throw std::invalid_argument("EnergyRaster: the number of values does not match the grid");
+    }
+
+    const PhaseSpaceGrid& EnergyRaster::grid () const noexcept
+    {
+      return grid_;
+    }
+
+    const std::vector<double>& EnergyRaster::values () const noexcept
+    {
+      return values_;
+    }
+
+    double EnergyContour::enclosed_area () const noexcept
+    {
+      if (!closed)
+        return std::numeric_limits<double>::quiet_NaN();
+
+      double twice_area = 0;
+      for (size_t i = 0; i < points.size(); ++i)
+        {
+          const auto& a = points[i];
+          const auto& b = points[(i + 1) % points.size()];
+          twice_area += a[0] * b[1] - b[0] * a[1];
+        }
+
+      return std::abs(twice_area) / 2;
+    }
+
+    double EnergyContour::action () const noexcept
+    {
+      return enclosed_area() * boost::math::double_constants::one_div_two_pi;
+    }
+
+    namespace
+    {
+        /// \brief The grid edges that a level set crosses are identified by a single index: the horizontal edges
+        /// (i_q, i_p)-(i_q+1, i_p) come first, then the vertical edges (i_q, i_p)-(i_q, i_p+1).
+        class EdgeIndex {
+          size_t n_q_;
+          size_t number_of_horizontal_;
+         public:
+          explicit EdgeIndex (const PhaseSpaceGrid& grid)
+              : n_q_(grid.n_q()), number_of_horizontal_((grid.n_q() - 1) * grid.n_p())
+          {}
+
+          size_t horizontal (size_t i_q, size_t i_p) const noexcept
+          {
+            return i_p * (n_q_ - 1) + i_q;
+          }
+
+          size_t vertical (size_t i_q, size_t i_p) const noexcept
+          {
+            return number_of_horizontal_ + i_p * n_q_ + i_q;
+          }
+
+          /// \brief the point on the edge where the linear interpolation of the raster equals energy
+          State2 crossing (const EnergyRaster& raster, size_t edge, double energy) const noexcept
+          {
+            const auto& grid = raster.grid();
+
+            size_t i_q, i_p, j_q, j_p;
+            if (edge < number_of_horizontal_)
+              {
+                i_q = edge % (n_q_ - 1);
+                i_p = edge / (n_q_ - 1);
+                j_q = i_q + 1;
+                j_p = i_p;
+              }
+            else
+              {
+                i_q = (edge - number_of_horizontal_) % n_q_;
+                i_p = (edge - number_of_horizontal_) / n_q_;
+                j_q = i_q;
+                j_p = i_p + 1;
+              }
+
+            const auto v_i = raster.value(i_q, i_p);
+            const auto v_j = raster.value(j_q, j_p);
+            const auto t = v_i == v_j ? 0.5 : (energy - v_i) / (v_j - v_i);
+
+            return State2{grid.q(i_q) + t * (grid.q(j_q) - grid.q(i_q)),
+                          grid.p(i_p) + t * (grid.p(j_p) - grid.p(i_p))};
+          }
+        };
+
+        using Segment = std::array<size_t, 2>;
+
+        /// \brief marching squares: the segments of the level set in every cell, as pairs of crossed edges
+        std::vector<Segment> cell_segments (const EnergyRaster& raster, const EdgeIndex& edges, double energy)
+        {
+          const auto& grid = raster.grid();
+          std::vector<Segment> segments{};
+
+          for (size_t i_p = 0; i_p + 1 < grid.n_p(); ++i_p)
+            for (size_t i_q = 0; i_q + 1 < grid.n_q(); ++i_q)
+              {
+                // corners counterclockwise from the bottom left
+                const std::array<double, 4> v{raster.value(i_q, i_p), raster.value(i_q + 1, i_p),
+                                              raster.value(i_q + 1, i_p + 1), raster.value(i_q, i_p + 1)};
+
+                const unsigned above = (v[0] >= energy ? 1u : 0u) | (v[1] >= energy ? 2u : 0u)
+                                       | (v[2] >= energy ? 4u : 0u) | (v[3] >= energy ? 8u : 0u);
+
+                if (above == 0u || above == 15u)
+                  continue;
+
+                // bottom, right, top, left
+                const std::array<size_t, 4> e{edges.horizontal(i_q, i_p), edges.vertical(i_q + 1, i_p),
+                                              edges.horizontal(i_q, i_p + 1), edges.vertical(i_q, i_p)};
+
+                if (above == 5u || above == 10u)
+                  {
+                    // saddle: the centre decides whether the corners 0, 2 or the corners 1, 3 are connected
+                    const auto centre_above = (v[0] + v[1] + v[2] + v[3]) / 4 >= energy;
+                    const auto corner_0_above = (above & 1u) != 0u;
+
+                    if (centre_above == corner_0_above)
+                      {
+                        segments.push_back({e[0], e[1]});
+                        segments.push_back({e[2], e[3]});
+                      }
+                    else
+                      {
+                        segments.push_back({e[3], e[0]});
+                        segments.push_back({e[1], e[2]});
+                      }
+                    continue;
+                  }
+
+                // exactly two edges have corners on different sides of the level
+                std::array<size_t, 2> crossed{};
+                size_t n = 0;
+                for (unsigned k = 0; k < 4; ++k)
+                  {
+                    const auto a = (above >> k) & 1u;
+                    const auto b = (above >> ((k + 1) % 4)) & 1u;
+                    if (a != b)
+                      crossed[n++] = e[k];
+                  }
+                segments.push_back(crossed);
+              }
+
+          return segments;
+        }
+
+        /// \brief the segments that touch every crossed edge; at most two, one from each neighbouring cell
+        class EdgeSegments {
+          static constexpr size_t none = std::numeric_limits<size_t>::max();
+          std::unordered_map<size_t, std::array<size_t, 2>> map_{};
+         public:
+          explicit EdgeSegments (const std::vector<Segment>& segments)
+          {
+            map_.reserve(2 * segments.size());
+            for (size_t s = 0; s < segments.size(); ++s)
+              for (auto edge: segments[s])
+                {
+                  auto[it, inserted] = map_.try_emplace(edge, std::array<size_t, 2>{s, none});
+                  if (!inserted)
+                    it->second[1] = s;
+                }
+          }
+
+          /// \brief the other segment through edge, or none
+          size_t next (size_t edge, size_t segment) const
+          {
+            const auto& pair = map_.at(edge);
+            return pair[0] == segment ? pair[1] : pair[0];
+          }
+
+          static bool is_none (size_t segment) noexcept
+          {
+            return segment == none;
+          }
+        };
+
+        /// \brief follows the chain of segments from edge, away from segment, and appends the edges it meets.
+        /// Returns true if the chain came back to stop_edge.
+        bool follow (const std::vector<Segment>& segments, const EdgeSegments& edge_segments,
+                     std::vector<bool>& used, size_t segment, size_t edge, size_t stop_edge,
+                     std::vector<size_t>& chain)
+        {
+          while (true)
+            {
+              const auto next = edge_segments.next(edge, segment);
+              if (EdgeSegments::is_none(next) || used[next])
+                return false;
+
+              used[next] = true;
+              segment = next;
+              edge = segments[next][0] == edge ? segments[next][1] : segments[next][0];
+
+              if (edge == stop_edge)
+                return true;
+
+              chain.push_back(edge);
+            }
+        }
+    }
+
+    std::vector<EnergyContour> extract_contours (const EnergyRaster& raster, double energy)
+    {
+      const EdgeIndex edges{raster.grid()};
+      const auto segments = cell_segments(raster, edges, energy);
+      const EdgeSegments edge_segments{segments};
+
+      std::vector<bool> used(segments.size(), false);
+      std::vector<EnergyContour> contours{};
+
+      for (size_t s = 0; s < segments.size(); ++s)
+        {
+          if (used[s])
+            continue;
+          used[s] = true;
+
+          std::vector<size_t> chain{segments[s][0], segments[s][1]};
+          const auto closed = follow(segments, edge_segments, used, s, segments[s][1], segments[s][0], chain);
+
+          if (!closed)
+            {
+              // the contour leaves the grid: collect the other half, and put it in front
+              std::vector<size_t> backward{};
+              follow(segments, edge_segments, used, s, segments[s][0], segments[s][1], backward);
+              chain.insert(chain.begin(), backward.rbegin(), backward.rend());
+            }
+
+          EnergyContour contour{};
+          contour.energy = energy;
+          contour.closed = closed;
+          contour.points.reserve(chain.size());
+          for (auto edge: chain)
+            contour.points.push_back(edges.crossing(raster, edge, energy));
+
+          contours.push_back(std::move(contour));
+        }
+
+      return contours;
+    }
+
+    std::vector<std::vector<EnergyContour>> extract_contours (const EnergyRaster& raster,
+                                                              const std::vector<double>& energies,
+                                                              unsigned number_of_threads)
+    {
+      std::vector<std::vector<EnergyContour>> contours(energies.size());
+
+      Internals::parallel_for(energies.size(), number_of_threads, [&] (size_t i)
+      {
+          contours[i] = extract_contours(raster, energies[i]);
+      });
+
+      return contours;
+    }
+
+    template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::FreeParticle& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+
+    template
+    EnergyRaster evaluate_on_grid (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                   const PhaseSpaceGrid& grid,
+                                   unsigned number_of_threads,
+                                   size_t rows_per_tile);
+}
@@ -0,0 +1,236 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <boost/math/constants/constants.hpp>
+#include <boost/math/tools/minima.hpp>
+#include "frequency_analysis.hpp"
+
+namespace Integrators
+{
+    namespace
+    {
+        /// \brief the plain complex product; operator* checks for infinities and NaNs in a library call
+        inline std::complex<double> multiply (std::complex<double> a, std::complex<double> b) noexcept
+        {
+          return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+        }
+
+        /// \brief the exponentials of the correlations are advanced by multiplication, and recomputed this often to
+        /// keep the rounding errors from accumulating
+        constexpr size_t exponential_refresh = 256;
+    }
+
+    FrequencyAnalyzer::FrequencyAnalyzer (size_t number_of_samples, double time_step, size_t number_of_frequencies)
+        : number_of_samples_(number_of_samples),
+          time_step_(time_step),
+          number_of_frequencies_(number_of_frequencies),
+          plan_(Internals::next_power_of_two(std::max<size_t>(number_of_samples, 1))),
+          times_(number_of_samples),
+          window_(number_of_samples),
+          samples_(number_of_samples),
+          residual_(number_of_samples),
+          spectrum_(plan_.size())
+    {
+      if (number_of_samples < 2)
+        throw std::invalid_argument("FrequencyAnalyzer: at least two samples are needed");
+      if (!(time_step > 0))
+        throw std::invalid_argument("FrequencyAnalyzer: the time step must be positive");
+
+      const auto n = static_cast<double>(number_of_samples);
+      for (size_t i = 0; i < number_of_samples; ++i)
+        {
+          times_[i] = time_step * static_cast<double>(i);
+          // Hann window, normalized to a mean of 1
+          window_[i] = 1 - std::cos(boost::math::double_constants::two_pi * static_cast<double>(i) / n);
+        }
+    }
+
+    size_t FrequencyAnalyzer::number_of_samples () const noexcept
+    {
+      return number_of_samples_;
+    }
+
+    double FrequencyAnalyzer::time_step () const noexcept
+    {
+      return time_step_;
+    }
+
+    size_t FrequencyAnalyzer::number_of_frequencies () const noexcept
+    {
+      return number_of_frequencies_;
+    }
+
+    std::complex<double> FrequencyAnalyzer::correlation (double omega) const noexcept
+    {
+      const auto rotation = std::polar(1.0, -omega * time_step_);
+
+      std::complex<double> sum{};
+      std::complex<double> exponential{};
+      for (size_t i = 0; i < number_of_samples_; ++i)
+        {
+          exponential = i % exponential_refresh == 0
+                        ? std::polar(1.0, -omega * times_[i])
+                        : multiply(exponential, rotation);
+          sum += window_[i] * multiply(residual_[i], exponential);
+        }
+
+      return sum / static_cast<double>(number_of_samples_);
+    }
+
+    double FrequencyAnalyzer::power_slope (double omega) const noexcept
+    {
+      const auto rotation = std::polar(1.0, -omega * time_step_);
+
+      std::complex<double> sum{};
+      std::complex<double> t_sum{};
+      std::complex<double> exponential{};
+      for (size_t i = 0; i < number_of_samples_; ++i)
+        {
+          exponential = i % exponential_refresh == 0
+                        ? std::polar(1.0, -omega * times_[i])
+                        : multiply(exponential, rotation);
+          const auto term = window_[i] * multiply(residual_[i], exponential);
+          sum += term;
+          t_sum += times_[i] * term;
+        }
+
+      // d|C|^2/domega = 2 Re(conj(C) dC/domega), with dC/domega = -i sum t w f exp(-i omega t)
+      return 2 * std::real(std::conj(sum) * std::complex<double>{t_sum.imag(), -t_sum.real()});
+    }
+
+    double FrequencyAnalyzer::refine (double omega, double half_width) const
+    {
+      // Brent's method locates the maximum of |C|^2 to about sqrt(epsilon) of the bracket, where |C|^2 is flat
+      const auto[omega_max, minus_power] = boost::math::tools::brent_find_minima(
+          [this] (double w)
+          { return -std::norm(correlation(w)); },
+          omega - half_width,
+          omega + half_width,
+          std::numeric_limits<double>::digits / 2);
+      static_cast<void>(minus_power);
+
+      // a few secant steps on the slope of |C|^2, which crosses zero linearly, polish it to full precision
+      const auto delta = half_width * 1e-6;
+      auto w0 = omega_max - delta;
+      auto w1 = omega_max + delta;
+      auto g0 = power_slope(w0);
+      auto g1 = power_slope(w1);
+      for (size_t iteration = 0; iteration < 4 && g1 != g0; ++iteration)
+        {
+          const auto w2 = w1 - g1 * (w1 - w0) / (g1 - g0);
+          if (!(std::abs(w2 - omega_max) < half_width))
+            break;
+          w0 = w1;
+          g0 = g1;
+          w1 = w2;
+          g1 = power_slope(w1);
+        }
+
+      return std::abs(w1 - omega_max) < half_width ? w1 : omega_max;
+    }
+
+    void FrequencyAnalyzer::add_to_residual (const FrequencyComponent& component, double sign) noexcept
+    {
+      const auto rotation = std::polar(1.0, component.frequency * time_step_);
+      std::complex<double> exponential{};
+      for (size_t i = 0; i < number_of_samples_; ++i)
+        {
+          exponential = i % exponential_refresh == 0
+                        ? std::polar(1.0, component.frequency * times_[i])
+                        : multiply(exponential, rotation);
+          residual_[i] += sign * multiply(component.amplitude, exponential);
+        }
+    }
+
+    std::vector<FrequencyComponent> FrequencyAnalyzer::analyze (Span<const std::complex<double>> signal)
+    {
+      if (signal.size() != number_of_samples_)
+        throw std::invalid_argument("FrequencyAnalyzer: the signal does not have number_of_samples samples");
+
+      std::copy(signal.begin(), signal.end(), residual_.begin());
+
+      const auto fft_size = plan_.size();
+      const auto bin_width = boost::math::double_constants::two_pi / (static_cast<double>(fft_size) * time_step_);
+
+      std::vector<FrequencyComponent> components{};
+      components.reserve(number_of_frequencies_);
+
+      for (size_t k = 0; k < number_of_frequencies_; ++k)
+        {
+          for (size_t i = 0; i < number_of_samples_; ++i)
+            spectrum_[i] = window_[i] * residual_[i];
+          std::fill(spectrum_.begin() + static_cast<std::ptrdiff_t>(number_of_samples_), spectrum_.end(),
+                    std::complex<double>{});
+
+          plan_.forward(spectrum_.data());
+
+          size_t peak = 0;
+          for (size_t i = 1; i < fft_size; ++i)
+            if (std::norm(spectrum_[i]) > std::norm(spectrum_[peak]))
+              peak = i;
+
+          if (std::norm(spectrum_[peak]) == 0)
+            break;
+
+          // bins past the middle are negative frequencies
+          const auto signed_peak = peak < fft_size / 2
+                                   ? static_cast<double>(peak)
+                                   : static_cast<double>(peak) - static_cast<double>(fft_size);
+          const auto omega_peak = signed_peak * bin_width;
+
+          // the maximum of the windowed correlation lies within a bin of the peak
+          const auto omega = refine(omega_peak, bin_width);
+
+          // the window has a mean of 1, so the correlation is the amplitude
+          components.push_back(FrequencyComponent{omega, correlation(omega)});
+          add_to_residual(components.back(), -1);
+        }
+
+      // every term was refined in the presence of the weaker ones, which shift its maximum through the window
+      // leakage. Refining every term again, with all the others projected out, removes most of that shift.
+      if (components.size() > 1)
+        for (auto& component: components)
+          {
+            add_to_residual(component, 1);
+            component.frequency = refine(component.frequency, 0.1 * bin_width);
+            component.amplitude = correlation(component.frequency);
+            add_to_residual(component, -1);
+          }
+
+      return components;
+    }
+
+    template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::HarmonicOscillator& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::DuffingHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::PendulumHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::FreeParticle& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+
+    template
+    std::vector<FrequencyComponent>
+    FrequencyAnalyzer::analyze_orbit<Steppers::Default> (const Hamiltonian::SplinePotentialHamiltonian& hamiltonian,
+                                                         const Geometry::State2& s_start,
+                                                         const IntegrationOptions& options);
+}
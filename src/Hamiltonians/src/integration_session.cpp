@@ -0,0 +1,15 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include "integration_session.hpp"
+
+namespace Integrators
+{
+    template class IntegrationSession<Hamiltonian::HarmonicOscillator>;
+    template class IntegrationSession<Hamiltonian::DuffingHamiltonian>;
+    template class IntegrationSession<Hamiltonian::PendulumHamiltonian>;
+    template class IntegrationSession<Hamiltonian::FreeParticle>;
+    template class IntegrationSession<Hamiltonian::SplinePotentialHamiltonian>;
+    template class IntegrationSession<Hamiltonian::HenonHeilesHamiltonian>;
+}
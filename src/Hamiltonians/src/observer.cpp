@@ -10,25 +10,8 @@ namespace Integrators
     namespace Observer
     {
 
-        void PushBackObserver::operator() (Geometry::State2_Extended s)
-        {
-          if (!(count++ % every_))
-            {
-              s_.push_back(s);
-
-              }
-
-        }
-        PushBackObserver::PushBackObserver ( size_t every)
-            :
-            every_{every > 0 ? every : 1}
-        {
-
-        }
-        std::vector<PushBackObserver::value_type> PushBackObserver::observations () const noexcept
-        {
-          return s_;
-        }
+        template class BasicPushBackObserver<Geometry::State2_Extended>;
+        template class BasicPushBackObserver<Geometry::State4_Extended>;
 
         bool crossZeroPositiveDirectionPredicate (double current_value, double previous_value)
         {
@@ -42,5 +42,10 @@ namespace Integrators
         {
           return distance_;
         }
+
+        void PeriodicQSurfaceCrossObserver::restore_distance (double distance) noexcept
+        {
+          distance_ = distance;
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <system_error>
+#include "result_cache.hpp"
+#include "details/binary_io.hpp"
+
+namespace Integrators
+{
+    namespace Internals
+    {
+        CacheKey& CacheKey::add (std::uint64_t value)
+        {
+          std::array<unsigned char, sizeof(value)> bytes{};
+          std::memcpy(bytes.data(), &value, sizeof(value));
+          bytes_.insert(bytes_.end(), bytes.begin(), bytes.end());
+          return *this;
+        }
+
+        CacheKey& CacheKey::add (double value)
+        {
+          std::uint64_t bits = 0;
+          std::memcpy(&bits, &value, sizeof(value));
+          return add(bits);
+        }
+
+        CacheKey& CacheKey::add (const std::string& value)
+        {
+          add(std::uint64_t{value.size()});
+          bytes_.insert(bytes_.end(), value.begin(), value.end());
+          return *this;
+        }
+
+        CacheKey& CacheKey::add (const std::vector<double>& values)
+        {
+          add(std::uint64_t{values.size()});
+          for (const auto value: values)
+            add(value);
+          return *this;
+        }
+
+        const std::vector<unsigned char>& CacheKey::bytes () const noexcept
+        {
+          return bytes_;
+        }
+
+        std::uint64_t CacheKey::hash () const noexcept
+        {
+          std::uint64_t hash = 14695981039346656037ull;
+          for (const auto byte: bytes_)
+            {
+              hash ^= byte;
+              hash *= 1099511628211ull;
+            }
+          return hash;
+        }
+    }
+
+    namespace
+    {
+        constexpr std::array<char, 8> entry_magic{'H', 'A', 'M', 'C', 'A', 'C', 'H', '1'};
+        constexpr const char* entry_extension = ".entry";
+        constexpr const char* temporary_extension = ".tmp";
+
+        /// \brief a name no other writer, in this process or another, uses at the same time
+        std::string temporary_suffix ()
+        {
+          thread_local std::mt19937_64 generator{std::random_device{}()};
+          return "." + std::to_string(generator()) + temporary_extension;
+        }
+
+        std::vector<double> flatten (const std::vector<Geometry::State2>& positions)
+        {
+          std::vector<double> values{};
+          values.reserve(2 * positions.size());
+          for (const auto& s: positions)
+            {
+              values.push_back(s.q());
+              values.push_back(s.p());
+            }
+          return values;
+        }
+    }
+
+    ResultCache::ResultCache (std::filesystem::path directory, std::uintmax_t max_bytes)
+        : directory_{std::move(directory)},
+          max_bytes_{max_bytes}
+    {
+      std::filesystem::create_directories(directory_);
+    }
+
+    std::filesystem::path ResultCache::entry_path (const Internals::CacheKey& key) const
+    {
+      std::array<char, 17> name{};
+      std::snprintf(name.data(), name.size(), "%016llx", static_cast<unsigned long long>(key.hash()));
+      return directory_ / (std::string{name.data()} + entry_extension);
+    }
+
+    std::optional<ActionAngleOrbit> ResultCache::load (const Internals::CacheKey& key) const
+    {
+      const auto path = entry_path(key);
+
+      // an entry removed by another process after it was opened can still be read
+      std::ifstream in{path, std::ios::binary};
+      if (!in)
+        return std::nullopt;
+
+      std::array<char, 8> magic{};
+      in.read(magic.data(), magic.size());
+
+      const auto key_size = Internals::read_u64(in);
+      if (!in || magic != entry_magic || key_size != key.bytes().size())
+        return std::nullopt;
+
+      std::vector<unsigned char> key_bytes(key_size);
+      in.read(reinterpret_cast<char*>(key_bytes.data()), static_cast<std::streamsize>(key_size));
+      if (!in || key_bytes != key.bytes())
+        return std::nullopt;
+
+      const auto action_two_pi = Internals::read_double(in);
+      const auto omega = Internals::read_double(in);
+      const auto theta = Internals::read_doubles(in);
+      const auto position_values = Internals::read_doubles(in);
+      if (!in || position_values.size() != 2 * theta.size())
+        return std::nullopt;
+
+      std::vector<Geometry::State2> positions(theta.size());
+      for (size_t i = 0; i < positions.size(); ++i)
+        positions[i] = Geometry::State2{position_values[2 * i], position_values[2 * i + 1]};
+
+      std::error_code ignored{};
+      std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ignored);
+
+      return ActionAngleOrbit{action_two_pi, omega, theta, positions};
+    }
+
+    void ResultCache::store (const Internals::CacheKey& key, const ActionAngleOrbit& orbit)
+    {
+      const auto path = entry_path(key);
+      auto temporary_path = path;
+      temporary_path += temporary_suffix();
+
+      {
+        std::ofstream out{temporary_path, std::ios::binary | std::ios::trunc};
+        if (!out)
+          throw std::runtime_error("cannot write the cache entry " + temporary_path.string());
+
+        out.write(entry_magic.data(), entry_magic.size());
+        Internals::write_u64(out, key.bytes().size());
+        out.write(reinterpret_cast<const char*>(key.bytes().data()),
+                  static_cast<std::streamsize>(key.bytes().size()));
+        Internals::write_double(out, orbit.action_two_pi());
+        Internals::write_double(out, orbit.omega());
+        Internals::write_doubles(out, orbit.theta());
+        Internals::write_doubles(out, flatten(orbit.positions()));
+
+        out.flush();
+        if (!out)
+          {
+            out.close();
+            std::error_code ignored{};
+            std::filesystem::remove(temporary_path, ignored);
+            throw std::runtime_error("cannot write the cache entry " + temporary_path.string());
+          }
+      }
+
+      std::filesystem::rename(temporary_path, path);
+
+      std::error_code error{};
+      const auto size = std::filesystem::file_size(path, error);
+      const auto written = bytes_since_eviction_ += error ? 0 : size;
+      if (!evicted_ || written > max_bytes_ / 16)
+        evict();
+    }
+
+    void ResultCache::evict ()
+    {
+      struct Entry {
+          std::filesystem::path path;
+          std::filesystem::file_time_type time;
+          std::uintmax_t size;
+      };
+
+      evicted_ = true;
+      bytes_since_eviction_ = 0;
+
+      std::vector<Entry> entries{};
+      std::uintmax_t total_size = 0;
+
+      const auto stale_time = std::filesystem::file_time_type::clock::now() - stale_temporary_age;
+
+      // other processes add and remove entries meanwhile, so every file operation may fail
+      std::error_code error{};
+      for (std::filesystem::directory_iterator it{directory_, error}, end{}; !error && it != end; it.increment(error))
+        {
+          const auto extension = it->path().extension();
+          const bool temporary = extension == temporary_extension;
+          if (!temporary && extension != entry_extension)
+            continue;
+
+          std::error_code entry_error{};
+          const auto size = it->file_size(entry_error);
+          const auto time = it->last_write_time(entry_error);
+          if (entry_error)
+            continue;
+
+          // a temporary file is either being written, and counts towards the size, or was left by a crashed writer
+          if (temporary)
+            {
+              std::error_code ignored{};
+              if (time >= stale_time || !std::filesystem::remove(it->path(), ignored))
+                total_size += size;
+              continue;
+            }
+
+          entries.push_back(Entry{it->path(), time, size});
+          total_size += size;
+        }
+
+      if (total_size <= max_bytes_)
+        return;
+
+      std::sort(entries.begin(), entries.end(), [] (const Entry& a, const Entry& b)
+      { return a.time < b.time; });
+
+      for (const auto& entry: entries)
+        {
+          if (total_size <= max_bytes_)
+            break;
+
+          std::error_code ignored{};
+          if (std::filesystem::remove(entry.path, ignored))
+            total_size -= entry.size;
+        }
+    }
+
+    const std::filesystem::path& ResultCache::directory () const noexcept
+    {
+      return directory_;
+    }
+
+    std::uintmax_t ResultCache::max_bytes () const noexcept
+    {
+      return max_bytes_;
+    }
+}
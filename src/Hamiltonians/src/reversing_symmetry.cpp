@@ -0,0 +1,37 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include "reversing_symmetry.hpp"
+
+namespace Integrators
+{
+    namespace Geometry
+    {
+        ReversingSymmetry::ReversingSymmetry (Line fixed_line) noexcept
+            : fixed_line_(std::move(fixed_line))
+        { }
+
+        ReversingSymmetry ReversingSymmetry::momentum_reversal ()
+        {
+          return ReversingSymmetry{Line{State2{0, 0}, State2{0, 1}}};
+        }
+
+        ReversingSymmetry ReversingSymmetry::position_reversal ()
+        {
+          return ReversingSymmetry{Line{State2{0, 0}, State2{1, 0}}};
+        }
+
+        const Line& ReversingSymmetry::fixed_line () const noexcept
+        {
+          return fixed_line_;
+        }
+
+        State2 ReversingSymmetry::operator() (const State2& s) const noexcept
+        {
+          const auto normal = fixed_line_.perpendicular_vector();
+
+          return s - normal * (2 * fixed_line_(s) / magnitude_squared(normal));
+        }
+    }
+}
@@ -0,0 +1,11 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include "section_recurrence.hpp"
+
+namespace Integrators
+{
+    template class CrossingIndex<1>;
+    template class CrossingIndex<2>;
+}
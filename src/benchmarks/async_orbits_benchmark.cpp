@@ -0,0 +1,76 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Periods of pendulum librations, with come_back_home_closed_orbit called in turn and with Async::
+// come_back_home_closed_orbit submitted to an OrbitExecutor, whose queue is smaller than the number of requests so that
+// the submissions are held back. Every request carries its own tolerance. Prints the time per orbit of both and the
+// largest difference between their periods, which run the same code and must agree exactly.
+//
+// usage: async_orbits_benchmark [number_of_requests] [number_of_threads] [queue_capacity]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "async_orbits.hpp"
+
+using namespace Integrators;
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_requests = argc > 1 ? std::stoul(argv[1]) : 2000;
+  const auto number_of_threads = static_cast<unsigned>(argc > 2 ? std::stoul(argv[2]) : 0);
+  const size_t queue_capacity = argc > 3 ? std::stoul(argv[3]) : 64;
+
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  const TimeInterval integration_time{0, 100, 0.5};
+
+  std::vector<Geometry::State2> seeds(number_of_requests);
+  std::vector<IntegrationOptions> options(number_of_requests);
+  for (size_t i = 0; i < number_of_requests; ++i)
+    {
+      const auto x = static_cast<double>(i) / static_cast<double>(number_of_requests);
+      seeds[i] = Geometry::State2{0.1 + 2.4 * x, 0};
+
+      const auto tolerance = i % 2 == 0 ? 1e-10 : 1e-8;
+      options[i].set_abs_err(tolerance);
+      options[i].set_rel_err(tolerance);
+      options[i].set_distance_threshold(1e-6);
+    }
+
+  std::vector<double> sequential_periods(number_of_requests);
+  const auto t_sequential_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < number_of_requests; ++i)
+    sequential_periods[i] = come_back_home_closed_orbit(pendulum, seeds[i], integration_time, options[i]).t();
+  const auto t_sequential =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - t_sequential_start).count();
+
+  std::vector<double> async_periods(number_of_requests);
+  const auto t_async_start = std::chrono::steady_clock::now();
+  OrbitExecutor executor{number_of_threads, queue_capacity};
+  {
+    std::vector<std::future<Geometry::State2_Extended>> futures{};
+    futures.reserve(number_of_requests);
+    for (size_t i = 0; i < number_of_requests; ++i)
+      futures.push_back(Async::come_back_home_closed_orbit(executor, pendulum, seeds[i], integration_time, options[i]));
+
+    for (size_t i = 0; i < number_of_requests; ++i)
+      async_periods[i] = futures[i].get().t();
+  }
+  const auto t_async = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_async_start).count();
+
+  double max_difference = 0;
+  for (size_t i = 0; i < number_of_requests; ++i)
+    max_difference = std::max(max_difference, std::abs(sequential_periods[i] - async_periods[i]));
+
+  const auto requests = static_cast<double>(number_of_requests);
+  std::cout << "threads " << executor.number_of_threads() << ", queue " << executor.queue_capacity() << '\n';
+  std::cout << "us/orbit sequential\tus/orbit async\tmax period difference\n";
+  std::cout << 1e6 * t_sequential / requests << '\t' << 1e6 * t_async / requests << '\t' << max_difference << '\n';
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Batched value_batch/derivative_batch against a loop over the scalar value/derivative, for all the models.
+// The largest differences from the scalar results are reported with the timings.
+//
+// usage: batch_benchmark [number_of_states] [repetitions]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "Hamiltonian.hpp"
+
+using namespace Integrators;
+using namespace Integrators::Geometry;
+
+template<typename F>
+double best_time (size_t repetitions, F f)
+{
+  double best = std::numeric_limits<double>::infinity();
+  for (size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+      const auto t_start = std::chrono::steady_clock::now();
+      f();
+      const auto t_stop = std::chrono::steady_clock::now();
+      best = std::min(best, std::chrono::duration<double>(t_stop - t_start).count());
+    }
+  return best;
+}
+
+template<typename Ham>
+void compare (const std::string& name, const Ham& hamiltonian, const std::vector<State2>& states, size_t repetitions)
+{
+  const auto n = states.size();
+
+  std::vector<double> values(n), values_batch(n);
+  std::vector<State2> derivatives(n), derivatives_batch(n);
+
+  const auto t_value = best_time(repetitions, [&] ()
+  {
+      for (size_t i = 0; i < n; ++i)
+        values[i] = hamiltonian.value(states[i]);
+  });
+
+  const auto t_value_batch = best_time(repetitions, [&] ()
+  { Hamiltonian::value_batch(hamiltonian, states, values_batch); });
+
+  const auto t_derivative = best_time(repetitions, [&] ()
+  {
+      for (size_t i = 0; i < n; ++i)
+        derivatives[i] = hamiltonian.derivative(states[i]);
+  });
+
+  const auto t_derivative_batch = best_time(repetitions, [&] ()
+  { Hamiltonian::derivative_batch(hamiltonian, states, derivatives_batch); });
+
+  double value_difference = 0;
+  double derivative_difference = 0;
+  for (size_t i = 0; i < n; ++i)
+    {
+      value_difference = std::max(value_difference, std::abs(values[i] - values_batch[i]));
+      derivative_difference = std::max(derivative_difference, magnitude(derivatives[i] - derivatives_batch[i]));
+    }
+
+  const auto ns = [n] (double t)
+  { return 1e9 * t / static_cast<double>(n); };
+
+  std::cout << name << '\t'
+            << ns(t_value) << '\t' << ns(t_value_batch) << '\t' << value_difference << '\t'
+            << ns(t_derivative) << '\t' << ns(t_derivative_batch) << '\t' << derivative_difference << '\n';
+}
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_states = argc > 1 ? std::stoul(argv[1]) : 100000;
+  const size_t repetitions = argc > 2 ? std::stoul(argv[2]) : 10;
+
+  std::mt19937 generator{42};
+  std::uniform_real_distribution<double> distribution{-10, 10};
+
+  std::vector<State2> states{};
+  states.reserve(number_of_states);
+  for (size_t i = 0; i < number_of_states; ++i)
+    states.push_back(State2{distribution(generator), distribution(generator)});
+
+  std::cout << "model\tvalue ns\tvalue_batch ns\tmax difference\tderivative ns\tderivative_batch ns\tmax difference\n";
+
+  compare("harmonic_oscillator", Hamiltonian::HarmonicOscillator{}, states, repetitions);
+  compare("duffing", Hamiltonian::DuffingHamiltonian{}, states, repetitions);
+  compare("pendulum", Hamiltonian::PendulumHamiltonian{1, 1}, states, repetitions);
+  compare("free_particle", Hamiltonian::FreeParticle{}, states, repetitions);
+
+  // the pendulum potential, tabulated on 1024 points
+  constexpr auto pi = boost::math::double_constants::pi;
+  std::vector<double> potential(1024);
+  for (size_t i = 0; i < potential.size(); ++i)
+    potential[i] = -std::cos(-pi + 2 * pi * static_cast<double>(i) / static_cast<double>(potential.size()));
+  compare("spline_potential",
+          Hamiltonian::SplinePotentialHamiltonian{-pi, pi, potential, 1,
+                                                  Hamiltonian::SplinePotentialHamiltonian::SplineBoundary::periodic},
+          states, repetitions);
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Rotation numbers of the stroboscopic map of pendulum librations: the time per orbit and the number of samples the
+// weighted Birkhoff average needs to converge, and its largest error against the analytical
+// omega T / 2pi mod 1, omega = pi / (2 K(sin(q0/2))). For comparison, the largest error of the plain average over
+// the same samples.
+//
+// usage: birkhoff_average_benchmark [number_of_seeds] [sampling_period]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+#include <boost/math/special_functions/ellint_1.hpp>
+
+#include "birkhoff_average.hpp"
+#include "frequency_analysis.hpp"
+
+using namespace Integrators;
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_seeds = argc > 1 ? std::stoul(argv[1]) : 100;
+  const double sampling_period = argc > 2 ? std::stod(argv[2]) : 1.3;
+
+  constexpr auto pi = boost::math::double_constants::pi;
+
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+
+  IntegrationOptions options;
+  options.set_abs_err(1e-14);
+  options.set_rel_err(1e-13);
+
+  const TimeInterval integration_time{0, 1e4 * sampling_period};
+
+  double t_birkhoff = 0;
+  size_t total_values = 0;
+  size_t unconverged = 0;
+  double max_error = 0;
+  double max_plain_error = 0;
+
+  for (size_t i = 0; i < number_of_seeds; ++i)
+    {
+      const Geometry::State2 seed{2.5 * static_cast<double>(i + 1) / static_cast<double>(number_of_seeds), 0};
+      const auto omega = pi / (2 * boost::math::ellint_1(std::sin(seed.q() / 2)));
+      const auto exact = std::fmod(omega * sampling_period / (2 * pi), 1.0);
+
+      const auto t_start = std::chrono::steady_clock::now();
+      const auto result = calculate_rotation_number(pendulum, seed, Geometry::State2{0, 0}, sampling_period,
+                                                    integration_time, options);
+      t_birkhoff += std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+      total_values += result.number_of_values;
+      unconverged += result.converged ? 0 : 1;
+      max_error = std::max(max_error, std::abs(result.average - exact));
+
+      // the plain average over the same samples
+      std::vector<double> times(result.number_of_values + 1);
+      for (size_t k = 0; k < times.size(); ++k)
+        times[k] = sampling_period * static_cast<double>(k);
+      std::vector<std::complex<double>> samples(times.size());
+      sample_orbit(pendulum, seed, times, options, Span<std::complex<double>>{samples});
+
+      double sum = 0;
+      for (size_t k = 1; k < samples.size(); ++k)
+        {
+          auto turn = std::arg(samples[k] / samples[k - 1]) / (2 * pi);
+          sum += turn < 0 ? turn + 1 : turn;
+        }
+      max_plain_error = std::max(max_plain_error, std::abs(sum / static_cast<double>(result.number_of_values) - exact));
+    }
+
+  std::cout << "ms/orbit\tmean values\tunconverged\tmax weighted error\tmax plain error\n"
+            << 1e3 * t_birkhoff / static_cast<double>(number_of_seeds) << '\t'
+            << static_cast<double>(total_values) / static_cast<double>(number_of_seeds) << '\t'
+            << unconverged << '\t' << max_error << '\t' << max_plain_error << '\n';
+
+  return 0;
+}
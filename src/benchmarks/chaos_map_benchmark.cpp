@@ -0,0 +1,71 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// A MEGNO/FLI map of the Duffing phase portrait, with the orbits stopped as soon as they are classified, against the
+// same map integrated over the whole time interval.
+//
+// usage: chaos_map_benchmark [seeds_per_side] [t_end] [number_of_threads]
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "chaos_indicators.hpp"
+
+using namespace Integrators;
+
+template<typename F>
+double wall_time (F f)
+{
+  const auto t_start = std::chrono::steady_clock::now();
+  f();
+  const auto t_stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t_stop - t_start).count();
+}
+
+int main (int argc, char* argv[])
+{
+  const size_t seeds_per_side = argc > 1 ? std::stoul(argv[1]) : 10;
+  const double t_end = argc > 2 ? std::stod(argv[2]) : 2000;
+  const unsigned number_of_threads = argc > 3 ? static_cast<unsigned>(std::stoul(argv[3])) : 0u;
+
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+
+  std::vector<Geometry::State2> seeds{};
+  for (size_t i = 0; i < seeds_per_side; ++i)
+    for (size_t j = 0; j < seeds_per_side; ++j)
+      seeds.push_back(Geometry::State2{-4 + 8 * (static_cast<double>(i) + 0.5) / static_cast<double>(seeds_per_side),
+                                       -4 + 8 * (static_cast<double>(j) + 0.5) / static_cast<double>(seeds_per_side)});
+
+  IntegrationOptions options;
+  options.set_abs_err(1e-12);
+  options.set_rel_err(1e-10);
+
+  const TimeInterval integrationTime{0, t_end};
+
+  ChaosIndicatorOptions early{};
+  ChaosIndicatorOptions full{};
+  full.stop_when_classified = false;
+
+  std::vector<ChaosIndicators> early_map{}, full_map{};
+
+  const auto t_early = wall_time([&] ()
+  { early_map = calculate_chaos_map(duffing, seeds, integrationTime, options, early, number_of_threads); });
+  const auto t_full = wall_time([&] ()
+  { full_map = calculate_chaos_map(duffing, seeds, integrationTime, options, full, number_of_threads); });
+
+  size_t agree = 0;
+  double mean_stop_time = 0;
+  for (size_t i = 0; i < seeds.size(); ++i)
+    {
+      agree += early_map[i].type == full_map[i].type;
+      mean_stop_time += early_map[i].time / static_cast<double>(seeds.size());
+    }
+
+  std::cout << "seeds\tearly s\tfull s\tmean stop time\tsame class\n"
+            << seeds.size() << '\t' << t_early << '\t' << t_full << '\t' << mean_stop_time << '\t'
+            << agree << '/' << seeds.size() << '\n';
+
+  return 0;
+}
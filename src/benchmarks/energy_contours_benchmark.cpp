@@ -0,0 +1,67 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// The pendulum phase portrait from one pass over a grid: the time to evaluate the raster and extract the librating
+// contours, and the largest error of their actions against analytical_action, for increasing resolutions.
+//
+// usage: energy_contours_benchmark [number_of_energies] [number_of_threads]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "energy_contours.hpp"
+
+using namespace Integrators;
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_energies = argc > 1 ? std::stoul(argv[1]) : 50;
+  const unsigned number_of_threads = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 0u;
+
+  constexpr auto pi = boost::math::double_constants::pi;
+
+  const Hamiltonian::PendulumHamiltonian pendulum{1, 1};
+
+  // librations only, between the bottom and the separatrix
+  std::vector<double> energies{};
+  for (size_t i = 1; i <= number_of_energies; ++i)
+    energies.push_back(-pendulum.F() + 1.9 * pendulum.F() * static_cast<double>(i)
+                                       / static_cast<double>(number_of_energies));
+
+  std::cout << "nodes\traster s\tcontours s\tcontours\tmax action error\n";
+
+  for (size_t n: {101u, 201u, 401u, 801u, 1601u, 3201u})
+    {
+      const PhaseSpaceGrid grid{-pi, pi, n, -2.5, 2.5, n};
+
+      const auto t_start = std::chrono::steady_clock::now();
+      const auto raster = evaluate_on_grid(pendulum, grid, number_of_threads);
+      const auto t_raster = std::chrono::steady_clock::now();
+      const auto contours = extract_contours(raster, energies, number_of_threads);
+      const auto t_contours = std::chrono::steady_clock::now();
+
+      size_t count = 0;
+      double max_error = 0;
+      for (size_t i = 0; i < energies.size(); ++i)
+        for (const auto& contour: contours[i])
+          {
+            ++count;
+            if (contour.closed)
+              max_error = std::max(max_error,
+                                   std::abs(contour.action() - pendulum.analytical_action(energies[i])));
+          }
+
+      std::cout << n << 'x' << n << '\t'
+                << std::chrono::duration<double>(t_raster - t_start).count() << '\t'
+                << std::chrono::duration<double>(t_contours - t_raster).count() << '\t'
+                << count << '\t' << max_error << '\n';
+    }
+
+  return 0;
+}
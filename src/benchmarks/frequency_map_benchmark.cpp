@@ -0,0 +1,79 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// The NAFF frequency map of pendulum librations: the time per orbit of the integration and of the analysis, and the
+// largest error of the fundamental frequency against the analytical pi / (2 K(sin(q0/2))).
+//
+// usage: frequency_map_benchmark [number_of_seeds] [number_of_samples] [number_of_frequencies]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+#include <boost/math/special_functions/ellint_1.hpp>
+
+#include "frequency_analysis.hpp"
+
+using namespace Integrators;
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_seeds = argc > 1 ? std::stoul(argv[1]) : 100;
+  const size_t number_of_samples = argc > 2 ? std::stoul(argv[2]) : 4096;
+  const size_t number_of_frequencies = argc > 3 ? std::stoul(argv[3]) : 4;
+
+  constexpr double time_step = 0.05;
+  constexpr auto pi = boost::math::double_constants::pi;
+
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+
+  IntegrationOptions options;
+  options.set_abs_err(1e-12);
+  options.set_rel_err(1e-12);
+
+  std::vector<Geometry::State2> seeds{};
+  for (size_t i = 0; i < number_of_seeds; ++i)
+    seeds.push_back(Geometry::State2{3.0 * static_cast<double>(i + 1) / static_cast<double>(number_of_seeds), 0});
+
+  FrequencyAnalyzer analyzer{number_of_samples, time_step, number_of_frequencies};
+  std::vector<double> times(number_of_samples);
+  for (size_t i = 0; i < number_of_samples; ++i)
+    times[i] = time_step * static_cast<double>(i);
+  std::vector<std::complex<double>> samples(number_of_samples);
+
+  double t_sampling = 0;
+  double t_analysis = 0;
+  double max_error = 0;
+
+  for (const auto& seed: seeds)
+    {
+      const auto t_start = std::chrono::steady_clock::now();
+      sample_orbit(pendulum, seed, times, options, Span<std::complex<double>>{samples});
+      const auto t_sampled = std::chrono::steady_clock::now();
+      const auto components = analyzer.analyze(Span<const std::complex<double>>{samples});
+      const auto t_analyzed = std::chrono::steady_clock::now();
+
+      t_sampling += std::chrono::duration<double>(t_sampled - t_start).count();
+      t_analysis += std::chrono::duration<double>(t_analyzed - t_sampled).count();
+
+      const auto exact = pi / (2 * boost::math::ellint_1(std::sin(seed.q() / 2)));
+      max_error = std::max(max_error, std::abs(components.front().frequency - exact));
+    }
+
+  const auto t_map_start = std::chrono::steady_clock::now();
+  const auto map = calculate_frequency_map(pendulum, seeds, number_of_samples, time_step, options,
+                                           number_of_frequencies);
+  const auto t_map = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_map_start).count();
+
+  const auto ms = [number_of_seeds] (double t)
+  { return 1e3 * t / static_cast<double>(number_of_seeds); };
+
+  std::cout << "sampling ms/orbit\tanalysis ms/orbit\tmap ms/orbit\tmax frequency error\n"
+            << ms(t_sampling) << '\t' << ms(t_analysis) << '\t' << ms(t_map) << '\t' << max_error << '\n';
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Periods of short pendulum librations, with come_back_home_closed_orbit called once per seed and with a single
+// IntegrationSession reset to every seed: the time per orbit of both, and the largest difference between their periods.
+// Both follow the same steps; they differ only by the rounding of the differently inlined (and contracted) code.
+//
+// usage: integration_session_benchmark [number_of_seeds]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "integration_session.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    template<typename StepperPolicy>
+    void run (const char* name, const std::vector<Geometry::State2>& seeds)
+    {
+      const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+
+      IntegrationOptions options;
+      options.set_abs_err(1e-10);
+      options.set_rel_err(1e-10);
+      options.set_distance_threshold(1e-6);
+
+      const TimeInterval integration_time{0, 100, 0.5};
+
+      std::vector<Geometry::State2_Extended> free_results(seeds.size());
+      std::vector<Geometry::State2_Extended> session_results(seeds.size());
+
+      const auto t_free_start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < seeds.size(); ++i)
+        free_results[i] = come_back_home_closed_orbit<StepperPolicy>(pendulum, seeds[i], integration_time, options);
+      const auto t_free = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_free_start).count();
+
+      const auto t_session_start = std::chrono::steady_clock::now();
+      IntegrationSession<Hamiltonian::PendulumHamiltonian, StepperPolicy> session{pendulum, integration_time, options};
+      for (size_t i = 0; i < seeds.size(); ++i)
+        {
+          session.reset(seeds[i]);
+          session_results[i] = session.come_back_home_closed_orbit();
+        }
+      const auto t_session = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_session_start).count();
+
+      double max_difference = 0;
+      for (size_t i = 0; i < seeds.size(); ++i)
+        max_difference = std::max(max_difference, std::abs(free_results[i].t() - session_results[i].t()));
+
+      const auto number_of_seeds = static_cast<double>(seeds.size());
+      std::cout << name << '\t' << 1e6 * t_free / number_of_seeds << '\t' << 1e6 * t_session / number_of_seeds
+                << '\t' << max_difference << '\n';
+    }
+}
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_seeds = argc > 1 ? std::stoul(argv[1]) : 2000;
+
+  std::vector<Geometry::State2> seeds(number_of_seeds);
+  for (size_t i = 0; i < number_of_seeds; ++i)
+    seeds[i] = Geometry::State2{0.1 + 2.4 * static_cast<double>(i) / static_cast<double>(number_of_seeds), 0};
+
+  std::cout << "stepper\tus/orbit free functions\tus/orbit session\tmax period difference\n";
+
+  run<Steppers::CashKarp54>("cash-karp", seeds);
+  run<Steppers::DormandPrince5>("dormand-prince", seeds);
+  run<Steppers::BulirschStoer>("bulirsch-stoer", seeds);
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// The per-step cost of iterating a pendulum orbit through the boost range of make_dynamic_system_integration_range
+// and through the coroutine of orbit_stream: once with an empty loop body, to isolate the overhead of the iteration,
+// and once with the observer of the crossings of q = 0. Both follow the same steps, which is checked on the number of
+// steps, the final state and the number of crossings.
+//
+// usage: orbit_stream_benchmark [t_end] [tolerance]
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "orbit_stream.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    struct Run {
+        double seconds = 0;
+        size_t steps = 0;
+        size_t crossings = 0;
+        Geometry::State2_Action last{};
+    };
+
+    template<typename MakeRange>
+    Run iterate (MakeRange make_range)
+    {
+      Run run{};
+      const auto t_start = std::chrono::steady_clock::now();
+
+      const auto& range = make_range();
+      for (const auto& s_t: range)
+        {
+          run.last = s_t.first;
+          ++run.steps;
+        }
+
+      run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+      return run;
+    }
+
+    template<typename MakeRange, typename DS>
+    Run observe (MakeRange make_range, const DS& system)
+    {
+      const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+
+      Run run{};
+      const auto t_start = std::chrono::steady_clock::now();
+
+      auto observer = make_project_on_line_observer(system, line, [] (const auto&)
+      { return true; });
+      const auto& range = make_range();
+      Observer::cross(observer, range);
+
+      run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+      run.crossings = observer.observations().size();
+      return run;
+    }
+
+    void report (const char* name, const Run& range_run, const Run& stream_run, size_t steps)
+    {
+      const auto steps_d = static_cast<double>(steps);
+      std::cout << name << '\t' << 1e9 * range_run.seconds / steps_d << '\t' << 1e9 * stream_run.seconds / steps_d
+                << '\n';
+    }
+}
+
+int main (int argc, char* argv[])
+{
+  const double t_end = argc > 1 ? std::stod(argv[1]) : 2e5;
+  const double tolerance = argc > 2 ? std::stod(argv[2]) : 1e-6;
+
+  const auto system = Dynamics::DynamicSystem{Hamiltonian::PendulumHamiltonian{1, 1}};
+  const Geometry::State2_Action s_start{Geometry::State2{2, 0}};
+  const TimeInterval integration_time{0, t_end};
+
+  IntegrationOptions options;
+  options.set_abs_err(tolerance);
+  options.set_rel_err(tolerance);
+
+  auto s_range = s_start;
+  const auto range_run = iterate([&] ()
+                                 {
+                                     s_range = s_start;
+                                     return make_dynamic_system_integration_range(system,
+                                                                                  s_range,
+                                                                                  integration_time,
+                                                                                  options);
+                                 });
+  const auto stream_run = iterate([&] ()
+                                  { return orbit_stream(system, s_start, integration_time, options); });
+
+  const auto range_observed = observe([&] ()
+                                      {
+                                          s_range = s_start;
+                                          return make_dynamic_system_integration_range(system,
+                                                                                       s_range,
+                                                                                       integration_time,
+                                                                                       options);
+                                      }, system);
+  const auto stream_observed = observe([&] ()
+                                       { return orbit_stream(system, s_start, integration_time, options); }, system);
+
+  std::cout << "steps: range " << range_run.steps << ", stream " << stream_run.steps
+            << "; final state difference " << magnitude(range_run.last - stream_run.last)
+            << "; crossings: range " << range_observed.crossings << ", stream " << stream_observed.crossings << '\n';
+
+  std::cout << "loop\tns/step boost range\tns/step orbit_stream\n";
+  report("empty", range_run, stream_run, range_run.steps);
+  report("observer", range_observed, stream_observed, range_run.steps);
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// A scan of e_gamma of the Duffing Hamiltonian, on the closed orbit through a fixed seed: every orbit integrated from
+// scratch, against scan_parameter with first and with second order updates. For each, the time, the number of orbits
+// integrated, and the largest error of the action and of omega against the integrated scan.
+//
+// usage: parameter_sensitivity_benchmark [number_of_values] [width] [tolerance]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parameter_sensitivity.hpp"
+
+using namespace Integrators;
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_values = argc > 1 ? std::stoul(argv[1]) : 200;
+  const double width = argc > 2 ? std::stod(argv[2]) : 0.4;
+  const double tolerance = argc > 3 ? std::stod(argv[3]) : 1e-6;
+
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+  const size_t e_gamma = 3;
+  const Geometry::State2 s_start{1, 0.3};
+  const TimeInterval integration_time{0, 1000};
+
+  IntegrationOptions options;
+  options.set_abs_err(1e-12);
+  options.set_rel_err(1e-12);
+  options.set_distance_threshold(1e-7);
+
+  std::vector<double> values(number_of_values);
+  const auto e_gamma_0 = duffing.get_e_gamma();
+  for (size_t i = 0; i < number_of_values; ++i)
+    values[i] = e_gamma_0 + width * static_cast<double>(i) / static_cast<double>(number_of_values - 1);
+
+  std::vector<double> actions(number_of_values);
+  std::vector<double> omegas(number_of_values);
+
+  auto t_start = std::chrono::steady_clock::now();
+  auto hamiltonian = duffing;
+  for (size_t i = 0; i < number_of_values; ++i)
+    {
+      hamiltonian.set_parameter(e_gamma, values[i]);
+      const auto orbit = come_back_home_closed_orbit(hamiltonian, s_start, integration_time, options);
+      actions[i] = orbit.J();
+      omegas[i] = boost::math::double_constants::two_pi / orbit.t();
+    }
+  const auto t_full = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+  std::cout << "order\tintegrated\tlargest error\tseconds\n";
+  std::cout << "full\t" << number_of_values << "\t0\t" << t_full << '\n';
+
+  for (const unsigned order: {1u, 2u})
+    {
+      t_start = std::chrono::steady_clock::now();
+      const auto points = scan_parameter(duffing, e_gamma, values, s_start, integration_time, options,
+                                         ParameterScanOptions{order, tolerance});
+      const auto t_scan = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+      size_t integrated = 0;
+      double max_error = 0;
+      for (size_t i = 0; i < number_of_values; ++i)
+        {
+          integrated += points[i].integrated;
+          max_error = std::max({max_error, std::abs(points[i].action - actions[i]),
+                                std::abs(points[i].omega - omegas[i])});
+        }
+
+      std::cout << order << '\t' << integrated << '\t' << max_error << '\t' << t_scan << '\n';
+    }
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// The crossings of q = 0 by a long pendulum orbit, post processed by a sink that costs `work` sine evaluations per
+// crossing, with the observer of make_project_on_line_observer_to_sink and with the pipelined observer, whose step
+// back, predicate and sink run on a second thread. Both see the same crossings, which is checked on their number and
+// on the largest difference between them. The processor time of the whole process is reported next to the wall time:
+// a second thread that waited by spinning would show up there.
+//
+// usage: pipelined_observer_benchmark [t_end] [work] [tolerance]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "pipelined_observer.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    struct Run {
+        double seconds = 0;
+        double cpu_seconds = 0;
+        std::vector<Geometry::State2_Extended> crossings{};
+        double checksum = 0;
+    };
+
+    /// \brief stores the crossings, after a computation that costs about work sine evaluations
+    struct ExpensiveSink {
+        Run* run;
+        size_t work;
+
+        void operator() (const Geometry::State2_Extended& crossing) const
+        {
+          double x = crossing.p();
+          for (size_t i = 0; i < work; ++i)
+            x = std::sin(x + crossing.t());
+          run->checksum += x;
+          run->crossings.push_back(crossing);
+        }
+    };
+
+    template<typename DS>
+    auto make_range (const DS& system, Geometry::State2_Action& s, const TimeInterval& integration_time,
+                     const IntegrationOptions& options)
+    {
+      return make_dynamic_system_integration_range(system, s, integration_time, options);
+    }
+}
+
+int main (int argc, char* argv[])
+{
+  const double t_end = argc > 1 ? std::stod(argv[1]) : 2e5;
+  const size_t work = argc > 2 ? std::stoul(argv[2]) : 200;
+  const double tolerance = argc > 3 ? std::stod(argv[3]) : 1e-6;
+
+  const auto system = Dynamics::DynamicSystem{Hamiltonian::PendulumHamiltonian{1, 1}};
+  const Geometry::State2_Action s_start{Geometry::State2{2, 0}};
+  const TimeInterval integration_time{0, t_end};
+  const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+
+  IntegrationOptions options;
+  options.set_abs_err(tolerance);
+  options.set_rel_err(tolerance);
+
+  const auto accept_all = [] (const auto&)
+  { return true; };
+
+  Run inline_run{};
+  {
+    const auto t_start = std::chrono::steady_clock::now();
+    const auto cpu_start = std::clock();
+
+    auto s = s_start;
+    auto observer = make_project_on_line_observer_to_sink(system, line, accept_all, ExpensiveSink{&inline_run, work});
+    Observer::cross(observer, make_range(system, s, integration_time, options));
+
+    inline_run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+    inline_run.cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  }
+
+  Run pipelined_run{};
+  {
+    const auto t_start = std::chrono::steady_clock::now();
+    const auto cpu_start = std::clock();
+
+    auto s = s_start;
+    auto observer = make_pipelined_project_on_line_observer(system, line, accept_all,
+                                                            ExpensiveSink{&pipelined_run, work});
+    Observer::cross(observer, make_range(system, s, integration_time, options));
+    observer.finish();
+
+    pipelined_run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+    pipelined_run.cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  }
+
+  double max_difference = 0;
+  const auto number_of_crossings = std::min(inline_run.crossings.size(), pipelined_run.crossings.size());
+  for (size_t i = 0; i < number_of_crossings; ++i)
+    max_difference = std::max(max_difference, magnitude(inline_run.crossings[i] - pipelined_run.crossings[i]));
+
+  std::cout << "crossings: inline " << inline_run.crossings.size() << ", pipelined " << pipelined_run.crossings.size()
+            << "; largest difference " << max_difference
+            << "; checksum difference " << std::abs(inline_run.checksum - pipelined_run.checksum) << '\n';
+
+  std::cout << "observer\tseconds\tcpu seconds\n";
+  std::cout << "inline\t" << inline_run.seconds << '\t' << inline_run.cpu_seconds << '\n';
+  std::cout << "pipelined\t" << pipelined_run.seconds << '\t' << pipelined_run.cpu_seconds << '\n';
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// The crossings of q = 0 by a long pendulum libration, integrated by calculate_crossings and predicted by
+// calculate_crossings_predictive: the time of both, the number of crossings, the largest differences between them in
+// time, in the state and in the action, and the largest drift of each from the exact period, 4 K(sin(q_0 / 2)).
+//
+// usage: predictive_crossings_benchmark [t_end] [tolerance] [distance_threshold]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <boost/math/special_functions/ellint_1.hpp>
+
+#include "predictive_crossings.hpp"
+
+using namespace Integrators;
+
+int main (int argc, char* argv[])
+{
+  const double t_end = argc > 1 ? std::stod(argv[1]) : 1e5;
+  const double tolerance = argc > 2 ? std::stod(argv[2]) : 1e-12;
+  const double distance_threshold = argc > 3 ? std::stod(argv[3]) : 1e-8;
+
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  const Geometry::State2 s_start{2, 0};
+  const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+  const TimeInterval integration_time{0, t_end};
+
+  IntegrationOptions options;
+  options.set_abs_err(tolerance);
+  options.set_rel_err(tolerance);
+  options.set_distance_threshold(distance_threshold);
+
+  auto t_start = std::chrono::steady_clock::now();
+  const auto integrated = calculate_crossings(pendulum, s_start, line, integration_time, options);
+  const auto t_integrated = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+  t_start = std::chrono::steady_clock::now();
+  const auto predicted = calculate_crossings_predictive(pendulum, s_start, line, integration_time, options);
+  const auto t_predicted = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+  const double exact_period = 4 * boost::math::ellint_1(std::sin(s_start.q() / 2));
+
+  auto drift = [exact_period] (const auto& crossings)
+  {
+      double max_drift = 0;
+      for (size_t k = 0; k < crossings.size(); ++k)
+        max_drift = std::max(max_drift, std::abs(crossings[k].t() - crossings.front().t()
+                                                 - static_cast<double>(k) * exact_period));
+      return max_drift;
+  };
+
+  double max_dt = 0;
+  double max_ds = 0;
+  double max_dJ = 0;
+  const auto number_of_crossings = std::min(integrated.size(), predicted.crossings.size());
+  for (size_t i = 0; i < number_of_crossings; ++i)
+    {
+      const auto& a = integrated[i];
+      const auto& b = predicted.crossings[i];
+      max_dt = std::max(max_dt, std::abs(a.t() - b.t()));
+      max_ds = std::max(max_ds, magnitude(Geometry::State2{a} - Geometry::State2{b}));
+      max_dJ = std::max(max_dJ, std::abs(a.J() - b.J()));
+    }
+
+  std::cout << "crossings: integrated " << integrated.size() << ", predicted " << predicted.crossings.size()
+            << " (" << predicted.integrated_crossings << " integrated), period "
+            << predicted.period.value_or(std::nan("")) << '\n';
+  std::cout << "largest differences: t " << max_dt << ", state " << max_ds << ", J " << max_dJ << '\n';
+  std::cout << "largest drift from the exact period: integrated " << drift(integrated) << ", predicted "
+            << drift(predicted.crossings) << '\n';
+  std::cout << "seconds integrated\tseconds predicted\n";
+  std::cout << t_integrated << '\t' << t_predicted << '\n';
+
+  return 0;
+}
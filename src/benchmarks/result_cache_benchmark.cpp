@@ -0,0 +1,102 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Action-angle orbits of pendulum librations through a ResultCache in a fresh directory: the time per orbit of the
+// first pass, which misses and integrates, and of the second pass, which hits; the largest difference between the
+// results of the two passes, which must be zero; and the size of the store after a third pass with a budget of a
+// quarter of the entries, which evicts.
+//
+// usage: result_cache_benchmark [number_of_seeds] [directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "result_cache.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    template<typename F>
+    double seconds (F f)
+    {
+      const auto t_start = std::chrono::steady_clock::now();
+      f();
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+    }
+
+    std::uintmax_t directory_size (const std::filesystem::path& directory)
+    {
+      std::uintmax_t size = 0;
+      for (const auto& entry: std::filesystem::directory_iterator{directory})
+        size += entry.file_size();
+      return size;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_seeds = argc > 1 ? std::stoul(argv[1]) : 200;
+  const std::filesystem::path directory = argc > 2 ? argv[2]
+                                                   : std::filesystem::temp_directory_path() / "result_cache_benchmark";
+
+  std::filesystem::remove_all(directory);
+
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  const TimeInterval integration_time{0, 100, 0.5};
+
+  IntegrationOptions options;
+  options.set_abs_err(1e-10);
+  options.set_rel_err(1e-10);
+  options.set_distance_threshold(1e-6);
+
+  std::vector<Geometry::State2> seeds(number_of_seeds);
+  for (size_t i = 0; i < number_of_seeds; ++i)
+    seeds[i] = Geometry::State2{0.1 + 2.4 * static_cast<double>(i) / static_cast<double>(number_of_seeds), 0};
+
+  std::vector<ActionAngleOrbit> misses(number_of_seeds);
+  std::vector<ActionAngleOrbit> hits(number_of_seeds);
+
+  ResultCache cache{directory};
+  const auto t_miss = seconds([&] ()
+                              {
+                                  for (size_t i = 0; i < number_of_seeds; ++i)
+                                    misses[i] = calculate_action_angle_on_closed_orbit(cache, pendulum, seeds[i],
+                                                                                       integration_time, options);
+                              });
+  const auto t_hit = seconds([&] ()
+                             {
+                                 for (size_t i = 0; i < number_of_seeds; ++i)
+                                   hits[i] = calculate_action_angle_on_closed_orbit(cache, pendulum, seeds[i],
+                                                                                    integration_time, options);
+                             });
+
+  double max_difference = 0;
+  for (size_t i = 0; i < number_of_seeds; ++i)
+    {
+      max_difference = std::max({max_difference,
+                                 std::abs(misses[i].action_two_pi() - hits[i].action_two_pi()),
+                                 std::abs(misses[i].omega() - hits[i].omega())});
+      for (size_t j = 0; j < misses[i].positions().size(); ++j)
+        max_difference = std::max(max_difference, magnitude(misses[i].positions()[j] - hits[i].positions()[j]));
+    }
+
+  const auto full_size = directory_size(directory);
+
+  ResultCache small_cache{directory, full_size / 4};
+  small_cache.evict();
+
+  const auto seeds_d = static_cast<double>(number_of_seeds);
+  std::cout << "us/orbit miss\tus/orbit hit\tmax difference\tbytes\tbytes after eviction to a quarter\n";
+  std::cout << 1e6 * t_miss / seeds_d << '\t' << 1e6 * t_hit / seeds_d << '\t' << max_difference << '\t'
+            << full_size << '\t' << directory_size(directory) << '\n';
+
+  std::filesystem::remove_all(directory);
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// The crossings of q1 = 0 by a quasi-periodic Henon-Heiles orbit, each looked up among the earlier ones by a
+// CrossingIndex and by a linear scan: the time per crossing of both, and the number of crossings on which they
+// disagree, which must be zero. Then calculate_section_recurrences on the same orbit, stopping once the section is
+// densely covered, and on a pendulum libration, stopping at its first recurrence.
+//
+// usage: section_recurrence_benchmark [t_end] [radius] [coverage_window]
+
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "section_recurrence.hpp"
+
+using namespace Integrators;
+
+int main (int argc, char* argv[])
+{
+  const double t_end = argc > 1 ? std::stod(argv[1]) : 2e5;
+  const double radius = argc > 2 ? std::stod(argv[2]) : 1e-3;
+  const size_t coverage_window = argc > 3 ? std::stoul(argv[3]) : 1000;
+
+  const auto henon_heiles = Hamiltonian::HenonHeilesHamiltonian{};
+  const Geometry::State4 s_start{0, 0.1, 0.39, 0.05};
+  const Geometry::Hyperplane<2> plane{Geometry::State4{0, 0, 0, 0}, Geometry::State4{1, 0, 0, 0}};
+
+  IntegrationOptions options;
+  options.set_abs_err(1e-10);
+  options.set_rel_err(1e-10);
+
+  const auto crossings = calculate_crossings(henon_heiles, s_start, plane, TimeInterval{0, t_end}, options);
+
+  std::vector<std::optional<size_t>> indexed(crossings.size());
+  std::vector<std::optional<size_t>> scanned(crossings.size());
+
+  auto t_start = std::chrono::steady_clock::now();
+  CrossingIndex<2> index{radius};
+  for (size_t i = 0; i < crossings.size(); ++i)
+    {
+      const Geometry::State4 s{crossings[i]};
+      indexed[i] = index.nearest(s);
+      index.insert(s);
+    }
+  const auto t_indexed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+  t_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < crossings.size(); ++i)
+    {
+      const Geometry::State4 s{crossings[i]};
+      double nearest_distance = radius;
+      for (size_t j = 0; j < i; ++j)
+        {
+          const auto distance = magnitude(Geometry::State4{crossings[j]} - s);
+          if (distance <= nearest_distance)
+            {
+              scanned[i] = j;
+              nearest_distance = distance;
+            }
+        }
+    }
+  const auto t_scanned = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+  size_t disagreements = 0;
+  for (size_t i = 0; i < crossings.size(); ++i)
+    disagreements += indexed[i] != scanned[i];
+
+  const auto n = static_cast<double>(crossings.size());
+  std::cout << "crossings " << crossings.size() << ", occupied cells " << index.occupied_cells()
+            << ", disagreements " << disagreements << '\n';
+  std::cout << "us/crossing index\tus/crossing linear scan\n";
+  std::cout << 1e6 * t_indexed / n << '\t' << 1e6 * t_scanned / n << '\n';
+
+  RecurrenceOptions recurrence_options;
+  recurrence_options.radius = radius;
+  recurrence_options.stop = RecurrenceStop::dense_coverage;
+  recurrence_options.coverage_window = coverage_window;
+
+  t_start = std::chrono::steady_clock::now();
+  const auto covered = calculate_section_recurrences(henon_heiles, s_start, plane, TimeInterval{0, t_end}, options,
+                                                     recurrence_options);
+  const auto t_covered = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+  std::cout << "dense coverage: " << (covered.densely_covered ? "reached" : "not reached") << " after "
+            << covered.crossings.size() << " crossings (t = "
+            << (covered.crossings.empty() ? 0 : covered.crossings.back().t()) << "), recurrence rate "
+            << covered.recurrence_rate() << ", occupied cells " << covered.occupied_cells << ", " << t_covered
+            << " s\n";
+
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  options.set_abs_err(1e-12);
+  options.set_rel_err(1e-12);
+  recurrence_options.radius = 1e-8;
+  recurrence_options.stop = RecurrenceStop::first_recurrence;
+
+  const auto libration = calculate_section_recurrences(pendulum, Geometry::State2{2, 0},
+                                                       Geometry::Line{Geometry::State2{0, 0}, Geometry::State2{1, 0}},
+                                                       TimeInterval{0, 100}, options, recurrence_options);
+  if (libration.first_recurrence)
+    std::cout << "pendulum libration: crossing " << libration.first_recurrence->index << " recurs crossing "
+              << libration.first_recurrence->earlier << " after " << libration.first_recurrence->turns
+              << " turns, period " << libration.first_recurrence->time << ", action "
+              << libration.first_recurrence->action << '\n';
+  else
+    std::cout << "pendulum libration: no recurrence\n";
+
+  return 0;
+}
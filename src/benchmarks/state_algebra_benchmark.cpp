@@ -0,0 +1,80 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Microbenchmark of a single Runge-Kutta step on the action system of the Duffing Hamiltonian, with odeint's
+// vector_space_algebra against Geometry::StateAlgebra.
+//
+// usage: state_algebra_benchmark [number_of_steps]
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <boost/numeric/odeint.hpp>
+
+#include "Hamiltonian.hpp"
+#include "dynamic_system.hpp"
+#include "state_algebra.hpp"
+
+using namespace Integrators;
+using namespace Integrators::Geometry;
+
+template<typename Stepper>
+double nanoseconds_per_step (const std::string& name, size_t number_of_steps)
+{
+  const auto system = Dynamics::DynamicSystem{Hamiltonian::DuffingHamiltonian{}};
+
+  const auto df = [&system] (const State2_Action& s, State2_Action& dsdt, double /*t*/)
+  {
+      dsdt = system.dynamic_system_Action(s);
+  };
+
+  Stepper stepper{};
+  State2_Action s{0.472035, 7.86664, 0};
+  State2_Action s_err{};
+  double t = 0;
+  const double dt = 1e-3;
+
+  const auto t_start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < number_of_steps; ++i)
+    {
+      stepper.do_step(df, s, t, dt, s_err);
+      t += dt;
+    }
+
+  const auto t_end = std::chrono::steady_clock::now();
+
+  const auto ns = std::chrono::duration<double, std::nano>(t_end - t_start).count() / static_cast<double>(number_of_steps);
+
+  std::cout << name << ":\t" << ns << " ns/step\t(end state " << s << ")\n";
+
+  return ns;
+}
+
+template<template<typename...> class ErrorStepper>
+void compare (const std::string& name, size_t number_of_steps)
+{
+  using boost::numeric::odeint::vector_space_algebra;
+  using boost::numeric::odeint::default_operations;
+
+  using VectorSpaceStepper = ErrorStepper<State2_Action, double, State2_Action, double,
+      vector_space_algebra, default_operations>;
+  using FusedStepper = ErrorStepper<State2_Action, double, State2_Action, double, StateAlgebra, StateOperations>;
+
+  const auto vector_space = nanoseconds_per_step<VectorSpaceStepper>(name + " vector_space_algebra", number_of_steps);
+  const auto fused = nanoseconds_per_step<FusedStepper>(name + " StateAlgebra", number_of_steps);
+
+  std::cout << name << " speedup:\t" << vector_space / fused << "\n\n";
+}
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_steps = argc > 1 ? std::stoul(argv[1]) : 2000000;
+
+  compare<boost::numeric::odeint::runge_kutta_cash_karp54>("cash_karp54", number_of_steps);
+  compare<boost::numeric::odeint::runge_kutta_dopri5>("dopri5", number_of_steps);
+  compare<boost::numeric::odeint::runge_kutta_fehlberg78>("fehlberg78", number_of_steps);
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Long Poincare section runs of the Duffing Hamiltonian with the Taylor stepper against Cash-Karp (and Fehlberg 7(8)).
+//
+// For every stepper and tolerance the wall time, the number of crossings, the energy drift at the last crossing and
+// the distance of the last crossing from the one of the Taylor stepper at the tightest tolerance are recorded.
+//
+// usage: taylor_benchmark [t_end] [repetitions]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Hamiltonian.hpp"
+#include "Integration.hpp"
+#include "steppers.hpp"
+
+using namespace Integrators;
+using namespace Integrators::Geometry;
+
+struct SectionRun {
+    std::vector<State2_Extended> crossings{};
+    double wall_time = std::numeric_limits<double>::infinity();
+};
+
+const std::vector<State2>& reference_orbits ()
+{
+  static const std::vector<State2> orbits{{1.0, 0.5}, {0.472035, 7.86664}, {0.1, 3.0}};
+  return orbits;
+}
+
+template<typename StepperPolicy>
+SectionRun section_run (const State2& s_start, double rel_err, double t_end, size_t repetitions)
+{
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+
+  IntegrationOptions options;
+  options.set_rel_err(rel_err);
+  options.set_abs_err(rel_err * 1e-2);
+
+  const Geometry::Line section{{0, 0}, {1, 0}};
+
+  SectionRun run{};
+
+  for (size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+      const auto t_start = std::chrono::steady_clock::now();
+
+      run.crossings = calculate_crossings<StepperPolicy>(duffing, s_start, section, TimeInterval{0, t_end}, options);
+
+      const auto t_stop = std::chrono::steady_clock::now();
+      run.wall_time = std::min(run.wall_time, std::chrono::duration<double>(t_stop - t_start).count());
+    }
+
+  return run;
+}
+
+template<typename StepperPolicy>
+void report (const std::string& stepper_name, double t_end, size_t repetitions,
+             const std::vector<SectionRun>& references)
+{
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+
+  for (const auto rel_err: {1e-8, 1e-10, 1e-12, 1e-14})
+    {
+      for (size_t i = 0; i < reference_orbits().size(); ++i)
+        {
+          const auto& s_start = reference_orbits()[i];
+          const auto run = section_run<StepperPolicy>(s_start, rel_err, t_end, repetitions);
+
+          const auto& reference = references[i].crossings;
+
+          const auto energy_drift = run.crossings.empty()
+                                    ? std::nan("")
+                                    : std::abs(duffing.value(State2{run.crossings.back()}) - duffing.value(s_start));
+
+          const auto last_crossing_error =
+              run.crossings.size() == reference.size() && !reference.empty()
+              ? magnitude(State2{run.crossings.back()} - State2{reference.back()})
+              : std::nan("");
+
+          std::cout << stepper_name << '\t'
+                    << rel_err << '\t'
+                    << i << '\t'
+                    << run.crossings.size() << '\t'
+                    << energy_drift << '\t'
+                    << last_crossing_error << '\t'
+                    << run.wall_time << '\n';
+        }
+    }
+}
+
+int main (int argc, char* argv[])
+{
+  const double t_end = argc > 1 ? std::stod(argv[1]) : 20000;
+  const size_t repetitions = argc > 2 ? std::stoul(argv[2]) : 3;
+
+  std::vector<SectionRun> references{};
+  for (const auto& s_start: reference_orbits())
+    references.push_back(section_run<Steppers::Taylor>(s_start, 1e-15, t_end, 1));
+
+  std::cout << "stepper\trel_err\torbit\tcrossings\tenergy_drift\tlast_crossing_error\twall_time\n";
+
+  report<Steppers::CashKarp54>("cash_karp54", t_end, repetitions, references);
+  report<Steppers::Fehlberg78>("fehlberg78", t_end, repetitions, references);
+  report<Steppers::Taylor>("taylor", t_end, repetitions, references);
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// come_back_home_closed_orbit and come_back_home_closed_orbit_two_level on a scan of pendulum seeds, half librations,
+// which come back, and half rotations, which do not: the time per seed of both, the number of orbits each accepted,
+// and the largest difference between their periods and actions, which must be zero.
+//
+// usage: two_level_return_benchmark [number_of_seeds] [t_end] [tolerance]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "two_level_return.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    template<typename F>
+    std::vector<std::optional<Geometry::State2_Extended>> scan (const std::vector<Geometry::State2>& seeds, F f,
+                                                                double& seconds)
+    {
+      std::vector<std::optional<Geometry::State2_Extended>> results(seeds.size());
+
+      const auto t_start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < seeds.size(); ++i)
+        {
+          try
+            {
+              results[i] = f(seeds[i]);
+            }
+          catch (const std::runtime_error&)
+            { }
+        }
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+      return results;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+  const size_t number_of_seeds = argc > 1 ? std::stoul(argv[1]) : 200;
+  const double t_end = argc > 2 ? std::stod(argv[2]) : 100;
+  const double tolerance = argc > 3 ? std::stod(argv[3]) : 1e-12;
+
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  const TimeInterval integration_time{0, t_end};
+
+  IntegrationOptions options;
+  options.set_abs_err(tolerance);
+  options.set_rel_err(tolerance);
+  options.set_distance_threshold(1e-8);
+
+  std::vector<Geometry::State2> seeds(number_of_seeds);
+  for (size_t i = 0; i < number_of_seeds; ++i)
+    {
+      const auto x = static_cast<double>(i / 2) / static_cast<double>(number_of_seeds / 2);
+      seeds[i] = i % 2 == 0 ? Geometry::State2{0.1 + 2.9 * x, 0} : Geometry::State2{0, 2.1 + 2 * x};
+    }
+
+  double t_fine = 0;
+  double t_two_level = 0;
+
+  const auto fine = scan(seeds, [&] (const Geometry::State2& s)
+  {
+      return come_back_home_closed_orbit(pendulum, s, integration_time, options);
+  }, t_fine);
+
+  const auto two_level = scan(seeds, [&] (const Geometry::State2& s)
+  {
+      return come_back_home_closed_orbit_two_level(pendulum, s, integration_time, options);
+  }, t_two_level);
+
+  size_t fine_accepted = 0;
+  size_t two_level_accepted = 0;
+  size_t disagreements = 0;
+  double max_difference = 0;
+  for (size_t i = 0; i < number_of_seeds; ++i)
+    {
+      fine_accepted += fine[i].has_value();
+      two_level_accepted += two_level[i].has_value();
+      if (fine[i].has_value() != two_level[i].has_value())
+        ++disagreements;
+      else if (fine[i])
+        max_difference = std::max({max_difference,
+                                   std::abs(fine[i]->t() - two_level[i]->t()),
+                                   std::abs(fine[i]->J() - two_level[i]->J())});
+    }
+
+  const auto seeds_d = static_cast<double>(number_of_seeds);
+  std::cout << "accepted: fine " << fine_accepted << ", two level " << two_level_accepted << "; disagreements "
+            << disagreements << "; largest difference " << max_difference << '\n';
+  std::cout << "us/seed fine\tus/seed two level\n";
+  std::cout << 1e6 * t_fine / seeds_d << '\t' << 1e6 * t_two_level / seeds_d << '\n';
+
+  return 0;
+}
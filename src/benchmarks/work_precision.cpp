@@ -0,0 +1,217 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Work-precision benchmark for the integration tolerances and the stepper policies.
+//
+// The action of a set of closed pendulum orbits is calculated numerically and compared with
+// PendulumHamiltonian::analytical_action. For every stepper and tolerance the error, the number of evaluations of the
+// Hamiltonian's derivative and the wall time are recorded.
+//
+// usage: work_precision [output_basename] [repetitions]
+// writes <output_basename>.csv and <output_basename>.json
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "Hamiltonian.hpp"
+#include "Integration.hpp"
+#include "steppers.hpp"
+
+using namespace Integrators;
+using namespace Integrators::Geometry;
+
+/// \brief Forwards to Ham and counts the evaluations of the derivative, i.e. of the right hand side of the system.
+template<typename Ham>
+class CountingHamiltonian {
+  Ham ham_;
+  size_t* evaluations_;
+ public:
+  CountingHamiltonian (Ham ham, size_t* evaluations)
+      : ham_{std::move(ham)}, evaluations_{evaluations}
+  { }
+
+  double value (const State2& s) const noexcept
+  {
+    return ham_.value(s);
+  }
+
+  State2 derivative (const State2& s) const noexcept
+  {
+    ++*evaluations_;
+    return ham_.derivative(s);
+  }
+};
+
+struct WorkPrecisionPoint {
+    std::string stepper{};
+    double rel_err = 0;
+    double abs_err = 0;
+    double max_error = 0;
+    double mean_error = 0;
+    size_t rhs_evaluations = 0;
+    double wall_time = 0;
+    size_t failures = 0;
+};
+
+const std::vector<State2>& reference_orbits ()
+{
+  static const std::vector<State2> orbits{{0.1, 0}, {0.5, 0}, {1.0, 0}, {2.0, 0}, {2.8, 0}, {0.3, 0.4}};
+  return orbits;
+}
+
+template<typename StepperPolicy>
+WorkPrecisionPoint measure (const std::string& stepper_name, double rel_err, size_t repetitions)
+{
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+
+  IntegrationOptions options;
+  options.set_rel_err(rel_err);
+  options.set_abs_err(rel_err * 1e-2);
+  options.set_distance_threshold(1e-3);
+
+  const TimeInterval integrationTime{0, 1000};
+
+  WorkPrecisionPoint point{};
+  point.stepper = stepper_name;
+  point.rel_err = options.rel_err;
+  point.abs_err = options.abs_err;
+  point.wall_time = std::numeric_limits<double>::infinity();
+
+  for (size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+      size_t evaluations = 0;
+      const auto hamiltonian = CountingHamiltonian<Hamiltonian::PendulumHamiltonian>{pendulum, &evaluations};
+
+      double max_error = 0;
+      double sum_error = 0;
+      size_t failures = 0;
+
+      const auto t_start = std::chrono::steady_clock::now();
+
+      for (const auto& s_start: reference_orbits())
+        {
+          const auto analytical_action = pendulum.analytical_action(s_start);
+          try
+            {
+              const auto s_home = come_back_home_closed_orbit<StepperPolicy>(hamiltonian,
+                                                                             s_start,
+                                                                             integrationTime,
+                                                                             options);
+              const auto numerical_action = s_home.J() * boost::math::double_constants::one_div_two_pi;
+              const auto error = std::abs(numerical_action - analytical_action) / analytical_action;
+
+              max_error = std::max(max_error, error);
+              sum_error += error;
+            }
+          catch (std::exception&)
+            {
+              ++failures;
+            }
+        }
+
+      const auto t_end = std::chrono::steady_clock::now();
+
+      const auto successes = reference_orbits().size() - failures;
+
+      point.max_error = successes ? max_error : std::nan("");
+      point.mean_error = successes ? sum_error / static_cast<double>(successes) : std::nan("");
+      point.rhs_evaluations = evaluations;
+      point.failures = failures;
+      point.wall_time = std::min(point.wall_time, std::chrono::duration<double>(t_end - t_start).count());
+    }
+
+  return point;
+}
+
+template<typename StepperPolicy>
+void sweep_tolerances (std::vector<WorkPrecisionPoint>& points, const std::string& stepper_name, size_t repetitions)
+{
+  for (const auto rel_err: {1e-6, 1e-7, 1e-8, 1e-9, 1e-10, 1e-11, 1e-12, 1e-13, 1e-14})
+    {
+      points.push_back(measure<StepperPolicy>(stepper_name, rel_err, repetitions));
+      std::cerr << stepper_name << " rel_err = " << rel_err << " done\n";
+    }
+}
+
+void write_csv (const std::string& filename, const std::vector<WorkPrecisionPoint>& points)
+{
+  std::ofstream out(filename);
+  out.precision(10);
+  out << "stepper,rel_err,abs_err,max_error,mean_error,rhs_evaluations,wall_time,failures\n";
+  for (const auto& p: points)
+    out << p.stepper << ','
+        << p.rel_err << ','
+        << p.abs_err << ','
+        << p.max_error << ','
+        << p.mean_error << ','
+        << p.rhs_evaluations << ','
+        << p.wall_time << ','
+        << p.failures << '\n';
+}
+
+std::string json_number (double x)
+{
+  if (!std::isfinite(x))
+    return "null";
+
+  std::ostringstream out;
+  out.precision(10);
+  out << x;
+  return out.str();
+}
+
+void write_json (const std::string& filename, const std::vector<WorkPrecisionPoint>& points)
+{
+  std::ofstream out(filename);
+  out.precision(10);
+  out << "[\n";
+  for (size_t i = 0; i < points.size(); ++i)
+    {
+      const auto& p = points[i];
+      out << "  {\"stepper\": \"" << p.stepper << "\", "
+          << "\"rel_err\": " << p.rel_err << ", "
+          << "\"abs_err\": " << p.abs_err << ", "
+          << "\"max_error\": " << json_number(p.max_error) << ", "
+          << "\"mean_error\": " << json_number(p.mean_error) << ", "
+          << "\"rhs_evaluations\": " << p.rhs_evaluations << ", "
+          << "\"wall_time\": " << p.wall_time << ", "
+          << "\"failures\": " << p.failures << '}'
+          << (i + 1 < points.size() ? ",\n" : "\n");
+    }
+  out << "]\n";
+}
+
+int main (int argc, char* argv[])
+{
+  const std::string basename = argc > 1 ? argv[1] : "work_precision";
+  const size_t repetitions = argc > 2 ? std::stoul(argv[2]) : 3;
+
+  std::vector<WorkPrecisionPoint> points{};
+
+  sweep_tolerances<Steppers::CashKarp54>(points, "cash_karp54", repetitions);
+  sweep_tolerances<Steppers::DormandPrince5>(points, "dormand_prince5", repetitions);
+  sweep_tolerances<Steppers::Fehlberg78>(points, "fehlberg78", repetitions);
+  sweep_tolerances<Steppers::BulirschStoer>(points, "bulirsch_stoer", repetitions);
+
+  write_csv(basename + ".csv", points);
+  write_json(basename + ".json", points);
+
+  std::cout << "stepper\trel_err\tmax_error\trhs_evaluations\twall_time\n";
+  for (const auto& p: points)
+    std::cout << p.stepper << '\t'
+              << p.rel_err << '\t'
+              << p.max_error << '\t'
+              << p.rhs_evaluations << '\t'
+              << p.wall_time << '\n';
+
+  return 0;
+}
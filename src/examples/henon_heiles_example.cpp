@@ -0,0 +1,51 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// The Poincare section x = 0, p_x > 0 of Henon-Heiles orbits at the energy E: y and p_y of every crossing, one orbit
+// after the other, separated by blank lines.
+//
+// usage: henon_heiles_example [E] [number_of_orbits]
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "Hamiltonian.hpp"
+#include "line.hpp"
+#include "Integration.hpp"
+
+using namespace Integrators;
+using namespace Integrators::Geometry;
+
+int main (int argc, char* argv[])
+{
+  const double energy = argc > 1 ? std::stod(argv[1]) : 1.0 / 8;
+  const size_t number_of_orbits = argc > 2 ? std::stoul(argv[2]) : 10;
+
+  const auto hamiltonian = Hamiltonian::HenonHeilesHamiltonian{};
+
+  const Hyperplane<2> section{State4{0, 0, 0, 0}, State4{1, 0, 0, 0}};
+
+  IntegrationOptions options;
+  options.set_abs_err(1e-13);
+  options.set_rel_err(1e-12);
+
+  const TimeInterval t_interval{0, 5000};
+
+  for (size_t i = 0; i < number_of_orbits; ++i)
+    {
+      // seeds on the section along p_y = 0, with p_x fixed by the energy
+      const double y = -0.4 + 0.8 * static_cast<double>(i) / static_cast<double>(number_of_orbits);
+      const double px_squared = 2 * energy - y * y + 2 * y * y * y / 3;
+      if (px_squared <= 0)
+        continue;
+
+      const State4 s_start{0, y, std::sqrt(px_squared), 0};
+
+      for (const auto& c: calculate_crossings(hamiltonian, s_start, section, t_interval, options))
+        std::cout << c.q(1) << ' ' << c.p(1) << '\n';
+      std::cout << '\n';
+    }
+
+  return 0;
+}
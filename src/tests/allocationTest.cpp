@@ -0,0 +1,145 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+// Checks that the stepping and crossing loop of every Hamiltonian allocates nothing once the integration range and
+// the observer are set up and the observer has reserved room for the crossings. Global operator new is replaced by a
+// counting one; a test fails if any allocation takes place inside Observer::cross. The replacement applies to the
+// whole program, so this test must stay in its own executable.
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Hamiltonian.hpp"
+#include "line.hpp"
+#include "periodic_q_surface.hpp"
+#include "Integration.hpp"
+
+namespace
+{
+    size_t number_of_allocations = 0;
+}
+
+void* operator new (std::size_t size)
+{
+  ++number_of_allocations;
+  if (void* p = std::malloc(size > 0 ? size : 1))
+    return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete (void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete (void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+using namespace Integrators;
+
+namespace
+{
+    constexpr size_t reserved_crossings = 1000;
+
+    /// \brief checks that the crossing loop finds crossings without allocating
+    template<typename StepperPolicy, typename Ham, typename MakeObserver>
+    void check (const Ham& hamiltonian, typename Dynamics::DynamicSystem<Ham>::state_type s_start,
+                MakeObserver make_observer)
+    {
+      IntegrationOptions options;
+      options.set_abs_err(1e-12);
+      options.set_rel_err(1e-12);
+
+      const auto system = Dynamics::DynamicSystem<Ham>{hamiltonian};
+      typename Dynamics::DynamicSystem<Ham>::action_state_type s{s_start};
+
+      const auto integration_range = make_dynamic_system_integration_range<StepperPolicy>(system,
+                                                                                          s,
+                                                                                          TimeInterval{0, 200, 1},
+                                                                                          options);
+      auto observer = make_observer(system);
+      observer.reserve(reserved_crossings);
+
+      const auto allocations_before = number_of_allocations;
+      Observer::cross(observer, integration_range);
+      const auto allocations = number_of_allocations - allocations_before;
+
+      EXPECT_EQ(allocations, 0u);
+      EXPECT_GT(observer.observations().size(), 0u);
+    }
+
+    template<typename StepperPolicy = Steppers::Default, typename Ham>
+    void check_line (const Ham& hamiltonian, typename Dynamics::DynamicSystem<Ham>::state_type s_start,
+                     const Geometry::Hyperplane<Dynamics::DynamicSystem<Ham>::degrees_of_freedom>& line)
+    {
+      check<StepperPolicy>(hamiltonian, s_start, [&line] (const auto& system)
+      {
+          return make_project_on_line_observer<StepperPolicy>(system, line, [] (auto&)
+          { return true; });
+      });
+    }
+
+    const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+}
+
+TEST(allocation, harmonic_oscillator)
+{
+  check_line(Hamiltonian::HarmonicOscillator{}, {1, 0}, line);
+}
+
+TEST(allocation, duffing)
+{
+  check_line(Hamiltonian::DuffingHamiltonian{}, {1, 0.5}, line);
+}
+
+TEST(allocation, pendulum)
+{
+  check_line(Hamiltonian::PendulumHamiltonian{1, 1}, {1, 0}, line);
+}
+
+TEST(allocation, free_particle)
+{
+  check_line(Hamiltonian::FreeParticle{}, {-1, 1}, line);
+}
+
+TEST(allocation, spline_potential)
+{
+  std::vector<double> potential(41);
+  for (size_t i = 0; i < potential.size(); ++i)
+    {
+      const auto q = -4 + 0.2 * static_cast<double>(i);
+      potential[i] = q * q / 2;
+    }
+
+  check_line(Hamiltonian::SplinePotentialHamiltonian{-4, 4, potential}, {1, 0}, line);
+}
+
+TEST(allocation, henon_heiles)
+{
+  check_line(Hamiltonian::HenonHeilesHamiltonian{}, {0, 0.1, 0.39, 0.05},
+             Geometry::Hyperplane<2>{Geometry::State4{0, 0, 0, 0}, Geometry::State4{1, 0, 0, 0}});
+}
+
+TEST(allocation, other_steppers)
+{
+  check_line<Steppers::DormandPrince5>(Hamiltonian::PendulumHamiltonian{1, 1}, {1, 0}, line);
+  check_line<Steppers::Fehlberg78>(Hamiltonian::PendulumHamiltonian{1, 1}, {1, 0}, line);
+  // Steppers::BulirschStoer is left out, odeint's bulirsch_stoer allocates in every step
+  check_line<Steppers::Taylor>(Hamiltonian::DuffingHamiltonian{}, {1, 0.5}, line);
+}
+
+TEST(allocation, periodic_q_surface)
+{
+  check<Steppers::Default>(Hamiltonian::PendulumHamiltonian{1, 1}, {0, 2.5}, [] (const auto& system)
+  {
+      return make_project_on_periodic_Q_observer(system,
+                                                 Geometry::PeriodicQSurfaceCrossObserver{Geometry::State2{0, 2.5}},
+                                                 [] (auto&)
+                                                 { return true; });
+  });
+}
@@ -0,0 +1,190 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Hamiltonian.hpp"
+#include "details/batch_math.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    /// \brief the number of doubles between a and b
+    std::uint64_t ulp_distance (double a, double b)
+    {
+      const auto ordered = [] (double x)
+      {
+          std::int64_t i;
+          std::memcpy(&i, &x, sizeof x);
+          return i < 0 ? std::numeric_limits<std::int64_t>::min() - i : i;
+      };
+
+      const auto d = ordered(a) - ordered(b);
+      return static_cast<std::uint64_t>(d < 0 ? -d : d);
+    }
+
+    void expect_within_ulp (const std::vector<double>& x, std::uint64_t max_ulp)
+    {
+      std::vector<double> sin_x(x.size());
+      std::vector<double> cos_x(x.size());
+      Internals::sin_batch(x.data(), sin_x.data(), x.size());
+      Internals::cos_batch(x.data(), cos_x.data(), x.size());
+
+      for (size_t i = 0; i < x.size(); ++i)
+        {
+          EXPECT_LE(ulp_distance(sin_x[i], std::sin(x[i])), max_ulp) << "sin, x = " << x[i];
+          EXPECT_LE(ulp_distance(cos_x[i], std::cos(x[i])), max_ulp) << "cos, x = " << x[i];
+        }
+    }
+
+    std::vector<double> uniform (double half_width, size_t n, std::mt19937_64& generator)
+    {
+      std::uniform_real_distribution<double> distribution{-half_width, half_width};
+      std::vector<double> x(n);
+      for (auto& xi: x)
+        xi = distribution(generator);
+      return x;
+    }
+
+    /// \brief states where the terms of the polynomial Hamiltonians, which the batch kernels reassociate, stay of the
+    /// order of their sum
+    std::vector<Geometry::State2> random_states (size_t n)
+    {
+      std::mt19937_64 generator{7};
+      std::uniform_real_distribution<double> q{-4, 4};
+      std::uniform_real_distribution<double> p{-3, 3};
+
+      std::vector<Geometry::State2> states{};
+      for (size_t i = 0; i < n; ++i)
+        {
+          const auto qi = q(generator);
+          states.push_back(Geometry::State2{qi, p(generator)});
+        }
+      return states;
+    }
+
+    template<typename Ham>
+    void expect_batch_as_scalar (const char* name, const Ham& hamiltonian)
+    {
+      SCOPED_TRACE(name);
+      constexpr double eps = std::numeric_limits<double>::epsilon();
+
+      for (const auto n: {size_t{1}, Internals::batch_chunk_size - 1, Internals::batch_chunk_size + 1, size_t{1000}})
+        {
+          const auto states = random_states(n);
+
+          std::vector<double> values(n);
+          std::vector<Geometry::State2> derivatives(n);
+          hamiltonian.value_batch(states, values);
+          hamiltonian.derivative_batch(states, derivatives);
+
+          for (size_t i = 0; i < n; ++i)
+            {
+              const auto value = hamiltonian.value(states[i]);
+              const auto derivative = hamiltonian.derivative(states[i]);
+
+              EXPECT_NEAR(values[i], value, 16 * eps * std::max(1.0, std::abs(value))) << "s = " << states[i];
+              EXPECT_NEAR(derivatives[i].q(), derivative.q(), 16 * eps * std::max(1.0, std::abs(derivative.q())))
+                          << "s = " << states[i];
+              EXPECT_NEAR(derivatives[i].p(), derivative.p(), 16 * eps * std::max(1.0, std::abs(derivative.p())))
+                          << "s = " << states[i];
+            }
+        }
+    }
+}
+
+TEST(batch_math, within_two_ulp)
+{
+  std::mt19937_64 generator{1};
+
+  for (const auto half_width: {1.0, 10.0, 1e3, 1e5, 1e7, 9.9e7})
+    expect_within_ulp(uniform(half_width, 20000, generator), 2);
+}
+
+TEST(batch_math, near_multiples_of_half_pi)
+{
+  constexpr double half_pi = 1.57079632679489661923;
+
+  std::vector<double> x{};
+  for (const auto k: {1.0, 2.0, 3.0, 4.0, 7.0, 100.0, 355.0, 1e4, 103993.0, 1e6, 2.5e7, 6e7, 6.3e7})
+    {
+      auto near = k * half_pi;
+      for (int i = 0; i < 4; ++i)
+        near = std::nextafter(near, 0.0);
+      for (int i = 0; i < 9; ++i, near = std::nextafter(near, 1e300))
+        {
+          x.push_back(near);
+          x.push_back(-near);
+        }
+
+      // the rounding of k pi/2 to its nearest doubles leaves |r| well above any cancellation limit here
+      for (const auto relative: {1e-13, 1e-12, 1e-9})
+        {
+          x.push_back(k * half_pi * (1 + relative));
+          x.push_back(k * half_pi * (1 - relative));
+        }
+    }
+
+  expect_within_ulp(x, 2);
+}
+
+TEST(batch_math, large_and_non_finite_arguments)
+{
+  const std::vector<double> x{1e8, -1e8, 1.5e8, 1e10, -3e15, 1e22, 1e300, std::numeric_limits<double>::max(),
+                              std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<double>::quiet_NaN()};
+
+  std::vector<double> sin_x(x.size());
+  std::vector<double> cos_x(x.size());
+  Internals::sin_batch(x.data(), sin_x.data(), x.size());
+  Internals::cos_batch(x.data(), cos_x.data(), x.size());
+
+  for (size_t i = 0; i < x.size(); ++i)
+    {
+      if (std::isfinite(x[i]))
+        {
+          EXPECT_EQ(sin_x[i], std::sin(x[i])) << "x = " << x[i];
+          EXPECT_EQ(cos_x[i], std::cos(x[i])) << "x = " << x[i];
+        }
+      else
+        {
+          EXPECT_TRUE(std::isnan(sin_x[i])) << "x = " << x[i];
+          EXPECT_TRUE(std::isnan(cos_x[i])) << "x = " << x[i];
+        }
+    }
+}
+
+TEST(batch_math, partial_chunks)
+{
+  std::mt19937_64 generator{2};
+
+  for (const auto n: {size_t{0}, size_t{1}, Internals::batch_chunk_size - 1, Internals::batch_chunk_size,
+                       Internals::batch_chunk_size + 1, 3 * Internals::batch_chunk_size + 5})
+    expect_within_ulp(uniform(100, n, generator), 2);
+}
+
+TEST(batch_math, hamiltonians_batch_as_scalar)
+{
+  const auto pi = 3.14159265358979323846;
+
+  std::vector<double> potential(1024);
+  for (size_t i = 0; i < potential.size(); ++i)
+    potential[i] = -std::cos(-pi + 2 * pi * static_cast<double>(i) / static_cast<double>(potential.size()));
+
+  expect_batch_as_scalar("harmonic oscillator", Hamiltonian::HarmonicOscillator{});
+  expect_batch_as_scalar("duffing", Hamiltonian::DuffingHamiltonian{});
+  expect_batch_as_scalar("pendulum", Hamiltonian::PendulumHamiltonian{1, 1});
+  expect_batch_as_scalar("free particle", Hamiltonian::FreeParticle{});
+  expect_batch_as_scalar("periodic spline", Hamiltonian::SplinePotentialHamiltonian{
+      -pi, pi, potential, 1, Hamiltonian::SplinePotentialHamiltonian::SplineBoundary::periodic});
+  expect_batch_as_scalar("natural spline", Hamiltonian::SplinePotentialHamiltonian{-10, 10, potential, 2});
+}
@@ -0,0 +1,73 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <stdexcept>
+
+#include <boost/math/constants/constants.hpp>
+#include <gtest/gtest.h>
+
+#include "chaos_indicators.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    const Hamiltonian::PendulumHamiltonian pendulum{1, 1};
+    const TimeInterval integration_time{0, 1000};
+}
+
+TEST(ChaosIndicators, HarmonicOscillatorIsRegularWithZeroMegno)
+{
+  const auto indicators = calculate_chaos_indicators(Hamiltonian::HarmonicOscillator{},
+                                                     Geometry::State2{1, 0},
+                                                     integration_time,
+                                                     Testing::tight_options());
+
+  // an isochronous orbit: the tangent vector does not grow
+  EXPECT_EQ(indicators.type, OrbitType::regular);
+  EXPECT_NEAR(indicators.mean_megno, 0, 1e-6);
+  EXPECT_LT(indicators.time, integration_time.t_end());
+}
+
+TEST(ChaosIndicators, PendulumLibrationIsRegularWithMegnoNearTwo)
+{
+  const auto options = Testing::tight_options();
+  const Geometry::State2 libration{0, 1};
+
+  const auto indicators = calculate_chaos_indicators(pendulum, libration, integration_time, options);
+  EXPECT_EQ(indicators.type, OrbitType::regular);
+  EXPECT_NEAR(indicators.mean_megno, 2, 0.15);
+  EXPECT_LT(indicators.time, integration_time.t_end());
+
+  // the mean MEGNO keeps converging to 2 over the whole interval
+  ChaosIndicatorOptions chaos_options;
+  chaos_options.stop_when_classified = false;
+  const auto full = calculate_chaos_indicators(pendulum, libration, integration_time, options, chaos_options);
+  EXPECT_EQ(full.type, OrbitType::regular);
+  EXPECT_EQ(full.time, integration_time.t_end());
+  EXPECT_NEAR(full.mean_megno, 2, 0.05);
+}
+
+TEST(ChaosIndicators, OrbitNextToTheHyperbolicPointIsChaotic)
+{
+  // the orbit stays near the hyperbolic point for the whole minimum time, so its tangent vector grows exponentially
+  const Geometry::State2 s_start{boost::math::double_constants::pi - 1e-10, 0};
+
+  const ChaosIndicatorOptions chaos_options{};
+  const auto indicators = calculate_chaos_indicators(pendulum, s_start, integration_time, Testing::tight_options(),
+                                                     chaos_options);
+  EXPECT_EQ(indicators.type, OrbitType::chaotic);
+  EXPECT_GT(indicators.mean_megno, chaos_options.chaotic_megno);
+  EXPECT_LT(indicators.time, integration_time.t_end());
+}
+
+TEST(ChaosIndicators, ZeroTangentIsRejected)
+{
+  ChaosIndicatorOptions chaos_options;
+  chaos_options.initial_tangent = Geometry::State2{0, 0};
+  EXPECT_THROW(calculate_chaos_indicators(pendulum, Geometry::State2{0, 1}, integration_time,
+                                          Testing::tight_options(), chaos_options),
+               std::invalid_argument);
+}
@@ -0,0 +1,217 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "checkpoint.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    struct Interrupted {
+    };
+
+    /// \brief the cross observer of a line, that throws Interrupted once it has been shown limit states, to cut a run
+    /// short as a crash would
+    class InterruptedLineCrossObserver {
+      Geometry::LineCrossObserver line_;
+      std::shared_ptr<size_t> states_ = std::make_shared<size_t>(0);
+      size_t limit_;
+
+     public:
+      InterruptedLineCrossObserver (const Geometry::Line& line, size_t limit)
+          : line_{line},
+            limit_{limit}
+      { }
+
+      bool operator() (const Geometry::State2& s) const
+      {
+        if (++*states_ > limit_)
+          throw Interrupted{};
+        return line_(s);
+      }
+
+      double distance () const noexcept
+      {
+        return line_.distance();
+      }
+
+      void restore_distance (double distance) noexcept
+      {
+        line_.restore_distance(distance);
+      }
+    };
+
+    const Geometry::State2 s_start{1, 0.5};
+    const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+    const TimeInterval integration_time{0, 2000};
+
+    /// \brief a checkpoint file in the temporary directory, removed before and after the test
+    class CheckpointFile {
+      std::string path_;
+
+     public:
+      explicit CheckpointFile (const std::string& name)
+          : path_{(std::filesystem::temp_directory_path() / ("checkpointTest_" + name)).string()}
+      {
+        std::filesystem::remove(path_);
+      }
+
+      CheckpointFile (const CheckpointFile&) = delete;
+      CheckpointFile& operator= (const CheckpointFile&) = delete;
+
+      ~CheckpointFile ()
+      {
+        std::filesystem::remove(path_);
+      }
+
+      CheckpointOptions options (double interval = 50) const
+      {
+        return CheckpointOptions{path_, interval};
+      }
+
+      const std::string& path () const noexcept
+      {
+        return path_;
+      }
+    };
+
+    template<typename Ham>
+    std::vector<Geometry::State2_Extended> run (const Ham& hamiltonian, const CheckpointFile& file)
+    {
+      return calculate_crossings_with_checkpoints(hamiltonian, s_start, line, integration_time,
+                                                  Testing::tight_options(), file.options());
+    }
+
+    /// \brief run, interrupted after steps steps
+    void interrupted_run (const CheckpointFile& file, size_t steps)
+    {
+      Internals::calculate_crossings_with_checkpoints<Steppers::Default>(
+          Dynamics::DynamicSystem{Hamiltonian::DuffingHamiltonian{}},
+          s_start,
+          InterruptedLineCrossObserver{line, steps},
+          line.perpendicular_vector(),
+          integration_time,
+          Testing::tight_options(),
+          file.options());
+    }
+
+    void expect_bit_identical (const std::vector<Geometry::State2_Extended>& crossings,
+                               const std::vector<Geometry::State2_Extended>& expected)
+    {
+      ASSERT_EQ(crossings.size(), expected.size());
+      for (size_t i = 0; i < expected.size(); ++i)
+        for (unsigned j = 0; j < Geometry::State2_Extended::dimension; ++j)
+          EXPECT_EQ(crossings[i][j], expected[i][j]) << "crossing " << i << ", component " << j;
+    }
+}
+
+TEST(Checkpoint, UninterruptedRunMatchesCalculateCrossings)
+{
+  const CheckpointFile file{"uninterrupted"};
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+
+  expect_bit_identical(run(duffing, file),
+                       calculate_crossings(duffing, s_start, line, integration_time, Testing::tight_options()));
+}
+
+TEST(Checkpoint, ResumedRunIsBitIdentical)
+{
+  const CheckpointFile reference_file{"reference"};
+  const auto reference = run(Hamiltonian::DuffingHamiltonian{}, reference_file);
+  ASSERT_GT(reference.size(), 100u);
+
+  const CheckpointFile file{"resumed"};
+
+  // cut short twice, so that the last run resumes a checkpoint that was itself resumed
+  EXPECT_THROW(interrupted_run(file, 20000), Interrupted);
+  const auto first = Internals::load_checkpoint(file.path());
+  ASSERT_TRUE(first);
+  EXPECT_GT(first->crossing_values, 0u);
+
+  EXPECT_THROW(interrupted_run(file, 20000), Interrupted);
+  const auto second = Internals::load_checkpoint(file.path());
+  ASSERT_TRUE(second);
+  EXPECT_GT(second->sequence, first->sequence);
+  EXPECT_GT(second->crossing_values, first->crossing_values);
+  EXPECT_LT(second->crossing_values, reference.size() * Geometry::State2_Extended::dimension);
+
+  expect_bit_identical(run(Hamiltonian::DuffingHamiltonian{}, file), reference);
+
+  // a completed run returns the crossings of its checkpoint
+  expect_bit_identical(run(Hamiltonian::DuffingHamiltonian{}, file), reference);
+}
+
+TEST(Checkpoint, SaveCutShortKeepsThePreviousCheckpoint)
+{
+  const CheckpointFile reference_file{"torn_reference"};
+  const auto reference = run(Hamiltonian::DuffingHamiltonian{}, reference_file);
+
+  const CheckpointFile file{"torn"};
+  EXPECT_THROW(interrupted_run(file, 20000), Interrupted);
+  const auto last = Internals::load_checkpoint(file.path());
+  ASSERT_TRUE(last);
+  ASSERT_GT(last->sequence, 1u);
+
+  // garbles the header of the last save, as a save cut short while writing it would
+  {
+    std::fstream out{file.path(), std::ios::binary | std::ios::in | std::ios::out};
+    std::uint64_t slot_size = 0;
+    out.seekg(8);
+    out.read(reinterpret_cast<char*>(&slot_size), sizeof(slot_size));
+    out.seekp(static_cast<std::streamoff>(16 + (last->sequence % 2) * slot_size + 40));
+    out.put('\x7f');
+    ASSERT_TRUE(out);
+  }
+
+  const auto previous = Internals::load_checkpoint(file.path());
+  ASSERT_TRUE(previous);
+  EXPECT_EQ(previous->sequence, last->sequence - 1);
+  EXPECT_LE(previous->crossing_values, last->crossing_values);
+
+  expect_bit_identical(run(Hamiltonian::DuffingHamiltonian{}, file), reference);
+}
+
+TEST(Checkpoint, AnotherIntegrationIsRejected)
+{
+  const CheckpointFile file{"rejected"};
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+  run(duffing, file);
+
+  auto other_duffing = duffing;
+  other_duffing.set_parameter(0, duffing.parameters()[0] + 0.1);
+  EXPECT_THROW(run(other_duffing, file), std::runtime_error);
+
+  EXPECT_THROW(calculate_crossings_with_checkpoints<Steppers::DormandPrince5>(duffing,
+                                                                             s_start,
+                                                                             line,
+                                                                             integration_time,
+                                                                             Testing::tight_options(),
+                                                                             file.options()),
+               std::runtime_error);
+
+  EXPECT_THROW(calculate_crossings_with_checkpoints(duffing, s_start, line, TimeInterval{0, 2000, 0.5},
+                                                    Testing::tight_options(), file.options()),
+               std::runtime_error);
+
+  auto options = Testing::tight_options();
+  options.set_initial_time_step(1e-3);
+  EXPECT_THROW(calculate_crossings_with_checkpoints(duffing, s_start, line, integration_time, options,
+                                                    file.options()),
+               std::runtime_error);
+
+  options = Testing::tight_options();
+  options.set_energy_projection_every(10);
+  EXPECT_THROW(calculate_crossings_with_checkpoints(duffing, s_start, line, integration_time, options,
+                                                    file.options()),
+               std::runtime_error);
+}
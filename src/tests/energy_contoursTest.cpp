@@ -0,0 +1,103 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "energy_contours.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    /// \brief the action of the single closed contour of energy on grid
+    template<typename Ham>
+    double contour_action (const Ham& hamiltonian, const PhaseSpaceGrid& grid, double energy)
+    {
+      const auto contours = calculate_energy_contours(hamiltonian, grid, {energy}, 1);
+
+      EXPECT_EQ(contours.front().size(), 1u) << "energy " << energy;
+      if (contours.front().size() != 1)
+        return std::nan("");
+
+      const auto& contour = contours.front().front();
+      EXPECT_TRUE(contour.closed) << "energy " << energy;
+
+      // linear interpolation along the edges of the cells: second order in the spacing, the curvature of both
+      // Hamiltonians being at most 1
+      const auto spacing = std::max(grid.q(1) - grid.q(0), grid.p(1) - grid.p(0));
+      for (const auto& s: contour.points)
+        EXPECT_NEAR(hamiltonian.value(s), energy, spacing * spacing / 4) << "energy " << energy << ", s = " << s;
+
+      return contour.action();
+    }
+
+    PhaseSpaceGrid oscillator_grid (size_t n)
+    {
+      return PhaseSpaceGrid{-3, 3, n, -3, 3, n};
+    }
+
+    PhaseSpaceGrid pendulum_grid (size_t n)
+    {
+      return PhaseSpaceGrid{-pi, pi, n, -2.5, 2.5, n};
+    }
+}
+
+TEST(energy_contours, harmonic_oscillator_action_is_the_energy)
+{
+  const auto oscillator = Hamiltonian::HarmonicOscillator{};
+
+  for (const auto energy: {0.1, 0.5, 1.0, 2.0})
+    EXPECT_NEAR(contour_action(oscillator, oscillator_grid(401), energy), energy, 1e-4) << "energy " << energy;
+}
+
+TEST(energy_contours, pendulum_libration_actions_are_analytic)
+{
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+
+  for (const auto energy: {-0.9, -0.5, 0.0, 0.5, 0.9})
+    {
+      const auto analytic = pendulum.analytical_action(energy);
+      EXPECT_NEAR(contour_action(pendulum, pendulum_grid(401), energy), analytic, 5e-4 * analytic)
+                << "energy " << energy;
+    }
+}
+
+TEST(energy_contours, actions_converge_at_second_order)
+{
+  const auto oscillator = Hamiltonian::HarmonicOscillator{};
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+
+  // halving the spacing divides the error of the polyline by four
+  const auto oscillator_ratio = (contour_action(oscillator, oscillator_grid(201), 1) - 1)
+                                / (contour_action(oscillator, oscillator_grid(401), 1) - 1);
+
+  const auto analytic = pendulum.analytical_action(0.0);
+  const auto pendulum_ratio = (contour_action(pendulum, pendulum_grid(201), 0) - analytic)
+                              / (contour_action(pendulum, pendulum_grid(401), 0) - analytic);
+
+  EXPECT_GT(oscillator_ratio, 3);
+  EXPECT_LT(oscillator_ratio, 5);
+  EXPECT_GT(pendulum_ratio, 3);
+  EXPECT_LT(pendulum_ratio, 5);
+}
+
+TEST(energy_contours, rotations_leave_the_grid)
+{
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+
+  const auto contours = calculate_energy_contours(pendulum, pendulum_grid(201), {1.5}, 1).front();
+
+  ASSERT_EQ(contours.size(), 2u);
+  for (const auto& contour: contours)
+    {
+      EXPECT_FALSE(contour.closed);
+      EXPECT_TRUE(std::isnan(contour.action()));
+    }
+}
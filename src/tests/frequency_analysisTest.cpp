@@ -0,0 +1,99 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+#include <boost/math/special_functions/ellint_1.hpp>
+#include <gtest/gtest.h>
+
+#include "frequency_analysis.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    constexpr size_t number_of_samples = 4096;
+    constexpr double time_step = 0.05;
+
+    std::complex<double> term (std::complex<double> amplitude, double frequency, double t)
+    {
+      return amplitude * std::exp(std::complex<double>{0, frequency * t});
+    }
+}
+
+TEST(FFT, AgreesWithTheDiscreteFourierTransform)
+{
+  constexpr size_t size = 64;
+  constexpr auto two_pi = boost::math::double_constants::two_pi;
+
+  std::vector<std::complex<double>> data(size);
+  for (size_t n = 0; n < size; ++n)
+    data[n] = {std::cos(0.3 * static_cast<double>(n * n)), std::sin(1.7 * static_cast<double>(n)) - 0.25};
+
+  std::vector<std::complex<double>> transform(size);
+  for (size_t k = 0; k < size; ++k)
+    for (size_t n = 0; n < size; ++n)
+      transform[k] += data[n] * std::polar(1.0, -two_pi * static_cast<double>(n * k % size) / size);
+
+  const Internals::FFTPlan plan{size};
+  ASSERT_EQ(plan.size(), size);
+  plan.forward(data.data());
+
+  for (size_t k = 0; k < size; ++k)
+    EXPECT_LT(std::abs(data[k] - transform[k]), 1e-12) << "k " << k;
+}
+
+TEST(FFT, NextPowerOfTwo)
+{
+  EXPECT_EQ(Internals::next_power_of_two(1), 1u);
+  EXPECT_EQ(Internals::next_power_of_two(2), 2u);
+  EXPECT_EQ(Internals::next_power_of_two(3), 4u);
+  EXPECT_EQ(Internals::next_power_of_two(4096), 4096u);
+  EXPECT_EQ(Internals::next_power_of_two(4097), 8192u);
+}
+
+TEST(FrequencyAnalyzer, RecoversTwoFrequencies)
+{
+  const FrequencyComponent strong{0.7, std::polar(1.0, 0.3)};
+  const FrequencyComponent weak{-1.9, std::polar(0.3, -1.1)};
+
+  std::vector<std::complex<double>> signal(number_of_samples);
+  for (size_t n = 0; n < number_of_samples; ++n)
+    {
+      const auto t = time_step * static_cast<double>(n);
+      signal[n] = term(strong.amplitude, strong.frequency, t) + term(weak.amplitude, weak.frequency, t);
+    }
+
+  FrequencyAnalyzer analyzer{number_of_samples, time_step, 2};
+  const auto components = analyzer.analyze(Span<const std::complex<double>>{signal});
+
+  // strongest first
+  ASSERT_EQ(components.size(), 2u);
+  EXPECT_NEAR(components[0].frequency, strong.frequency, 1e-12);
+  EXPECT_LT(std::abs(components[0].amplitude - strong.amplitude), 1e-12);
+  EXPECT_NEAR(components[1].frequency, weak.frequency, 1e-12);
+  EXPECT_LT(std::abs(components[1].amplitude - weak.amplitude), 1e-12);
+}
+
+TEST(FrequencyAnalyzer, PendulumFrequencyIsTheAnalyticalOne)
+{
+  constexpr auto pi = boost::math::double_constants::pi;
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  const auto options = Testing::tight_options();
+
+  FrequencyAnalyzer analyzer{number_of_samples, time_step, 4};
+
+  for (const auto q_start: {0.5, 1.5, 2.5, 3.0})
+    {
+      const auto components = analyzer.analyze_orbit(pendulum, Geometry::State2{q_start, 0}, options);
+      const auto exact = pi / (2 * boost::math::ellint_1(std::sin(q_start / 2)));
+
+      ASSERT_FALSE(components.empty());
+      EXPECT_NEAR(components.front().frequency, exact, 1e-8) << "q_start " << q_start;
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Integration.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    const Hamiltonian::HenonHeilesHamiltonian henon_heiles{};
+
+    /// \brief the surface of section x = 0, crossed with p_x > 0
+    const Geometry::Hyperplane<2> section{Geometry::State4{0, 0, 0, 0}, Geometry::State4{1, 0, 0, 0}};
+
+    const TimeInterval integration_time{0, 1000};
+}
+
+TEST(HenonHeiles, CrossingsLieOnTheSectionAndConserveTheEnergy)
+{
+  const double tolerance = 1e-12;
+  const auto options = Testing::tight_options(tolerance);
+
+  // an orbit at E = 0.082, and one at E = 0.157, near the escape energy 1/6
+  for (const auto& s_start: {Geometry::State4{0, 0.1, 0.39, 0.05}, Geometry::State4{0, -0.1, 0.52, 0.18}})
+    {
+      const auto energy = henon_heiles.value(s_start);
+      const auto crossings = calculate_crossings(henon_heiles, s_start, section, integration_time, options);
+
+      ASSERT_GT(crossings.size(), 100u) << "energy " << energy;
+
+      double previous_time = integration_time.t_begin();
+      for (const auto& crossing: crossings)
+        {
+          EXPECT_NEAR(crossing.q(0), 0, 1e-12) << "energy " << energy << ", time " << crossing.t();
+          EXPECT_GT(crossing.p(0), 0) << "energy " << energy << ", time " << crossing.t();
+          EXPECT_GT(crossing.t(), previous_time) << "energy " << energy;
+          previous_time = crossing.t();
+
+          // the error of each step is within the tolerance, and they add up over the integration
+          EXPECT_NEAR(henon_heiles.value(Geometry::State4{crossing}), energy, 1e3 * tolerance)
+                      << "energy " << energy << ", time " << crossing.t();
+        }
+    }
+}
@@ -0,0 +1,92 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <gtest/gtest.h>
+
+#include "action_angle.hpp"
+#include "integration_session.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    void expect_same_action_angle (const ActionAngleOrbit& from_session, const ActionAngleOrbit& free)
+    {
+      EXPECT_EQ(from_session.action_two_pi(), free.action_two_pi());
+      EXPECT_EQ(from_session.omega(), free.omega());
+
+      ASSERT_EQ(from_session.positions().size(), free.positions().size());
+      for (size_t i = 0; i < free.positions().size(); ++i)
+        {
+          EXPECT_EQ(from_session.theta()[i], free.theta()[i]);
+          EXPECT_NEAR(from_session.positions()[i].q(), free.positions()[i].q(), 1e-9) << "i = " << i;
+          EXPECT_NEAR(from_session.positions()[i].p(), free.positions()[i].p(), 1e-9) << "i = " << i;
+        }
+    }
+}
+
+TEST(IntegrationSession, ActionAngleOnClosedOrbit)
+{
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+  const TimeInterval integration_time{0, 100};
+  const auto options = Testing::tight_options();
+
+  IntegrationSession<Hamiltonian::DuffingHamiltonian> session{duffing, integration_time, options};
+
+  for (const auto& s_start: {Geometry::State2{1, 0.5}, Geometry::State2{0.3, -0.2}})
+    {
+      session.reset(s_start);
+      expect_same_action_angle(session.calculate_action_angle_on_closed_orbit(50),
+                               calculate_action_angle_on_closed_orbit(duffing, s_start, integration_time, options, 50));
+    }
+}
+
+TEST(IntegrationSession, ActionAngleOnPeriodicOrbit)
+{
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  const TimeInterval integration_time{0, 100};
+  const auto options = Testing::tight_options();
+  const Geometry::State2 s_start{0, 2.5};
+
+  IntegrationSession<Hamiltonian::PendulumHamiltonian> session{pendulum, integration_time, options, s_start};
+
+  expect_same_action_angle(session.calculate_action_angle_on_periodic_orbit(50),
+                           calculate_action_angle_on_periodic_orbit(pendulum, s_start, integration_time, options, 50));
+}
+
+TEST(IntegrationSession, ActionAngleOnReversibleOrbit)
+{
+  const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+  const TimeInterval integration_time{0, 100};
+  const auto options = Testing::tight_options();
+  const auto symmetry = Geometry::ReversingSymmetry::momentum_reversal();
+
+  IntegrationSession<Hamiltonian::PendulumHamiltonian> session{pendulum, integration_time, options};
+
+  for (const auto& s_start: {Geometry::State2{1, 0}, Geometry::State2{0.5, 0.6}})
+    {
+      session.reset(s_start);
+      expect_same_action_angle(session.calculate_action_angle_on_reversible_orbit(symmetry, 51),
+                               calculate_action_angle_on_reversible_orbit(pendulum,
+                                                                          s_start,
+                                                                          symmetry,
+                                                                          integration_time,
+                                                                          options,
+                                                                          51));
+    }
+}
+
+TEST(IntegrationSession, ActionAngleWithExactFlow)
+{
+  const auto oscillator = Hamiltonian::HarmonicOscillator{};
+  const TimeInterval integration_time{0, 100};
+  const auto options = Testing::tight_options();
+  const Geometry::State2 s_start{1, 0.5};
+
+  IntegrationSession<Hamiltonian::HarmonicOscillator> session{oscillator, integration_time, options, s_start};
+
+  expect_same_action_angle(session.calculate_action_angle_on_closed_orbit(50),
+                           calculate_action_angle_on_closed_orbit(oscillator, s_start, integration_time, options, 50));
+}
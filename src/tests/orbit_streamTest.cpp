@@ -0,0 +1,193 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "orbit_stream.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    using Pair = std::pair<Geometry::State2_Action, double>;
+
+    Internals::Generator<int> count_to (int n)
+    {
+      for (int i = 0; i < n; ++i)
+        co_yield i;
+    }
+
+    Internals::Generator<int> throw_after (int n)
+    {
+      for (int i = 0; i < n; ++i)
+        co_yield i;
+      throw std::runtime_error("throw_after");
+    }
+
+    /// \brief sets destroyed when the coroutine frame holding it is destroyed
+    class DestructionFlag {
+      bool& destroyed_;
+
+     public:
+      explicit DestructionFlag (bool& destroyed) noexcept
+          : destroyed_{destroyed}
+      { }
+
+      DestructionFlag (const DestructionFlag&) = delete;
+      DestructionFlag& operator= (const DestructionFlag&) = delete;
+
+      ~DestructionFlag ()
+      {
+        destroyed_ = true;
+      }
+    };
+
+    /// \brief the pairs of stream, counting them in yielded
+    Internals::Generator<Pair> counted (Internals::Generator<Pair> stream, size_t& yielded, bool& destroyed)
+    {
+      const DestructionFlag flag{destroyed};
+      for (const auto& s_t: stream)
+        {
+          ++yielded;
+          co_yield s_t;
+        }
+    }
+
+    template<typename Range>
+    std::vector<Pair> collect (const Range& range)
+    {
+      std::vector<Pair> pairs{};
+      for (const auto& s_t: range)
+        pairs.emplace_back(s_t.first, s_t.second);
+      return pairs;
+    }
+
+    const Hamiltonian::DuffingHamiltonian duffing{};
+    const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+}
+
+TEST(Generator, IteratorEquality)
+{
+  using iterator = Internals::Generator<int>::iterator;
+  EXPECT_EQ(iterator{}, iterator{});
+
+  const auto empty = count_to(0);
+  EXPECT_EQ(empty.begin(), empty.end());
+
+  const auto numbers = count_to(3);
+  auto it = numbers.begin();
+  const auto copy = it;
+  EXPECT_NE(it, numbers.end());
+  EXPECT_EQ(it, copy);
+  EXPECT_EQ(*it, 0);
+
+  ++it;
+  EXPECT_EQ(*copy, 1);
+  ++it;
+  ++it;
+
+  // every iterator of the finished coroutine is equal to end()
+  EXPECT_EQ(it, numbers.end());
+  EXPECT_EQ(copy, numbers.end());
+  EXPECT_EQ(it, iterator{});
+}
+
+TEST(Generator, ExceptionPropagatesThroughTheIncrement)
+{
+  const auto numbers = throw_after(2);
+  auto it = numbers.begin();
+  EXPECT_EQ(*it, 0);
+  ASSERT_NO_THROW(++it);
+  EXPECT_EQ(*it, 1);
+  EXPECT_THROW(++it, std::runtime_error);
+  EXPECT_EQ(it, numbers.end());
+
+  // before the first value, out of begin()
+  const auto none = throw_after(0);
+  EXPECT_THROW(none.begin(), std::runtime_error);
+}
+
+TEST(Generator, CrossOnceStopsTheStream)
+{
+  const auto options = Testing::tight_options();
+  const TimeInterval integration_time{0, 1000};
+  const Geometry::State2 s_start{1, 0.5};
+  const auto system = Dynamics::DynamicSystem{duffing};
+
+  size_t all_pairs = 0;
+  bool destroyed = false;
+  for (const auto& s_t: counted(orbit_stream(system, Geometry::State2_Action{s_start}, integration_time, options),
+                                all_pairs, destroyed))
+    static_cast<void>(s_t);
+  ASSERT_TRUE(destroyed);
+
+  size_t pairs = 0;
+  destroyed = false;
+  auto observer = make_project_on_line_observer(system, line, [] (const auto&)
+  { return true; });
+  Observer::cross_once(observer,
+                       counted(orbit_stream(system, Geometry::State2_Action{s_start}, integration_time, options),
+                               pairs,
+                               destroyed));
+
+  // the stream was resumed only up to the first crossing, and its frame released
+  EXPECT_TRUE(destroyed);
+  EXPECT_LT(10 * pairs, all_pairs);
+  ASSERT_EQ(observer.observations().size(), 1u);
+
+  const auto first = calculate_first_crossing(duffing, s_start, line, integration_time, options);
+  EXPECT_EQ(observer.observations().front().t(), first.t());
+  EXPECT_EQ(observer.observations().front().q(), first.q());
+  EXPECT_EQ(observer.observations().front().p(), first.p());
+}
+
+TEST(OrbitStream, TakesTheStepsOfTheIntegrationRange)
+{
+  const auto options = Testing::tight_options();
+  const auto system = Dynamics::DynamicSystem{duffing};
+
+  for (const auto& integration_time: {TimeInterval{0, 100}, TimeInterval{0, 100, 0.1}, TimeInterval{100, 0}})
+    {
+      Geometry::State2_Action s_start{1, 0.5, 0};
+      const auto stream = collect(orbit_stream(system, s_start, integration_time, options));
+      const auto range = collect(make_dynamic_system_integration_range(system, s_start, integration_time, options));
+
+      ASSERT_EQ(stream.size(), range.size()) << "from " << integration_time.t_begin();
+      for (size_t i = 0; i < stream.size(); ++i)
+        {
+          EXPECT_EQ(stream[i].second, range[i].second) << "step " << i;
+          EXPECT_EQ(stream[i].first.q(), range[i].first.q()) << "step " << i;
+          EXPECT_EQ(stream[i].first.p(), range[i].first.p()) << "step " << i;
+          EXPECT_EQ(stream[i].first.J(), range[i].first.J()) << "step " << i;
+        }
+    }
+}
+
+TEST(OrbitStream, TaylorCrossingsFollowTheStepRecord)
+{
+  const auto options = Testing::tight_options();
+  const TimeInterval integration_time{0, 200};
+  const Geometry::State2 s_start{1, 0.5};
+  const auto system = Dynamics::DynamicSystem{duffing};
+
+  Steppers::step_record_t<Steppers::Taylor> step_record{};
+  auto observer = make_project_on_line_observer<Steppers::Taylor>(system, line, [] (const auto&)
+  { return true; }, &step_record);
+  Observer::cross(observer, orbit_stream<Steppers::Taylor>(system, Geometry::State2_Action{s_start}, integration_time,
+                                                           options, &step_record));
+
+  const auto crossings = calculate_crossings<Steppers::Taylor>(duffing, s_start, line, integration_time, options);
+  const auto& observations = observer.observations();
+  ASSERT_EQ(observations.size(), crossings.size());
+  for (size_t i = 0; i < crossings.size(); ++i)
+    {
+      EXPECT_EQ(observations[i].t(), crossings[i].t()) << "crossing " << i;
+      EXPECT_EQ(observations[i].p(), crossings[i].p()) << "crossing " << i;
+    }
+}
@@ -0,0 +1,82 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <array>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "parameter_sensitivity.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    const Geometry::State2 s_start{1, 0.3};
+    const TimeInterval integration_time{0, 1000};
+
+    /// \brief the action and omega of the closed orbit through s_start
+    std::array<double, 2> action_and_omega (const Hamiltonian::DuffingHamiltonian& duffing)
+    {
+      const auto orbit = come_back_home_closed_orbit(duffing, s_start, integration_time, Testing::tight_options());
+      return {orbit.J(), boost::math::double_constants::two_pi / orbit.t()};
+    }
+}
+
+TEST(ParameterSensitivity, AgreesWithCentralDifferences)
+{
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+  const auto sensitivities = calculate_closed_orbit_sensitivities(duffing, s_start, integration_time,
+                                                                  Testing::tight_options());
+
+  for (size_t k = 0; k < Hamiltonian::DuffingHamiltonian::number_of_parameters; ++k)
+    {
+      const auto mu = duffing.parameters()[k];
+      const auto h = 1e-4 * std::abs(mu);
+
+      auto shifted = duffing;
+      shifted.set_parameter(k, mu + h);
+      const auto plus = action_and_omega(shifted);
+      shifted.set_parameter(k, mu - h);
+      const auto minus = action_and_omega(shifted);
+
+      const auto d_action = (plus[0] - minus[0]) / (2 * h);
+      const auto d_omega = (plus[1] - minus[1]) / (2 * h);
+
+      EXPECT_NEAR(sensitivities.d_action[k], d_action, 1e-7 * std::max(std::abs(d_action), 1.0))
+                << "parameter " << k;
+      EXPECT_NEAR(sensitivities.d_omega[k], d_omega, 1e-7 * std::max(std::abs(d_omega), 1.0))
+                << "parameter " << k;
+    }
+}
+
+TEST(ParameterSensitivity, ScanStaysWithinTheTolerance)
+{
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+  const size_t e_gamma = 3;
+
+  std::vector<double> values(50);
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = duffing.parameters()[e_gamma] + 0.02 * static_cast<double>(i) / static_cast<double>(values.size());
+
+  ParameterScanOptions scan_options;
+  scan_options.tolerance = 1e-6;
+
+  const auto points = scan_parameter(duffing, e_gamma, values, s_start, integration_time, Testing::tight_options(),
+                                     scan_options);
+  ASSERT_EQ(points.size(), values.size());
+
+  size_t integrated = 0;
+  auto hamiltonian = duffing;
+  for (size_t i = 0; i < values.size(); ++i)
+    {
+      hamiltonian.set_parameter(e_gamma, values[i]);
+      const auto exact = action_and_omega(hamiltonian);
+      EXPECT_NEAR(points[i].action, exact[0], 2 * scan_options.tolerance) << "value " << i;
+      EXPECT_NEAR(points[i].omega, exact[1], 2 * scan_options.tolerance) << "value " << i;
+      integrated += points[i].integrated;
+    }
+  EXPECT_LT(integrated, values.size() / 2);
+}
@@ -0,0 +1,157 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pipelined_observer.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    const auto pendulum = Dynamics::DynamicSystem{Hamiltonian::PendulumHamiltonian{1, 1}};
+    const Geometry::State2 s_start{2, 0};
+    const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+    const TimeInterval integration_time{0, 500};
+
+    template<typename CrossObserver>
+    void integrate (CrossObserver& observer)
+    {
+      Geometry::State2_Action s{s_start};
+      Observer::cross(observer, make_dynamic_system_integration_range(pendulum, s, integration_time,
+                                                                      Testing::tight_options()));
+    }
+
+    /// \brief accepts every crossing, after holding up the observer's thread longer than the integration takes from one
+    /// crossing to the next, so that a short queue fills up
+    struct SlowPredicate {
+        bool operator() (const Geometry::State2_Extended&) const
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds{2});
+          return true;
+        }
+    };
+
+    struct Thrown : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+}
+
+TEST(SpscQueue, CapacityIsRoundedUpToAPowerOfTwo)
+{
+  EXPECT_EQ(Internals::SpscQueue<int>{1}.capacity(), 1u);
+  EXPECT_EQ(Internals::SpscQueue<int>{2}.capacity(), 2u);
+  EXPECT_EQ(Internals::SpscQueue<int>{3}.capacity(), 4u);
+  EXPECT_THROW(Internals::SpscQueue<int>{0}, std::invalid_argument);
+}
+
+TEST(SpscQueue, FullAndEmptyStatesWrapAround)
+{
+  for (const size_t capacity: {1u, 2u})
+    {
+      Internals::SpscQueue<int> queue{capacity};
+      int next_pushed = 0;
+      int next_popped = 0;
+      int value = -1;
+
+      // many times round the buffer, filling it up and emptying it each time
+      for (int round = 0; round < 10; ++round)
+        {
+          EXPECT_TRUE(queue.empty());
+          EXPECT_FALSE(queue.try_pop(value));
+
+          for (size_t i = 0; i < capacity; ++i)
+            EXPECT_TRUE(queue.try_push(next_pushed++));
+          EXPECT_FALSE(queue.empty());
+          EXPECT_FALSE(queue.try_push(-1)) << "capacity " << capacity << ", round " << round;
+
+          for (size_t i = 0; i < capacity; ++i)
+            {
+              ASSERT_TRUE(queue.try_pop(value));
+              EXPECT_EQ(value, next_popped++);
+            }
+        }
+
+      // and one at a time, the indices running past the capacity
+      for (int i = 0; i < 7; ++i)
+        {
+          EXPECT_TRUE(queue.try_push(next_pushed++));
+          ASSERT_TRUE(queue.try_pop(value));
+          EXPECT_EQ(value, next_popped++);
+          EXPECT_TRUE(queue.empty());
+        }
+    }
+}
+
+TEST(SpscQueue, TwoThreadsSeeTheElementsInOrder)
+{
+  constexpr int count = 100000;
+  Internals::SpscQueue<int> queue{2};
+
+  std::thread producer{[&queue] ()
+                       {
+                           for (int i = 0; i < count; ++i)
+                             while (!queue.try_push(i))
+                               std::this_thread::yield();
+                       }};
+
+  int value = -1;
+  int out_of_order = 0;
+  for (int expected = 0; expected < count; ++expected)
+    {
+      while (!queue.try_pop(value))
+        std::this_thread::yield();
+      out_of_order += value != expected;
+    }
+  producer.join();
+
+  EXPECT_EQ(out_of_order, 0);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(PipelinedObserver, MatchesTheInlineObserverWithAFullQueue)
+{
+  auto inline_observer = make_project_on_line_observer(pendulum, line, [] (const auto&)
+  { return true; });
+  integrate(inline_observer);
+  const auto expected = inline_observer.observations();
+  ASSERT_GT(expected.size(), 50u);
+
+  // the producer finds the queue of one crossing full while the predicate sleeps
+  auto pipelined = make_pipelined_project_on_line_observer(pendulum, line, SlowPredicate{},
+                                                           Observer::PushBackObserver{}, 1);
+  integrate(pipelined);
+  pipelined.finish();
+  const auto crossings = pipelined.observations();
+
+  ASSERT_EQ(crossings.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    for (unsigned j = 0; j < Geometry::State2_Extended::dimension; ++j)
+      EXPECT_EQ(crossings[i][j], expected[i][j]) << "crossing " << i << ", component " << j;
+}
+
+TEST(PipelinedObserver, PredicateExceptionReachesFinish)
+{
+  size_t seen = 0;
+  auto pipelined = make_pipelined_project_on_line_observer(pendulum, line, [&seen] (const auto&)
+  {
+      if (++seen == 3)
+        throw Thrown{"third crossing"};
+      return true;
+  }, Observer::PushBackObserver{}, 2);
+
+  // the integration runs to its end: the crossings after the exception are dropped, not left to block the producer
+  integrate(pipelined);
+  EXPECT_THROW(pipelined.finish(), Thrown);
+
+  EXPECT_EQ(pipelined.observations().size(), 2u);
+  EXPECT_EQ(seen, 3u);
+  EXPECT_THROW(pipelined(Geometry::State2_Action{s_start}, 0.0), std::logic_error);
+}
@@ -0,0 +1,74 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "predictive_crossings.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    const Hamiltonian::PendulumHamiltonian pendulum{1, 1};
+    const Geometry::State2 s_start{2, 0};
+    const Geometry::Line line{Geometry::State2{0, 0}, Geometry::State2{1, 0}};
+    const TimeInterval integration_time{0, 200};
+}
+
+TEST(PredictiveCrossings, PredictsAfterEachNumberOfVerificationPeriods)
+{
+  const auto options = Testing::tight_options();
+  const auto integrated = calculate_crossings(pendulum, s_start, line, integration_time, options);
+
+  // the first crossing that comes back to the first one closes the first period
+  size_t crossings_per_period = 1;
+  while (magnitude(Geometry::State2{integrated[crossings_per_period]} - Geometry::State2{integrated.front()})
+         > options.distance_threshold)
+    ++crossings_per_period;
+
+  for (size_t verification_periods = 0; verification_periods < 3; ++verification_periods)
+    {
+      const auto predicted = calculate_crossings_predictive(pendulum, s_start, line, integration_time, options,
+                                                            verification_periods);
+
+      ASSERT_TRUE(predicted.period) << verification_periods << " verification periods";
+      EXPECT_EQ(predicted.integrated_crossings, (verification_periods + 1) * crossings_per_period);
+      ASSERT_EQ(predicted.crossings.size(), integrated.size());
+
+      // the integrated crossings are those of calculate_crossings; the predicted ones drift by the error of the period
+      // per period, as the integrated ones do by the integration error
+      for (size_t i = 0; i < integrated.size(); ++i)
+        {
+          const auto& a = integrated[i];
+          const auto& b = predicted.crossings[i];
+          if (i < predicted.integrated_crossings)
+            {
+              EXPECT_EQ(b.t(), a.t()) << "crossing " << i;
+              EXPECT_EQ(b.J(), a.J()) << "crossing " << i;
+            }
+          else
+            {
+              EXPECT_NEAR(b.t(), a.t(), 1e-6) << "crossing " << i;
+              EXPECT_NEAR(b.J(), a.J(), 1e-6) << "crossing " << i;
+            }
+        }
+    }
+}
+
+TEST(PredictiveCrossings, OrbitThatNeverComesBackIsIntegrated)
+{
+  const auto options = Testing::tight_options();
+  const Geometry::State2 rotation{0, 2.5};
+  const Geometry::Line q_axis{Geometry::State2{0, 0}, Geometry::State2{0, 1}};
+
+  const auto integrated = calculate_crossings(pendulum, rotation, q_axis, integration_time, options);
+  const auto predicted = calculate_crossings_predictive(pendulum, rotation, q_axis, integration_time, options, 0);
+
+  EXPECT_FALSE(predicted.period);
+  EXPECT_EQ(predicted.integrated_crossings, integrated.size());
+  EXPECT_EQ(predicted.crossings.size(), integrated.size());
+}
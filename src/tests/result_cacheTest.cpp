@@ -0,0 +1,127 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "result_cache.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    /// \brief a cache directory in the temporary directory, removed before and after the test
+    class CacheDirectory {
+      std::filesystem::path path_;
+
+     public:
+      explicit CacheDirectory (const std::string& name)
+          : path_{std::filesystem::temp_directory_path() / ("result_cacheTest_" + name)}
+      {
+        std::filesystem::remove_all(path_);
+      }
+
+      CacheDirectory (const CacheDirectory&) = delete;
+      CacheDirectory& operator= (const CacheDirectory&) = delete;
+
+      ~CacheDirectory ()
+      {
+        std::filesystem::remove_all(path_);
+      }
+
+      const std::filesystem::path& path () const noexcept
+      {
+        return path_;
+      }
+    };
+
+    Internals::CacheKey duffing_key ()
+    {
+      return Internals::make_cache_key<Steppers::Default>("test",
+                                                          Hamiltonian::DuffingHamiltonian{},
+                                                          Geometry::State2{1, 0.5},
+                                                          TimeInterval{0, 100},
+                                                          IntegrationOptions{},
+                                                          4);
+    }
+
+    const ActionAngleOrbit orbit{1.5, 2.5, {0, 1, 2, 3}, {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}};
+
+    std::filesystem::path only_file (const std::filesystem::path& directory)
+    {
+      std::filesystem::directory_iterator it{directory};
+      return it->path();
+    }
+}
+
+TEST(ResultCache, KeyStartsWithTheVersionAndNamesTheTypes)
+{
+  const auto key = duffing_key();
+  const auto& bytes = key.bytes();
+
+  std::uint64_t version = 0;
+  ASSERT_GE(bytes.size(), sizeof(version));
+  std::memcpy(&version, bytes.data(), sizeof(version));
+  EXPECT_EQ(version, Internals::result_cache_version);
+
+  const std::string text{bytes.begin(), bytes.end()};
+  EXPECT_NE(text.find(Hamiltonian::DuffingHamiltonian::name), std::string::npos);
+  EXPECT_NE(text.find(Steppers::Default::name), std::string::npos);
+}
+
+TEST(ResultCache, StoredOrbitIsLoaded)
+{
+  const CacheDirectory directory{"stored"};
+  ResultCache cache{directory.path()};
+  cache.store(duffing_key(), orbit);
+
+  const auto loaded = cache.load(duffing_key());
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(loaded->action_two_pi(), orbit.action_two_pi());
+  EXPECT_EQ(loaded->omega(), orbit.omega());
+  EXPECT_EQ(loaded->theta(), orbit.theta());
+  ASSERT_EQ(loaded->positions().size(), orbit.positions().size());
+}
+
+TEST(ResultCache, CorruptLengthIsAMiss)
+{
+  const CacheDirectory directory{"corrupt"};
+  ResultCache cache{directory.path()};
+  const auto key = duffing_key();
+  cache.store(key, orbit);
+
+  // the number of angles follows the magic, the key and the action and omega
+  {
+    std::fstream entry{only_file(directory.path()), std::ios::binary | std::ios::in | std::ios::out};
+    entry.seekp(static_cast<std::streamoff>(8 + 8 + key.bytes().size() + 16));
+    const std::uint64_t huge = std::uint64_t{1} << 39u;
+    entry.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    ASSERT_TRUE(entry);
+  }
+
+  EXPECT_FALSE(cache.load(key));
+}
+
+TEST(ResultCache, EvictionRemovesStaleTemporaryFiles)
+{
+  const CacheDirectory directory{"temporary"};
+  ResultCache cache{directory.path()};
+
+  const auto stale = directory.path() / "0000000000000001.entry.1.tmp";
+  const auto fresh = directory.path() / "0000000000000002.entry.2.tmp";
+  std::ofstream{stale} << "crashed";
+  std::ofstream{fresh} << "being written";
+  std::filesystem::last_write_time(stale, std::filesystem::file_time_type::clock::now()
+                                          - ResultCache::stale_temporary_age - std::chrono::minutes{1});
+
+  cache.evict();
+
+  EXPECT_FALSE(std::filesystem::exists(stale));
+  EXPECT_TRUE(std::filesystem::exists(fresh));
+}
@@ -0,0 +1,55 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <gtest/gtest.h>
+
+#include "Integration.hpp"
+#include "integration_session.hpp"
+#include "reversing_symmetry.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    void expect_same_orbit (const Geometry::State2& s_start)
+    {
+      const auto pendulum = Hamiltonian::PendulumHamiltonian{1, 1};
+      const TimeInterval integration_time{0, 100};
+      const auto options = Testing::tight_options();
+
+      const auto reversible = come_back_home_reversible_orbit(pendulum,
+                                                              s_start,
+                                                              Geometry::ReversingSymmetry::momentum_reversal(),
+                                                              integration_time,
+                                                              options);
+      const auto closed = come_back_home_closed_orbit(pendulum, s_start, integration_time, options);
+
+      EXPECT_NEAR(reversible.t(), closed.t(), 1e-8) << "s_start = " << s_start;
+      EXPECT_NEAR(reversible.J(), closed.J(), 1e-8) << "s_start = " << s_start;
+
+      IntegrationSession<Hamiltonian::PendulumHamiltonian> session{pendulum, integration_time, options, s_start};
+      const auto from_session = session.come_back_home_reversible_orbit(Geometry::ReversingSymmetry::momentum_reversal());
+
+      EXPECT_EQ(from_session.t(), reversible.t()) << "s_start = " << s_start;
+      EXPECT_EQ(from_session.J(), reversible.J()) << "s_start = " << s_start;
+    }
+}
+
+TEST(ReversibleOrbit, StartOnTheFixedLine)
+{
+  expect_same_orbit(Geometry::State2{1, 0});
+}
+
+TEST(ReversibleOrbit, StartJustOffTheFixedLineOnEitherSide)
+{
+  for (const auto p: {1e-14, -1e-14, 5e-9, -5e-9})
+    expect_same_orbit(Geometry::State2{1, p});
+}
+
+TEST(ReversibleOrbit, StartAwayFromTheFixedLine)
+{
+  expect_same_orbit(Geometry::State2{0.5, 0.6});
+  expect_same_orbit(Geometry::State2{0.5, -0.6});
+}
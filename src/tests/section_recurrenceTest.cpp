@@ -0,0 +1,164 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <cmath>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+#include <gtest/gtest.h>
+
+#include "section_recurrence.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    /// \brief the nearest of points within radius of s, by a linear scan; the later of two at the same distance, as
+    /// CrossingIndex::nearest
+    template<typename Point>
+    std::optional<size_t> scan_nearest (const std::vector<Point>& points, const Point& s, double radius)
+    {
+      std::optional<size_t> nearest{};
+      double nearest_distance = radius;
+      for (size_t i = 0; i < points.size(); ++i)
+        {
+          const auto distance = magnitude(points[i] - s);
+          if (distance <= nearest_distance)
+            {
+              nearest = i;
+              nearest_distance = distance;
+            }
+        }
+      return nearest;
+    }
+
+    /// \brief inserts points into an index, and checks the nearest neighbour of every point against a linear scan
+    /// before it is inserted, and of every query afterwards
+    template<unsigned DOF>
+    void check_against_scan (double radius,
+                             const std::vector<Geometry::PhaseSpaceState<DOF>>& points,
+                             const std::vector<Geometry::PhaseSpaceState<DOF>>& queries)
+    {
+      CrossingIndex<DOF> index{radius};
+      std::vector<Geometry::PhaseSpaceState<DOF>> inserted{};
+
+      for (const auto& s: points)
+        {
+          EXPECT_EQ(index.nearest(s), scan_nearest(inserted, s, radius)) << "point " << inserted.size();
+          EXPECT_EQ(index.insert(s), inserted.size());
+          inserted.push_back(s);
+        }
+
+      for (size_t i = 0; i < queries.size(); ++i)
+        EXPECT_EQ(index.nearest(queries[i]), scan_nearest(inserted, queries[i], radius)) << "query " << i;
+    }
+
+    /// \brief a potential with wells at q = 0 and q = +-2, whose orbits above the barriers cross p = 1.25 upwards once
+    /// over every well, i.e. three times per period
+    Hamiltonian::SplinePotentialHamiltonian three_wells ()
+    {
+      std::vector<double> potential{};
+      for (int i = 0; i <= 400; ++i)
+        {
+          const auto q = -4 + 0.02 * i;
+          potential.push_back(0.02 * q * q * q * q - 0.5 * std::cos(boost::math::double_constants::pi * q));
+        }
+      return Hamiltonian::SplinePotentialHamiltonian{-4, 4, potential};
+    }
+}
+
+TEST(CrossingIndex, NearestAgreesWithALinearScan)
+{
+  // a radius of a power of 2, so that the points on the cell boundaries below are exactly on them
+  constexpr double radius = 0.125;
+
+  std::mt19937_64 generator{42};
+  std::uniform_real_distribution<double> coordinate{-1, 1};
+
+  std::vector<Geometry::State2> points{};
+  for (int i = 0; i < 400; ++i)
+    points.push_back({coordinate(generator), coordinate(generator)});
+
+  std::vector<Geometry::State2> queries{};
+  for (int i = 0; i < 400; ++i)
+    queries.push_back({coordinate(generator), coordinate(generator)});
+
+  // points and queries on the cell boundaries, with neighbours exactly radius away across them
+  for (int i = -8; i <= 8; ++i)
+    {
+      const auto boundary = i * radius;
+      points.push_back({boundary, 0.3});
+      queries.push_back({boundary + radius, 0.3});
+      queries.push_back({boundary - radius, 0.3});
+      queries.push_back({0.3, boundary});
+      queries.push_back({boundary, boundary});
+    }
+
+  check_against_scan<1>(radius, points, queries);
+}
+
+TEST(CrossingIndex, NearestAgreesWithALinearScanInFourDimensions)
+{
+  constexpr double radius = 0.25;
+
+  std::mt19937_64 generator{7};
+  std::uniform_real_distribution<double> coordinate{-1, 1};
+  const auto random_point = [&] ()
+  {
+      return Geometry::State4{coordinate(generator), coordinate(generator), coordinate(generator),
+                              coordinate(generator)};
+  };
+
+  std::vector<Geometry::State4> points{};
+  std::vector<Geometry::State4> queries{};
+  for (int i = 0; i < 2000; ++i)
+    {
+      points.push_back(random_point());
+      queries.push_back(random_point());
+    }
+  points.push_back({radius, -radius, 0, 2 * radius});
+  queries.push_back({radius, -radius, radius, 2 * radius});
+
+  check_against_scan<2>(radius, points, queries);
+}
+
+TEST(SectionRecurrences, PeriodKOrbitRecursAfterKTurns)
+{
+  const auto options = Testing::tight_options();
+  const TimeInterval integration_time{0, 200};
+  RecurrenceOptions recurrence_options;
+  recurrence_options.radius = 1e-8;
+
+  // above the barriers, with p = sqrt(3) over the middle well
+  const auto hamiltonian = three_wells();
+  const Geometry::State2 s_start{0, std::sqrt(3.0)};
+
+  // a line crossed once per period, above the lower wells
+  const auto once = calculate_section_recurrences(hamiltonian, s_start,
+                                                  Geometry::Line{Geometry::State2{0, 1.65}, Geometry::State2{0, 1}},
+                                                  integration_time, options, recurrence_options);
+  ASSERT_TRUE(once.first_recurrence);
+  EXPECT_EQ(once.first_recurrence->turns, 1u);
+
+  const auto thrice = calculate_section_recurrences(hamiltonian, s_start,
+                                                    Geometry::Line{Geometry::State2{0, 1.25}, Geometry::State2{0, 1}},
+                                                    integration_time, options, recurrence_options);
+  ASSERT_TRUE(thrice.first_recurrence);
+  EXPECT_EQ(thrice.first_recurrence->turns, 3u);
+  EXPECT_EQ(thrice.first_recurrence->earlier, 0u);
+  EXPECT_EQ(thrice.first_recurrence->index, 3u);
+  EXPECT_EQ(thrice.crossings.size(), 4u);
+  // the same period, to the accuracy of the crossings
+  EXPECT_NEAR(thrice.first_recurrence->time, once.first_recurrence->time, 1e-7);
+
+  // the pendulum librations close after every turn
+  const auto libration = calculate_section_recurrences(Hamiltonian::PendulumHamiltonian{1, 1}, Geometry::State2{2, 0},
+                                                       Geometry::Line{Geometry::State2{0, 0}, Geometry::State2{1, 0}},
+                                                       integration_time, options, recurrence_options);
+  ASSERT_TRUE(libration.first_recurrence);
+  EXPECT_EQ(libration.first_recurrence->turns, 1u);
+}
@@ -0,0 +1,156 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Hamiltonian.hpp"
+
+using namespace Integrators;
+using Spline = Hamiltonian::SplinePotentialHamiltonian;
+
+namespace
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    /// \brief the periodic spline through -cos(q) + 0.3 sin(2q), sampled on n points of [-pi, pi)
+    Spline periodic_spline (size_t n)
+    {
+      std::vector<double> potential(n);
+      for (size_t i = 0; i < n; ++i)
+        {
+          const auto q = -pi + 2 * pi * static_cast<double>(i) / static_cast<double>(n);
+          potential[i] = -std::cos(q) + 0.3 * std::sin(2 * q);
+        }
+      return Spline{-pi, pi, potential, 1, Spline::SplineBoundary::periodic};
+    }
+
+    double exact_potential (double q)
+    {
+      return -std::cos(q) + 0.3 * std::sin(2 * q);
+    }
+
+    double exact_derivative (double q)
+    {
+      return std::sin(q) + 0.6 * std::cos(2 * q);
+    }
+
+    /// \brief the largest errors of the potential and of its derivative over [-pi, pi]
+    std::pair<double, double> max_errors (const Spline& spline)
+    {
+      double potential_error = 0;
+      double derivative_error = 0;
+      for (int i = 0; i <= 10000; ++i)
+        {
+          const auto q = -pi + 2 * pi * i / 10000.0;
+          potential_error = std::max(potential_error, std::abs(spline.potential(q) - exact_potential(q)));
+          derivative_error = std::max(derivative_error, std::abs(spline.potential_derivative(q) - exact_derivative(q)));
+        }
+      return {potential_error, derivative_error};
+    }
+
+    /// \brief the jumps of the potential and of its first two derivatives across q
+    std::array<double, 3> jumps (const Spline& spline, double q)
+    {
+      const auto below = std::nextafter(q, -1e300);
+      const auto above = std::nextafter(q, 1e300);
+      return {std::abs(spline.potential(above) - spline.potential(below)),
+              std::abs(spline.potential_derivative(above) - spline.potential_derivative(below)),
+              std::abs(spline.potential_second_derivative(above) - spline.potential_second_derivative(below))};
+    }
+}
+
+TEST(spline_potential, interpolates_the_samples)
+{
+  const std::vector<double> potential{0.5, -1, 2, 0.25, 3};
+
+  const Spline natural{-1, 3, potential};
+  for (size_t i = 0; i < potential.size(); ++i)
+    EXPECT_NEAR(natural.potential(-1 + static_cast<double>(i)), potential[i], 1e-14) << "sample " << i;
+
+  const Spline periodic{0, 2 * pi, potential, 1, Spline::SplineBoundary::periodic};
+  for (size_t i = 0; i < potential.size(); ++i)
+    EXPECT_NEAR(periodic.potential(2 * pi * static_cast<double>(i) / 5), potential[i], 1e-14) << "sample " << i;
+}
+
+TEST(spline_potential, periodic_accuracy)
+{
+  // the periodic cubic spline of a smooth function is fourth order, its derivative third order
+  const auto [potential_64, derivative_64] = max_errors(periodic_spline(64));
+  const auto [potential_128, derivative_128] = max_errors(periodic_spline(128));
+
+  EXPECT_LT(potential_64, 1e-5);
+  EXPECT_LT(derivative_64, 1e-3);
+  EXPECT_GT(potential_64 / potential_128, 12);
+  EXPECT_GT(derivative_64 / derivative_128, 6);
+}
+
+TEST(spline_potential, natural_accuracy_and_continuation)
+{
+  // V = q^3 - q on [-2, 2]: the natural spline is exact up to its end conditions, which only affect the cells
+  // next to the ends
+  const size_t n = 81;
+  std::vector<double> potential(n);
+  for (size_t i = 0; i < n; ++i)
+    {
+      const auto q = -2 + 4 * static_cast<double>(i) / static_cast<double>(n - 1);
+      potential[i] = q * q * q - q;
+    }
+  const Spline spline{-2, 2, potential};
+
+  for (int i = 0; i <= 1000; ++i)
+    {
+      const auto q = -1 + 2 * i / 1000.0;
+      EXPECT_NEAR(spline.potential(q), q * q * q - q, 1e-6) << "q = " << q;
+      EXPECT_NEAR(spline.potential_derivative(q), 3 * q * q - 1, 1e-4) << "q = " << q;
+    }
+
+  // continued linearly, with a continuous value and slope
+  for (const auto end: {-2.0, 2.0})
+    {
+      const auto jump = jumps(spline, end);
+      EXPECT_LT(jump[0], 1e-12) << "end " << end;
+      EXPECT_LT(jump[1], 1e-9) << "end " << end;
+
+      const auto outside = end + (end < 0 ? -1 : 1);
+      EXPECT_EQ(spline.potential_second_derivative(outside), 0) << "end " << end;
+      EXPECT_NEAR(spline.potential(outside), spline.potential(end) + (end < 0 ? -1 : 1) * spline.potential_derivative(end),
+                  1e-9) << "end " << end;
+    }
+}
+
+TEST(spline_potential, periodic_wrap_is_continuous)
+{
+  const auto spline = periodic_spline(64);
+
+  // across the seam, at q_min and q_max, and across interior knots, the spline is twice continuously differentiable
+  for (const auto q: {-pi, pi, -pi + 2 * pi / 64, 3 * pi, -5 * pi})
+    {
+      const auto jump = jumps(spline, q);
+      EXPECT_LT(jump[0], 1e-12) << "q = " << q;
+      EXPECT_LT(jump[1], 1e-9) << "q = " << q;
+      EXPECT_LT(jump[2], 1e-6) << "q = " << q;
+    }
+
+  for (int i = 0; i <= 100; ++i)
+    {
+      const auto q = -pi + 2 * pi * i / 100.0;
+      for (const auto turns: {-3.0, -1.0, 1.0, 2.0, 1000.0})
+        {
+          const auto shifted = q + turns * 2 * pi;
+          const auto tolerance = 1e-13 * std::max(1.0, std::abs(shifted));
+          EXPECT_NEAR(spline.potential(shifted), spline.potential(q), 10 * tolerance) << "q = " << shifted;
+          EXPECT_NEAR(spline.potential_derivative(shifted), spline.potential_derivative(q), 100 * tolerance)
+                    << "q = " << shifted;
+        }
+    }
+
+  EXPECT_TRUE(std::isfinite(spline.potential(1e12)));
+  EXPECT_TRUE(std::isnan(spline.potential(std::nan(""))));
+}
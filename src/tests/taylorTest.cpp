@@ -0,0 +1,180 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <array>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "Integration.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    using DuffingSystem = Dynamics::DynamicSystem<Hamiltonian::DuffingHamiltonian>;
+}
+
+TEST(taylor, crossings_agree_with_cash_karp)
+{
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+  const auto line = Geometry::Line{Geometry::State2{0, 0}, Geometry::State2{0, 1}};
+  const TimeInterval integration_time{0, 200};
+  const auto options = Testing::tight_options(1e-13);
+
+  for (const auto& s_start: {Geometry::State2{1, 0.5}, Geometry::State2{0.2, 0.1}, Geometry::State2{-2, 1}})
+    {
+      const auto taylor = calculate_crossings<Steppers::Taylor>(duffing, s_start, line, integration_time, options);
+      const auto cash_karp = calculate_crossings<Steppers::CashKarp54>(duffing,
+                                                                       s_start,
+                                                                       line,
+                                                                       integration_time,
+                                                                       options);
+
+      ASSERT_EQ(taylor.size(), cash_karp.size()) << "s_start = " << s_start;
+      ASSERT_FALSE(taylor.empty()) << "s_start = " << s_start;
+
+      for (size_t i = 0; i < taylor.size(); ++i)
+        {
+          EXPECT_NEAR(taylor[i].t(), cash_karp[i].t(), 1e-8) << "s_start = " << s_start << ", crossing " << i;
+          EXPECT_NEAR(taylor[i].q(), cash_karp[i].q(), 1e-8) << "s_start = " << s_start << ", crossing " << i;
+          EXPECT_NEAR(taylor[i].J(), cash_karp[i].J(), 1e-8) << "s_start = " << s_start << ", crossing " << i;
+          EXPECT_NEAR(taylor[i].p(), 0, 1e-12) << "s_start = " << s_start << ", crossing " << i;
+        }
+    }
+}
+
+TEST(taylor, closed_orbit_agrees_with_cash_karp)
+{
+  const auto duffing = Hamiltonian::DuffingHamiltonian{};
+  const TimeInterval integration_time{0, 100};
+  const auto options = Testing::tight_options(1e-13);
+  const auto s_start = Geometry::State2{1, 0.5};
+
+  const auto taylor = come_back_home_closed_orbit<Steppers::Taylor>(duffing, s_start, integration_time, options);
+  const auto cash_karp = come_back_home_closed_orbit<Steppers::CashKarp54>(duffing,
+                                                                           s_start,
+                                                                           integration_time,
+                                                                           options);
+
+  EXPECT_NEAR(taylor.t(), cash_karp.t(), 1e-9);
+  EXPECT_NEAR(taylor.J(), cash_karp.J(), 1e-9);
+}
+
+TEST(taylor, steps_meet_the_tolerance)
+{
+  const auto system = DuffingSystem{Hamiltonian::DuffingHamiltonian{}};
+  const auto t_end = 20.0;
+
+  for (const auto tolerance: {1e-6, 1e-9, 1e-12})
+    {
+      Taylor::TaylorStepper<Geometry::State2_Action, DuffingSystem> stepper{system, tolerance, tolerance};
+      auto controlled_stepper = Steppers::CashKarp54::make_controlled<Geometry::State2_Action>(system, 1e-15, 1e-15);
+
+      Geometry::State2_Action x{1, 0.5, 0};
+      double t = 0;
+      size_t steps = 0;
+      while (t < t_end)
+        {
+          double dt = t_end - t;
+          const auto x_before = x;
+          const auto t_before = t;
+          if (stepper.try_step(system, x, t, dt) == boost::numeric::odeint::fail)
+            {
+              EXPECT_EQ(t, t_before);
+              EXPECT_LT(dt, t_end - t_before);
+              continue;
+            }
+          ++steps;
+
+          // the same step, with the tightest Runge-Kutta tolerance
+          auto x_reference = x_before;
+          boost::numeric::odeint::integrate_adaptive(controlled_stepper, [&system] (const auto& s, auto& dsdt, double)
+          { dsdt = system.dynamic_system_Action(s); }, x_reference, t_before, t, 1e-3);
+
+          for (unsigned i = 0; i < 3; ++i)
+            EXPECT_NEAR(x[i], x_reference[i], 10 * (tolerance + tolerance * std::abs(x_reference[i])) + 1e-13)
+                        << "tolerance " << tolerance << ", step " << steps << ", coordinate " << i;
+        }
+    }
+}
+
+namespace
+{
+    /// \brief the state at time t of the orbit starting at s_start at time 0, by a tight Cash-Karp integration
+    Geometry::State2_Action reference_state (const DuffingSystem& duffing, Geometry::State2_Action s_start, double t)
+    {
+      auto controlled_stepper = Steppers::CashKarp54::make_controlled<Geometry::State2_Action>(duffing, 1e-15, 1e-15);
+      boost::numeric::odeint::integrate_adaptive(controlled_stepper, [&duffing] (const auto& x, auto& dxdt, double)
+      { dxdt = duffing.dynamic_system_Action(x); }, s_start, 0.0, t, 1e-3);
+      return s_start;
+    }
+}
+
+TEST(taylor, step_back_follows_the_last_step)
+{
+  const auto system = DuffingSystem{Hamiltonian::DuffingHamiltonian{}};
+  Taylor::StepRecord step_record{};
+  Taylor::TaylorStepper<Geometry::State2_Action, DuffingSystem> stepper{system, 1e-13, 1e-13,
+                                                                        std::numeric_limits<double>::infinity(),
+                                                                        &step_record};
+
+  const Geometry::State2_Action s_start{1, 0.5, 0};
+  auto s = s_start;
+  double t = 0;
+  double dt = 10;
+  ASSERT_EQ(stepper.try_step(system, s, t, dt), boost::numeric::odeint::success);
+  ASSERT_TRUE(step_record.ends_at(s, t));
+
+  // a line crossed within the step
+  const auto q_line = 0.5 * (s_start.q() + s.q());
+  const auto direction = Geometry::State2{1, 0};
+  const auto crossing = Taylor::step_back(system, direction, s, t, s.q() - q_line, &step_record);
+
+  EXPECT_GE(crossing.t(), 0);
+  EXPECT_LE(crossing.t(), t);
+  EXPECT_NEAR(crossing.q(), q_line, 1e-14);
+
+  const auto s_reference = reference_state(system, s_start, crossing.t());
+  EXPECT_NEAR(crossing.q(), s_reference.q(), 1e-11);
+  EXPECT_NEAR(crossing.p(), s_reference.p(), 1e-11);
+  EXPECT_NEAR(crossing.J(), s_reference.J(), 1e-11);
+}
+
+TEST(taylor, interleaved_orbits_keep_their_own_steps)
+{
+  const auto system = DuffingSystem{Hamiltonian::DuffingHamiltonian{}};
+  const auto no_bound = std::numeric_limits<double>::infinity();
+  const std::array<Geometry::State2_Action, 2> starts{Geometry::State2_Action{1, 0.5, 0},
+                                                      Geometry::State2_Action{-2, 1, 0}};
+
+  std::array<Taylor::StepRecord, 2> records{};
+  std::array<Taylor::TaylorStepper<Geometry::State2_Action, DuffingSystem>, 2> steppers{
+      Taylor::TaylorStepper<Geometry::State2_Action, DuffingSystem>{system, 1e-13, 1e-13, no_bound, &records[0]},
+      Taylor::TaylorStepper<Geometry::State2_Action, DuffingSystem>{system, 1e-13, 1e-13, no_bound, &records[1]}};
+
+  auto states = starts;
+  std::array<double, 2> times{};
+  for (size_t i = 0; i < 2; ++i)
+    {
+      double dt = 10;
+      ASSERT_EQ(steppers[i].try_step(system, states[i], times[i], dt), boost::numeric::odeint::success);
+    }
+
+  // the step of the second orbit has not overwritten the record of the first
+  for (size_t i = 0; i < 2; ++i)
+    {
+      ASSERT_TRUE(records[i].ends_at(states[i], times[i])) << "orbit " << i;
+
+      const auto q_line = 0.5 * (starts[i].q() + states[i].q());
+      const auto crossing = Taylor::step_back(system, Geometry::State2{1, 0}, states[i], times[i],
+                                              states[i].q() - q_line, &records[i]);
+
+      EXPECT_NEAR(crossing.q(), q_line, 1e-14) << "orbit " << i;
+      const auto s_reference = reference_state(system, starts[i], crossing.t());
+      EXPECT_NEAR(crossing.p(), s_reference.p(), 1e-11) << "orbit " << i;
+      EXPECT_NEAR(crossing.J(), s_reference.J(), 1e-11) << "orbit " << i;
+    }
+}
@@ -0,0 +1,27 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#ifndef HAMILTONIANS_TEST_OPTIONS_HPP
+#define HAMILTONIANS_TEST_OPTIONS_HPP
+
+#include "Integration.hpp"
+
+namespace Integrators
+{
+    namespace Testing
+    {
+        /// \brief the options of the tests that compare orbits bit for bit, or near the round off: tight tolerances,
+        /// and a distance threshold well above their error over a period
+        inline IntegrationOptions tight_options (double tolerance = 1e-12)
+        {
+          IntegrationOptions options;
+          options.set_abs_err(tolerance);
+          options.set_rel_err(tolerance);
+          options.set_distance_threshold(1e-8);
+          return options;
+        }
+    }
+}
+
+#endif //HAMILTONIANS_TEST_OPTIONS_HPP
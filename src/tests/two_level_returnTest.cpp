@@ -0,0 +1,66 @@
+//
+// Created by Panagiotis Zestanakis on 19/10/26.
+//
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "two_level_return.hpp"
+#include "test_options.hpp"
+
+using namespace Integrators;
+
+namespace
+{
+    const Hamiltonian::PendulumHamiltonian pendulum{1, 1};
+    const TimeInterval integration_time{0, 200};
+
+    /// \brief a libration of the pendulum, whose energy is distance_to_separatrix below the separatrix, in p
+    Geometry::State2 near_separatrix (double distance_to_separatrix)
+    {
+      return Geometry::State2{0, 2 - distance_to_separatrix};
+    }
+}
+
+TEST(TwoLevelReturn, AgreesWithComeBackHome)
+{
+  const auto options = Testing::tight_options();
+
+  for (const auto distance: {1e-1, 1e-4, 1e-5})
+    {
+      const auto s_start = near_separatrix(distance);
+      const auto fine = come_back_home_closed_orbit(pendulum, s_start, integration_time, options);
+      const auto two_level = come_back_home_closed_orbit_two_level(pendulum, s_start, integration_time, options);
+      EXPECT_EQ(two_level.t(), fine.t()) << "distance " << distance;
+      EXPECT_EQ(two_level.J(), fine.J()) << "distance " << distance;
+    }
+}
+
+TEST(TwoLevelReturn, ScreeningMayRejectNearSeparatrixStarts)
+{
+  const auto options = Testing::tight_options();
+
+  // the period is long enough that the loose pass drifts across the separatrix
+  const auto s_start = near_separatrix(1e-8);
+  EXPECT_NO_THROW(come_back_home_closed_orbit(pendulum, s_start, integration_time, options));
+  EXPECT_THROW(come_back_home_closed_orbit_two_level(pendulum, s_start, integration_time, options),
+               std::runtime_error);
+
+  // a tighter loose pass keeps to the orbit
+  CoarsePassOptions coarse_options;
+  coarse_options.tolerance = 1e-12;
+  const auto fine = come_back_home_closed_orbit(pendulum, s_start, integration_time, options);
+  const auto two_level = come_back_home_closed_orbit_two_level(pendulum, s_start, integration_time, options,
+                                                               coarse_options);
+  EXPECT_EQ(two_level.t(), fine.t());
+}
+
+TEST(TwoLevelReturn, RotationsAreRejected)
+{
+  const auto options = Testing::tight_options();
+  const Geometry::State2 rotation{0, 2.5};
+  EXPECT_THROW(come_back_home_closed_orbit(pendulum, rotation, integration_time, options), std::runtime_error);
+  EXPECT_THROW(come_back_home_closed_orbit_two_level(pendulum, rotation, integration_time, options),
+               std::runtime_error);
+}